@@ -0,0 +1,308 @@
+#include "registry.hpp"
+#include "shard.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct result
+	{
+		std::string Name;
+		bool Passed;
+		double Time;
+	};
+
+	bool match(std::vector<std::string> const & Patterns, char const* Name)
+	{
+		for(std::size_t i = 0; i < Patterns.size(); ++i)
+			if(std::strstr(Name, Patterns[i].c_str()))
+				return true;
+		return false;
+	}
+
+	registry_entry const* find_entry(std::string const & Name)
+	{
+		for(std::size_t i = 0; i < RegistryCount; ++i)
+			if(Name == Registry[i].Name)
+				return &Registry[i];
+		return nullptr;
+	}
+
+	void usage(char const* Program)
+	{
+		fprintf(stdout, "Usage: %s [--list] [--jobs <count>] [--exclude <pattern>]... [pattern]...\n", Program);
+		fprintf(stdout, "Runs every sample whose name contains one of the patterns, all samples when none is given.\n");
+		fprintf(stdout, "--jobs shards the samples across worker processes balanced by the run times of previous runs.\n");
+	}
+
+	void print(result const & Result, std::size_t Index, std::size_t Count)
+	{
+		fprintf(stdout, "\n%3d/%3d Test: %-48s %s %8.2f sec\n",
+			static_cast<int>(Index + 1), static_cast<int>(Count), Result.Name.c_str(),
+			Result.Passed ? "Passed" : "***Failed", Result.Time);
+		fflush(stdout);
+	}
+
+	// Run samples in this process, appending each result to ResultFile when provided so that a crash keeps the completed ones
+	std::vector<result> run(std::vector<registry_entry const*> const & Selection, FILE* ResultFile, bool Print)
+	{
+		framework::shareContexts(true);
+
+		std::vector<result> Results;
+		for(std::size_t i = 0; i < Selection.size(); ++i)
+		{
+			char Name[256];
+			std::strncpy(Name, Selection[i]->Name, sizeof(Name) - 1);
+			Name[sizeof(Name) - 1] = '\0';
+			char* Arguments[] = {Name, nullptr};
+
+			std::chrono::steady_clock::time_point const TestBegin = std::chrono::steady_clock::now();
+			int const Error = Selection[i]->Main(1, Arguments);
+			std::chrono::duration<double> const TestTime = std::chrono::steady_clock::now() - TestBegin;
+
+			result const Result = {Selection[i]->Name, Error == EXIT_SUCCESS, TestTime.count()};
+			Results.push_back(Result);
+
+			if(ResultFile)
+			{
+				fprintf(ResultFile, "%s %d %f\n", Result.Name.c_str(), Result.Passed ? 1 : 0, Result.Time);
+				fflush(ResultFile);
+			}
+			if(Print)
+				print(Result, i, Selection.size());
+		}
+
+		framework::destroySharedContexts();
+
+		return Results;
+	}
+
+	int worker(std::string const & Directory)
+	{
+		std::vector<registry_entry const*> Selection;
+
+		std::ifstream Stream((Directory + "tests.txt").c_str());
+		std::string Name;
+		while(Stream >> Name)
+			if(registry_entry const* Entry = find_entry(Name))
+				Selection.push_back(Entry);
+
+		setBinaryDirectory(Directory);
+
+		// Appended to, so that the results of a worker that crashed are kept when the next one runs the remaining samples
+		FILE* ResultFile = fopen((Directory + "results.txt").c_str(), "a");
+		if(!ResultFile)
+			return EXIT_FAILURE;
+
+		std::vector<result> const Results = run(Selection, ResultFile, true);
+		fclose(ResultFile);
+
+		for(std::size_t i = 0; i < Results.size(); ++i)
+			if(!Results[i].Passed)
+				return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	bool write_tests(std::string const & Directory, std::vector<std::string> const & Names)
+	{
+		FILE* File = fopen((Directory + "tests.txt").c_str(), "w");
+		if(!File)
+			return false;
+		for(std::size_t i = 0; i < Names.size(); ++i)
+			fprintf(File, "%s\n", Names[i].c_str());
+		return fclose(File) == 0;
+	}
+
+	std::map<std::string, result> read_results(std::string const & Directory)
+	{
+		std::map<std::string, result> Results;
+
+		std::ifstream Stream((Directory + "results.txt").c_str());
+		result Result;
+		int Status = 0;
+		while(Stream >> Result.Name >> Status >> Result.Time)
+		{
+			Result.Passed = Status != 0;
+			Results[Result.Name] = Result;
+		}
+
+		return Results;
+	}
+
+	// Run workers until every sample of the shard has a result. Workers run the samples in order and record
+	// each one when it completes, so the first sample without a result is the one a worker died on.
+	// It is skipped and a new worker runs the samples that follow it.
+	void run_shard(std::string const & Program, std::string const & Directory, std::vector<std::string> const & Names)
+	{
+		std::remove((Directory + "results.txt").c_str());
+		std::remove((Directory + "log.txt").c_str());
+
+		std::string Command = std::string("\"") + Program + "\" --worker \"" + Directory + "\" >> \"" + Directory + "log.txt\" 2>&1";
+#		if defined(_WIN32)
+			Command = "\"" + Command + "\"";
+#		endif
+
+		std::vector<std::string> Remaining = Names;
+		while(!Remaining.empty() && write_tests(Directory, Remaining))
+		{
+			std::system(Command.c_str());
+
+			std::map<std::string, result> const Results = read_results(Directory);
+			std::vector<std::string>::iterator Crashed = Remaining.begin();
+			while(Crashed != Remaining.end() && Results.find(*Crashed) != Results.end())
+				++Crashed;
+			if(Crashed == Remaining.end())
+				break;
+
+			Remaining.erase(Remaining.begin(), Crashed + 1);
+		}
+	}
+
+	// Each worker gets its own output directory so that concurrent samples don't overwrite each other's artifacts
+	std::vector<result> dispatch(char const* Program, std::vector<registry_entry const*> const & Selection, timings const & Timings, std::size_t Jobs)
+	{
+		std::vector<std::string> Names;
+		for(std::size_t i = 0; i < Selection.size(); ++i)
+			Names.push_back(Selection[i]->Name);
+
+		std::vector<std::vector<std::string> > const Shards = shard(Names, Timings, Jobs);
+		std::vector<std::string> Directories(Shards.size());
+		std::vector<std::thread> Threads;
+
+		for(std::size_t ShardIndex = 0; ShardIndex < Shards.size(); ++ShardIndex)
+		{
+			if(Shards[ShardIndex].empty())
+				continue;
+
+			Directories[ShardIndex] = getBinaryDirectory() + format("batch-%d/", static_cast<int>(ShardIndex));
+			make_directory(Directories[ShardIndex]);
+
+			std::string const Directory = Directories[ShardIndex];
+			std::vector<std::string> const & Shard = Shards[ShardIndex];
+			Threads.push_back(std::thread([Program, Directory, &Shard]()
+			{
+				run_shard(Program, Directory, Shard);
+			}));
+		}
+
+		for(std::size_t i = 0; i < Threads.size(); ++i)
+			Threads[i].join();
+
+		std::vector<result> Results;
+		for(std::size_t ShardIndex = 0; ShardIndex < Shards.size(); ++ShardIndex)
+		{
+			std::map<std::string, result> const Completed = read_results(Directories[ShardIndex]);
+
+			// Samples without a result crashed or killed their worker
+			for(std::size_t i = 0; i < Shards[ShardIndex].size(); ++i)
+			{
+				std::map<std::string, result>::const_iterator Iterator = Completed.find(Shards[ShardIndex][i]);
+				if(Iterator != Completed.end())
+					Results.push_back(Iterator->second);
+				else
+				{
+					result const Crashed = {Shards[ShardIndex][i], false, 0.0};
+					Results.push_back(Crashed);
+				}
+			}
+		}
+
+		return Results;
+	}
+}//namespace
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> Includes;
+	std::vector<std::string> Excludes;
+	std::size_t Jobs = 1;
+	bool List = false;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(std::strcmp(argv[i], "--list") == 0)
+			List = true;
+		else if(std::strcmp(argv[i], "--worker") == 0 && i + 1 < argc)
+			return worker(argv[i + 1]);
+		else if((std::strcmp(argv[i], "--jobs") == 0 || std::strcmp(argv[i], "-j") == 0) && i + 1 < argc)
+			Jobs = static_cast<std::size_t>(std::max(std::atoi(argv[++i]), 1));
+		else if(std::strcmp(argv[i], "--exclude") == 0 && i + 1 < argc)
+			Excludes.push_back(argv[++i]);
+		else if(std::strcmp(argv[i], "--help") == 0 || argv[i][0] == '-')
+		{
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		else
+			Includes.push_back(argv[i]);
+	}
+
+	std::vector<registry_entry const*> Selection;
+	for(std::size_t i = 0; i < RegistryCount; ++i)
+	{
+		if(!Includes.empty() && !match(Includes, Registry[i].Name))
+			continue;
+		if(match(Excludes, Registry[i].Name))
+			continue;
+		Selection.push_back(&Registry[i]);
+	}
+
+	if(List)
+	{
+		for(std::size_t i = 0; i < Selection.size(); ++i)
+			fprintf(stdout, "%s\n", Selection[i]->Name);
+		return EXIT_SUCCESS;
+	}
+
+	std::string const TimingsFile = getBinaryDirectory() + "batch-timings.txt";
+	timings Timings = load_timings(TimingsFile);
+
+	std::chrono::steady_clock::time_point const SuiteBegin = std::chrono::steady_clock::now();
+
+	std::vector<result> Results;
+	if(Jobs > 1)
+	{
+		Results = dispatch(argv[0], Selection, Timings, Jobs);
+		for(std::size_t i = 0; i < Results.size(); ++i)
+			print(Results[i], i, Results.size());
+	}
+	else
+		Results = run(Selection, nullptr, true);
+
+	std::chrono::duration<double> const SuiteTime = std::chrono::steady_clock::now() - SuiteBegin;
+
+	std::vector<std::string> Failures;
+	for(std::size_t i = 0; i < Results.size(); ++i)
+	{
+		if(Results[i].Passed || Results[i].Time > 0.0)
+			Timings[Results[i].Name] = Results[i].Time;
+		if(!Results[i].Passed)
+			Failures.push_back(Results[i].Name);
+	}
+	save_timings(TimingsFile, Timings);
+
+	std::size_t const Passed = Results.size() - Failures.size();
+	fprintf(stdout, "\n%d%% tests passed, %d tests failed out of %d\n",
+		Results.empty() ? 100 : static_cast<int>(Passed * 100 / Results.size()),
+		static_cast<int>(Failures.size()), static_cast<int>(Results.size()));
+	fprintf(stdout, "\nTotal Test time (real) = %.2f sec\n", SuiteTime.count());
+
+	if(!Failures.empty())
+	{
+		fprintf(stdout, "\nThe following tests FAILED:\n");
+		for(std::size_t i = 0; i < Failures.size(); ++i)
+			fprintf(stdout, "\t%s (Failed)\n", Failures[i].c_str());
+	}
+
+	return Failures.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
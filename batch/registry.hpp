@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+// Sample entry points compiled into the batch runner, generated by batch/CMakeLists.txt
+struct registry_entry
+{
+	char const* Name;
+	int (*Main)(int argc, char* argv[]);
+};
+
+extern registry_entry const Registry[];
+extern std::size_t const RegistryCount;
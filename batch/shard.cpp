@@ -0,0 +1,76 @@
+#include "shard.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+timings load_timings(std::string const & Filename)
+{
+	timings Result;
+
+	std::ifstream Stream(Filename.c_str());
+	if(!Stream.is_open())
+		return Result;
+
+	std::string Name;
+	double Time = 0.0;
+	while(Stream >> Name >> Time)
+		Result[Name] = Time;
+
+	return Result;
+}
+
+bool save_timings(std::string const & Filename, timings const & Timings)
+{
+	// Write aside then rename so that a killed run never leaves a truncated history
+	std::string const Temporary = Filename + ".tmp";
+
+	FILE* File = fopen(Temporary.c_str(), "w");
+	if(!File)
+		return false;
+
+	for(timings::const_iterator it = Timings.begin(); it != Timings.end(); ++it)
+		fprintf(File, "%s %f\n", it->first.c_str(), it->second);
+	fclose(File);
+
+	std::remove(Filename.c_str());
+	return std::rename(Temporary.c_str(), Filename.c_str()) == 0;
+}
+
+std::vector<std::vector<std::string> > shard(std::vector<std::string> const & Names, timings const & Timings, std::size_t ShardCount)
+{
+	double DefaultTime = 1.0;
+	if(!Timings.empty())
+	{
+		double TimeSum = 0.0;
+		for(timings::const_iterator it = Timings.begin(); it != Timings.end(); ++it)
+			TimeSum += it->second;
+		DefaultTime = TimeSum / static_cast<double>(Timings.size());
+	}
+
+	std::vector<std::pair<double, std::string> > Jobs;
+	Jobs.reserve(Names.size());
+	for(std::size_t i = 0; i < Names.size(); ++i)
+	{
+		timings::const_iterator it = Timings.find(Names[i]);
+		Jobs.push_back(std::make_pair(it != Timings.end() ? it->second : DefaultTime, Names[i]));
+	}
+
+	// Longest first, name ordered on ties to keep shards stable across runs
+	std::sort(Jobs.begin(), Jobs.end(), [](std::pair<double, std::string> const & A, std::pair<double, std::string> const & B)
+	{
+		return A.first != B.first ? A.first > B.first : A.second < B.second;
+	});
+
+	std::vector<std::vector<std::string> > Shards(std::max<std::size_t>(ShardCount, 1));
+	std::vector<double> Loads(Shards.size(), 0.0);
+	for(std::size_t i = 0; i < Jobs.size(); ++i)
+	{
+		std::size_t const Lightest = std::min_element(Loads.begin(), Loads.end()) - Loads.begin();
+		Shards[Lightest].push_back(Jobs[i].second);
+		Loads[Lightest] += Jobs[i].first;
+	}
+
+	return Shards;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Sample run times in seconds recorded by previous runs, keyed by sample name
+typedef std::map<std::string, double> timings;
+
+timings load_timings(std::string const & Filename);
+bool save_timings(std::string const & Filename, timings const & Timings);
+
+// Split the samples into ShardCount lists of balanced expected run time using
+// the longest processing time first heuristic. Samples without history are
+// assumed to take the average recorded time.
+std::vector<std::vector<std::string> > shard(std::vector<std::string> const & Names, timings const & Timings, std::size_t ShardCount);
@@ -0,0 +1,32 @@
+/// @brief Include to compress 8 bits per component textures to DXT1, DXT5, ATI1N and ATI2N textures.
+/// @file gli/compress.hpp
+
+#pragma once
+
+#include "texture.hpp"
+#include "decompress.hpp"
+
+namespace gli
+{
+	enum compress_quality
+	{
+		/// Bounding box endpoints, suited to baking at load time
+		COMPRESS_FAST,
+		/// Principal axis and least squares endpoints, DXT1 three colors mode and BC4 endpoints search, suited to offline baking
+		COMPRESS_HIGH
+	};
+
+	/// Compress a level of a texture, block rows are encoded in parallel.
+	///
+	/// @param Texture Source texture, its format must be decompressed_format(Format): RGBA8 for DXT formats, R8 for ATI1N and RG8 for ATI2N, signed for SNORM formats.
+	/// @param Level Level to compress
+	/// @param Format Destination format, one of the DXT1, DXT5, ATI1N or ATI2N block formats.
+	/// @param Quality Trade off between encoding time and quality
+	/// @return A single level texture with the target, layers and faces of Texture. Returns an empty texture if the formats aren't supported.
+	texture compress(texture const& Texture, texture::size_type Level, format Format, compress_quality Quality = COMPRESS_FAST);
+
+	/// Compress every level of a texture, see compress(Texture, Level, Format, Quality)
+	texture compress(texture const& Texture, format Format, compress_quality Quality = COMPRESS_FAST);
+}//namespace gli
+
+#include "./core/compress.inl"
@@ -14,9 +14,10 @@
 namespace gli
 {
 	/// Convert texture data to a new format
+	/// The common 8 bits, packed, half and float formats are converted in parallel with kernels specialized for both formats, the other formats texel by texel.
 	///
-	/// @param Texture Source texture, the format must be uncompressed.
-	/// @param Format Destination Texture format, it must be uncompressed.
+	/// @param Texture Source texture, the format must be uncompressed or one of the formats supported by decompress.
+	/// @param Format Destination Texture format, it must be uncompressed or one of the formats supported by compress, encoded with COMPRESS_FAST.
 	template <typename texture_type>
 	texture_type convert(texture_type const& Texture, format Format);
 }//namespace gli
@@ -67,23 +67,16 @@ namespace gli
 			ContiguousBitmap |= uint64_t(ChannelBitmap[3] | (ChannelBitmap[4] << 8) | (ChannelBitmap[5] << 16)) << 24;
 		}
 
+		// Signed endpoints are two's complement, -128 decodes as -1 like -127, and the mode compares them signed
 		inline void single_channel_bitmap_data_snorm(uint8_t Channel0, uint8_t Channel1, const uint8_t *ChannelBitmap, float *LookupTable, uint64_t &ContiguousBitmap)
 		{
-			LookupTable[0] = (Channel0 / 255.0f) * 2.0f - 1.0f;
-			LookupTable[1] = (Channel1 / 255.0f) * 2.0f - 1.0f;
+			int8_t const Signed0 = static_cast<int8_t>(Channel0);
+			int8_t const Signed1 = static_cast<int8_t>(Channel1);
 
-			create_single_channel_lookup_table(Channel0 > Channel1, -1.0f, LookupTable);
+			LookupTable[0] = glm::max(Signed0 / 127.0f, -1.0f);
+			LookupTable[1] = glm::max(Signed1 / 127.0f, -1.0f);
 
-			ContiguousBitmap = ChannelBitmap[0] | (ChannelBitmap[1] << 8) | (ChannelBitmap[2] << 16);
-			ContiguousBitmap |= uint64_t(ChannelBitmap[3] | (ChannelBitmap[4] << 8) | (ChannelBitmap[5] << 16)) << 24;
-		}
-
-		inline void single_channel_bitmap_data_snorm(uint8_t Channel0, uint32_t Channel1, bool Interpolate6, const uint8_t *ChannelBitmap, float *LookupTable, uint64_t &ContiguousBitmap)
-		{
-			LookupTable[0] = (Channel0 / 255.0f) * 2.0f - 1.0f;
-			LookupTable[1] = (Channel1 / 255.0f) * 2.0f - 1.0f;
-
-			create_single_channel_lookup_table(Interpolate6, -1.0f, LookupTable);
+			create_single_channel_lookup_table(Signed0 > Signed1, -1.0f, LookupTable);
 
 			ContiguousBitmap = ChannelBitmap[0] | (ChannelBitmap[1] << 8) | (ChannelBitmap[2] << 16);
 			ContiguousBitmap |= uint64_t(ChannelBitmap[3] | (ChannelBitmap[4] << 8) | (ChannelBitmap[5] << 16)) << 24;
@@ -221,7 +214,7 @@ namespace gli
 			float GreenLUT[8];
 			uint64_t GreenBitmap;
 
-			single_channel_bitmap_data_snorm(Block.Green0, Block.Green1, Block.Red0 > Block.Red1, Block.GreenBitmap, GreenLUT, GreenBitmap);
+			single_channel_bitmap_data_snorm(Block.Green0, Block.Green1, Block.GreenBitmap, GreenLUT, GreenBitmap);
 
 			texel_block4x4 TexelBlock;
 			for(uint8_t Row = 0; Row < 4; ++Row)
@@ -0,0 +1,593 @@
+#include "bc.hpp"
+#include "parallel.hpp"
+#include <cstring>
+#include <limits>
+
+namespace gli{
+namespace detail
+{
+	enum
+	{
+		COMPRESS_TEXELS_GRAIN = 1024
+	};
+
+	// 565 endpoint of a color in [0, 255], red in the high bits like decompress_dxt1 expects
+	inline uint16_t compress_pack_565(glm::vec3 const& Color)
+	{
+		glm::vec3 const Clamped(glm::clamp(Color, 0.0f, 255.0f));
+		uint16_t const Red = static_cast<uint16_t>(Clamped.r * (31.0f / 255.0f) + 0.5f);
+		uint16_t const Green = static_cast<uint16_t>(Clamped.g * (63.0f / 255.0f) + 0.5f);
+		uint16_t const Blue = static_cast<uint16_t>(Clamped.b * (31.0f / 255.0f) + 0.5f);
+		return static_cast<uint16_t>((Red << 11) | (Green << 5) | Blue);
+	}
+
+	inline glm::vec3 compress_unpack_565(uint16_t Color)
+	{
+		uint32_t const Red = (Color >> 11) & 0x1F;
+		uint32_t const Green = (Color >> 5) & 0x3F;
+		uint32_t const Blue = Color & 0x1F;
+		return glm::vec3((Red << 3) | (Red >> 2), (Green << 2) | (Green >> 4), (Blue << 3) | (Blue >> 2));
+	}
+
+	// Whether the palette of the endpoints has 4 colors, the color block of DXT3 and DXT5 always has
+	inline bool compress_four_colors(uint16_t Color0, uint16_t Color1, bool AlwaysFourColors)
+	{
+		return AlwaysFourColors || Color0 > Color1;
+	}
+
+	// Closest palette index of the texels in Mask, the others get the transparent index 3 of the 3 colors mode.
+	// Black, index 3 of the 3 colors mode, is only used when allowed. Returns the squared error.
+	inline float compress_color_indices(glm::vec3 const Texels[16], uint32_t Mask, uint16_t Color0, uint16_t Color1, bool AlwaysFourColors, bool Black, uint32_t& Indices)
+	{
+		glm::vec3 Palette[4];
+		Palette[0] = compress_unpack_565(Color0);
+		Palette[1] = compress_unpack_565(Color1);
+
+		int Count = 4;
+		if(compress_four_colors(Color0, Color1, AlwaysFourColors))
+		{
+			Palette[2] = (Palette[0] * 2.0f + Palette[1]) / 3.0f;
+			Palette[3] = (Palette[0] + Palette[1] * 2.0f) / 3.0f;
+		}
+		else
+		{
+			Palette[2] = (Palette[0] + Palette[1]) * 0.5f;
+			Palette[3] = glm::vec3(0.0f);
+			Count = Black ? 4 : 3;
+		}
+
+		float Error = 0.0f;
+		Indices = 0;
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+		{
+			if(!(Mask & (1u << Texel)))
+			{
+				Indices |= 3u << (Texel * 2);
+				continue;
+			}
+
+			uint32_t BestIndex = 0;
+			float BestDistance = std::numeric_limits<float>::max();
+			for(int Index = 0; Index < Count; ++Index)
+			{
+				glm::vec3 const Difference(Texels[Texel] - Palette[Index]);
+				float const Distance = glm::dot(Difference, Difference);
+				if(Distance < BestDistance)
+				{
+					BestDistance = Distance;
+					BestIndex = static_cast<uint32_t>(Index);
+				}
+			}
+
+			Indices |= BestIndex << (Texel * 2);
+			Error += BestDistance;
+		}
+
+		return Error;
+	}
+
+	struct compress_color_result
+	{
+		float Error;
+		uint16_t Color0;
+		uint16_t Color1;
+		uint32_t Indices;
+	};
+
+	// Quantize the endpoints, ordered for the palette mode requested, and keep the block in Best if it has a lower error
+	inline void compress_color_candidate(glm::vec3 const Texels[16], uint32_t Mask, glm::vec3 const& Endpoint0, glm::vec3 const& Endpoint1, bool FourColors, bool AlwaysFourColors, bool Black, compress_color_result& Best)
+	{
+		compress_color_result Result;
+		Result.Color0 = compress_pack_565(Endpoint0);
+		Result.Color1 = compress_pack_565(Endpoint1);
+		if(FourColors ? Result.Color0 < Result.Color1 : Result.Color0 > Result.Color1)
+			std::swap(Result.Color0, Result.Color1);
+
+		Result.Error = compress_color_indices(Texels, Mask, Result.Color0, Result.Color1, AlwaysFourColors, Black, Result.Indices);
+		if(Result.Error < Best.Error)
+			Best = Result;
+	}
+
+	// Endpoints of the palette closest to the texels for the indices of a block, in the least squares sense.
+	// Returns false when the indices don't constrain both endpoints.
+	inline bool compress_color_least_squares(glm::vec3 const Texels[16], uint32_t Mask, compress_color_result const& Block, bool AlwaysFourColors, glm::vec3& Endpoint0, glm::vec3& Endpoint1)
+	{
+		bool const FourColors = compress_four_colors(Block.Color0, Block.Color1, AlwaysFourColors);
+		static float const Weights[2][4] =
+		{
+			{1.0f, 0.0f, 0.5f, 0.0f},
+			{1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f}
+		};
+
+		float A = 0.0f, B = 0.0f, C = 0.0f;
+		glm::vec3 X(0.0f), Y(0.0f);
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+		{
+			uint32_t const Index = (Block.Indices >> (Texel * 2)) & 0x3;
+			if(!(Mask & (1u << Texel)) || (!FourColors && Index == 3))
+				continue;
+
+			float const Weight0 = Weights[FourColors][Index];
+			float const Weight1 = 1.0f - Weight0;
+			A += Weight0 * Weight0;
+			B += Weight1 * Weight1;
+			C += Weight0 * Weight1;
+			X += Weight0 * Texels[Texel];
+			Y += Weight1 * Texels[Texel];
+		}
+
+		float const Determinant = A * B - C * C;
+		if(glm::abs(Determinant) < 1e-6f)
+			return false;
+
+		Endpoint0 = (B * X - C * Y) / Determinant;
+		Endpoint1 = (A * Y - C * X) / Determinant;
+		return true;
+	}
+
+	// Extremities of the texels projected on their principal axis
+	inline void compress_color_principal_axis(glm::vec3 const Texels[16], uint32_t Mask, glm::vec3 const& Min, glm::vec3 const& Max, glm::vec3& Endpoint0, glm::vec3& Endpoint1)
+	{
+		float Count = 0.0f;
+		glm::vec3 Mean(0.0f);
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+			if(Mask & (1u << Texel))
+			{
+				Mean += Texels[Texel];
+				Count += 1.0f;
+			}
+		Mean /= Count;
+
+		glm::mat3 Covariance(0.0f);
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+			if(Mask & (1u << Texel))
+			{
+				glm::vec3 const Difference(Texels[Texel] - Mean);
+				Covariance += glm::outerProduct(Difference, Difference);
+			}
+
+		// Power iterations from the diagonal of the bounding box
+		glm::vec3 Axis(Max - Min);
+		for(int Iteration = 0; Iteration < 8; ++Iteration)
+		{
+			glm::vec3 const Next(Covariance * Axis);
+			float const Length = glm::length(Next);
+			if(Length < 1e-6f)
+				break;
+			Axis = Next / Length;
+		}
+
+		float const Length = glm::length(Axis);
+		if(Length < 1e-6f)
+		{
+			Endpoint0 = Max;
+			Endpoint1 = Min;
+			return;
+		}
+		Axis /= Length;
+
+		float Lowest = std::numeric_limits<float>::max();
+		float Highest = -std::numeric_limits<float>::max();
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+			if(Mask & (1u << Texel))
+			{
+				float const Projection = glm::dot(Texels[Texel] - Mean, Axis);
+				Lowest = glm::min(Lowest, Projection);
+				Highest = glm::max(Highest, Projection);
+			}
+
+		Endpoint0 = Mean + Axis * Highest;
+		Endpoint1 = Mean + Axis * Lowest;
+	}
+
+	// Color block of DXT1, DXT3 and DXT5. Texels outside of Mask are transparent and are encoded with the index 3 of the 3 colors mode.
+	inline void compress_color_block(glm::vec3 const Texels[16], uint32_t Mask, bool AlwaysFourColors, bool Black, compress_quality Quality, dxt1_block& Block)
+	{
+		if(Mask == 0)
+		{
+			Block.Color0 = 0;
+			Block.Color1 = 0;
+			memset(Block.Row, 0xFF, sizeof(Block.Row));
+			return;
+		}
+
+		// Transparent texels require the 3 colors mode
+		bool const Transparent = Mask != 0xFFFF;
+
+		glm::vec3 Min(255.0f), Max(0.0f);
+		for(uint32_t Texel = 0; Texel < 16; ++Texel)
+			if(Mask & (1u << Texel))
+			{
+				Min = glm::min(Min, Texels[Texel]);
+				Max = glm::max(Max, Texels[Texel]);
+			}
+
+		compress_color_result Best;
+		Best.Error = std::numeric_limits<float>::max();
+
+		// Bounding box inset by half a palette step so that the extreme texels are not all rounded inward
+		glm::vec3 const Inset((Max - Min) / 16.0f);
+		compress_color_candidate(Texels, Mask, Max - Inset, Min + Inset, !Transparent, AlwaysFourColors, Black, Best);
+
+		if(Quality == COMPRESS_HIGH)
+		{
+			glm::vec3 Axis0, Axis1;
+			compress_color_principal_axis(Texels, Mask, Min, Max, Axis0, Axis1);
+
+			for(int Mode = 0; Mode < 2; ++Mode)
+			{
+				bool const FourColors = Mode == 0;
+				if((FourColors && Transparent) || (!FourColors && AlwaysFourColors))
+					continue;
+
+				glm::vec3 Endpoint0(Axis0), Endpoint1(Axis1);
+				for(int Iteration = 0; Iteration < 3; ++Iteration)
+				{
+					compress_color_result Result;
+					Result.Error = std::numeric_limits<float>::max();
+					compress_color_candidate(Texels, Mask, Endpoint0, Endpoint1, FourColors, AlwaysFourColors, Black, Result);
+					if(Result.Error < Best.Error)
+						Best = Result;
+
+					if(Result.Error <= 0.0f || !compress_color_least_squares(Texels, Mask, Result, AlwaysFourColors, Endpoint0, Endpoint1))
+						break;
+				}
+			}
+		}
+
+		Block.Color0 = Best.Color0;
+		Block.Color1 = Best.Color1;
+		for(int Row = 0; Row < 4; ++Row)
+			Block.Row[Row] = static_cast<uint8_t>(Best.Indices >> (Row * 8));
+	}
+
+	// Squared error of the closest palette entries of a BC4 block, Lower and Upper are the extremities of the 6 values mode.
+	inline int compress_channel_indices(int const Values[16], int Red0, int Red1, int Lower, int Upper, uint64_t& Bitmap)
+	{
+		int Palette[8];
+		Palette[0] = Red0;
+		Palette[1] = Red1;
+		if(Red0 > Red1)
+		{
+			for(int Step = 1; Step < 7; ++Step)
+				Palette[Step + 1] = ((7 - Step) * Red0 + Step * Red1 + 3) / 7;
+		}
+		else
+		{
+			for(int Step = 1; Step < 5; ++Step)
+				Palette[Step + 1] = ((5 - Step) * Red0 + Step * Red1 + 2) / 5;
+			Palette[6] = Lower;
+			Palette[7] = Upper;
+		}
+
+		int Error = 0;
+		Bitmap = 0;
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			uint64_t BestIndex = 0;
+			int BestDistance = std::numeric_limits<int>::max();
+			for(int Index = 0; Index < 8; ++Index)
+			{
+				int const Distance = (Values[Texel] - Palette[Index]) * (Values[Texel] - Palette[Index]);
+				if(Distance < BestDistance)
+				{
+					BestDistance = Distance;
+					BestIndex = static_cast<uint64_t>(Index);
+				}
+			}
+
+			Bitmap |= BestIndex << (Texel * 3);
+			Error += BestDistance;
+		}
+
+		return Error;
+	}
+
+	// BC4 block, also the alpha block of DXT5. Values are in [0, 255], or in [-127, 127] when Signed.
+	inline void compress_channel_block(int const Values[16], bool Signed, compress_quality Quality, uint8_t& Endpoint0, uint8_t& Endpoint1, uint8_t Bitmap[6])
+	{
+		int const Lower = Signed ? -127 : 0;
+		int const Upper = Signed ? 127 : 255;
+
+		int Min = Upper, Max = Lower;
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			Min = glm::min(Min, Values[Texel]);
+			Max = glm::max(Max, Values[Texel]);
+		}
+
+		// 8 values mode with the range of the block, equal endpoints decode in the 6 values mode with an exact index 0
+		int BestRed0 = Max, BestRed1 = Min;
+		uint64_t BestBitmap;
+		int BestError = compress_channel_indices(Values, BestRed0, BestRed1, Lower, Upper, BestBitmap);
+
+		if(Quality == COMPRESS_HIGH && BestError > 0)
+		{
+			// Range of the values not encoded exactly by the extremities of the 6 values mode
+			int Min6 = Upper, Max6 = Lower;
+			for(int Texel = 0; Texel < 16; ++Texel)
+				if(Values[Texel] != Lower && Values[Texel] != Upper)
+				{
+					Min6 = glm::min(Min6, Values[Texel]);
+					Max6 = glm::max(Max6, Values[Texel]);
+				}
+			if(Min6 > Max6)
+				Min6 = Max6 = Lower;
+
+			// Search the endpoints around the ranges in both modes
+			int const Radius = 2;
+			for(int Mode = 0; Mode < 2; ++Mode)
+			{
+				int const High = Mode == 0 ? Max : Max6;
+				int const Low = Mode == 0 ? Min : Min6;
+				for(int OffsetHigh = -Radius; OffsetHigh <= Radius; ++OffsetHigh)
+				for(int OffsetLow = -Radius; OffsetLow <= Radius; ++OffsetLow)
+				{
+					int const EndpointHigh = glm::clamp(High + OffsetHigh, Lower, Upper);
+					int const EndpointLow = glm::clamp(Low + OffsetLow, Lower, Upper);
+					if(EndpointHigh <= EndpointLow)
+						continue;
+
+					int const Red0 = Mode == 0 ? EndpointHigh : EndpointLow;
+					int const Red1 = Mode == 0 ? EndpointLow : EndpointHigh;
+
+					uint64_t CandidateBitmap;
+					int const Error = compress_channel_indices(Values, Red0, Red1, Lower, Upper, CandidateBitmap);
+					if(Error < BestError)
+					{
+						BestError = Error;
+						BestRed0 = Red0;
+						BestRed1 = Red1;
+						BestBitmap = CandidateBitmap;
+					}
+				}
+			}
+		}
+
+		Endpoint0 = static_cast<uint8_t>(BestRed0);
+		Endpoint1 = static_cast<uint8_t>(BestRed1);
+		for(int Byte = 0; Byte < 6; ++Byte)
+			Bitmap[Byte] = static_cast<uint8_t>(BestBitmap >> (Byte * 8));
+	}
+
+	// Each encoder reads the 4x4 texels of a block, row major, COMPONENTS bytes per texel
+	template <bool PunchThrough>
+	struct compress_dxt1_encoder
+	{
+		typedef dxt1_block block_type;
+		enum {COMPONENTS = 4};
+
+		static void call(uint8_t const* Texels, compress_quality Quality, block_type& Block)
+		{
+			glm::vec3 Colors[16];
+			uint32_t Mask = 0;
+			for(uint32_t Texel = 0; Texel < 16; ++Texel)
+			{
+				Colors[Texel] = glm::vec3(Texels[Texel * 4 + 0], Texels[Texel * 4 + 1], Texels[Texel * 4 + 2]);
+				if(!PunchThrough || Texels[Texel * 4 + 3] >= 128)
+					Mask |= 1u << Texel;
+			}
+
+			compress_color_block(Colors, Mask, false, !PunchThrough, Quality, Block);
+		}
+	};
+
+	struct compress_dxt5_encoder
+	{
+		typedef dxt5_block block_type;
+		enum {COMPONENTS = 4};
+
+		static void call(uint8_t const* Texels, compress_quality Quality, block_type& Block)
+		{
+			glm::vec3 Colors[16];
+			int Alphas[16];
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				Colors[Texel] = glm::vec3(Texels[Texel * 4 + 0], Texels[Texel * 4 + 1], Texels[Texel * 4 + 2]);
+				Alphas[Texel] = Texels[Texel * 4 + 3];
+			}
+
+			compress_channel_block(Alphas, false, Quality, Block.Alpha[0], Block.Alpha[1], Block.AlphaBitmap);
+
+			dxt1_block Color;
+			compress_color_block(Colors, 0xFFFF, true, false, Quality, Color);
+			Block.Color0 = Color.Color0;
+			Block.Color1 = Color.Color1;
+			memcpy(Block.Row, Color.Row, sizeof(Block.Row));
+		}
+	};
+
+	// Signed texels are two's complement, -128 is clamped to -127 like the decoding does
+	inline int compress_channel_value(uint8_t Texel, bool Signed)
+	{
+		return Signed ? glm::max(static_cast<int>(static_cast<int8_t>(Texel)), -127) : static_cast<int>(Texel);
+	}
+
+	template <bool Signed>
+	struct compress_bc4_encoder
+	{
+		typedef bc4_block block_type;
+		enum {COMPONENTS = 1};
+
+		static void call(uint8_t const* Texels, compress_quality Quality, block_type& Block)
+		{
+			int Reds[16];
+			for(int Texel = 0; Texel < 16; ++Texel)
+				Reds[Texel] = compress_channel_value(Texels[Texel], Signed);
+
+			compress_channel_block(Reds, Signed, Quality, Block.Red0, Block.Red1, Block.Bitmap);
+		}
+	};
+
+	template <bool Signed>
+	struct compress_bc5_encoder
+	{
+		typedef bc5_block block_type;
+		enum {COMPONENTS = 2};
+
+		static void call(uint8_t const* Texels, compress_quality Quality, block_type& Block)
+		{
+			int Reds[16];
+			int Greens[16];
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				Reds[Texel] = compress_channel_value(Texels[Texel * 2 + 0], Signed);
+				Greens[Texel] = compress_channel_value(Texels[Texel * 2 + 1], Signed);
+			}
+
+			compress_channel_block(Reds, Signed, Quality, Block.Red0, Block.Red1, Block.RedBitmap);
+			compress_channel_block(Greens, Signed, Quality, Block.Green0, Block.Green1, Block.GreenBitmap);
+		}
+	};
+
+	// Encode the blocks of an image, one job per row of blocks of each slice.
+	// Blocks on the right and bottom edges repeat the last column and row of the image.
+	template <typename encoder>
+	inline void compress_image(void const* Source, extent3d const& Extent, compress_quality Quality, void* Destination)
+	{
+		typedef typename encoder::block_type block_type;
+		std::size_t const TexelSize = encoder::COMPONENTS;
+
+		std::size_t const BlockColumns = (static_cast<std::size_t>(Extent.x) + 3) / 4;
+		std::size_t const BlockRows = (static_cast<std::size_t>(Extent.y) + 3) / 4;
+		std::size_t const RowPitch = static_cast<std::size_t>(Extent.x) * TexelSize;
+		std::size_t const SlicePitch = RowPitch * Extent.y;
+		std::size_t const Grain = std::max<std::size_t>(COMPRESS_TEXELS_GRAIN / (BlockColumns * 16), 1);
+
+		uint8_t const* const Texels = static_cast<uint8_t const*>(Source);
+		block_type* const Blocks = static_cast<block_type*>(Destination);
+
+		parallel_for(BlockRows * Extent.z, Grain, [&](std::size_t Begin, std::size_t End)
+		{
+			uint8_t Gathered[16 * encoder::COMPONENTS];
+
+			for(std::size_t Job = Begin; Job < End; ++Job)
+			{
+				std::size_t const Slice = Job / BlockRows;
+				std::size_t const BlockRow = Job % BlockRows;
+				uint8_t const* const Src = Texels + Slice * SlicePitch;
+
+				for(std::size_t BlockColumn = 0; BlockColumn < BlockColumns; ++BlockColumn)
+				{
+					for(std::size_t TexelRow = 0; TexelRow < 4; ++TexelRow)
+					for(std::size_t TexelColumn = 0; TexelColumn < 4; ++TexelColumn)
+					{
+						std::size_t const y = std::min<std::size_t>(BlockRow * 4 + TexelRow, Extent.y - 1);
+						std::size_t const x = std::min<std::size_t>(BlockColumn * 4 + TexelColumn, Extent.x - 1);
+						memcpy(Gathered + (TexelRow * 4 + TexelColumn) * TexelSize, Src + y * RowPitch + x * TexelSize, TexelSize);
+					}
+
+					encoder::call(Gathered, Quality, Blocks[Job * BlockColumns + BlockColumn]);
+				}
+			}
+		});
+	}
+
+	inline bool compress_supported(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline bool compress_image(format Format, void const* Source, extent3d const& Extent, compress_quality Quality, void* Destination)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			compress_image<compress_dxt1_encoder<false> >(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			compress_image<compress_dxt1_encoder<true> >(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			compress_image<compress_dxt5_encoder>(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			compress_image<compress_bc4_encoder<false> >(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+			compress_image<compress_bc4_encoder<true> >(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			compress_image<compress_bc5_encoder<false> >(Source, Extent, Quality, Destination);
+			return true;
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			compress_image<compress_bc5_encoder<true> >(Source, Extent, Quality, Destination);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline texture compress(texture const& Texture, texture::size_type BaseLevel, texture::size_type LevelCount, format Format, compress_quality Quality)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		bool const Supported = compress_supported(Format) && Texture.format() == decompressed_format(Format);
+		GLI_ASSERT(Supported);
+		if(!Supported)
+			return texture();
+
+		texture Compressed(Texture.target(), Format, Texture.extent(BaseLevel), Texture.layers(), Texture.faces(), LevelCount, Texture.swizzles());
+
+		for(texture::size_type Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(texture::size_type Face = 0; Face < Texture.faces(); ++Face)
+		for(texture::size_type Level = 0; Level < LevelCount; ++Level)
+		{
+			compress_image(
+				Format, Texture.data(Layer, Face, BaseLevel + Level),
+				Texture.extent(BaseLevel + Level), Quality, Compressed.data(Layer, Face, Level));
+		}
+
+		return Compressed;
+	}
+}//namespace detail
+
+	inline texture compress(texture const& Texture, texture::size_type Level, format Format, compress_quality Quality)
+	{
+		GLI_ASSERT(Level < Texture.levels());
+		return detail::compress(Texture, Level, 1, Format, Quality);
+	}
+
+	inline texture compress(texture const& Texture, format Format, compress_quality Quality)
+	{
+		return detail::compress(Texture, 0, Texture.levels(), Format, Quality);
+	}
+}//namespace gli
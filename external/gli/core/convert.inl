@@ -1,7 +1,77 @@
 #include "../core/convert_func.hpp"
+#include "../core/texel_codec.hpp"
+#include "../core/parallel.hpp"
+#include "../compress.hpp"
 
-namespace gli
+namespace gli{
+namespace detail
 {
+	enum
+	{
+		/// Texels decoded to float and encoded again together, the buffer remains in the L1 cache
+		CONVERT_TEXELS_BATCH = 256,
+		/// Texels of an image converted together by a worker
+		CONVERT_TEXELS_GRAIN = 16384
+	};
+
+	/// Contiguous texels of an image converted by a worker
+	struct convert_texels_range
+	{
+		std::uint8_t const* Source;
+		std::uint8_t* Destination;
+		std::size_t Count;
+	};
+
+	/// Convert every image of Texture to Copy with the codecs of both formats, a format resolved once per texture and whole images converted by inlined loops.
+	/// The layers, faces, levels and bands of texels of the images are converted in parallel.
+	/// Returns false when either format has no codec.
+	inline bool convert_texels(texture const& Texture, texture& Copy)
+	{
+		texel_codec_funcs Source, Destination;
+		if(!visit_texel_codec(Texture.format(), Source) || !visit_texel_codec(Copy.format(), Destination))
+			return false;
+
+		std::size_t const SrcBlockSize = block_size(Texture.format());
+		std::size_t const DstBlockSize = block_size(Copy.format());
+
+		std::vector<convert_texels_range> Ranges;
+		for(texture::size_type Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(texture::size_type Face = 0; Face < Texture.faces(); ++Face)
+		for(texture::size_type Level = 0; Level < Texture.levels(); ++Level)
+		{
+			texture::extent_type const Extent = Texture.extent(Level);
+			std::size_t const TexelCount = static_cast<std::size_t>(Extent.x) * Extent.y * Extent.z;
+
+			std::uint8_t const* const Src = static_cast<std::uint8_t const*>(Texture.data(Layer, Face, Level));
+			std::uint8_t* const Dst = static_cast<std::uint8_t*>(Copy.data(Layer, Face, Level));
+
+			for(std::size_t Offset = 0; Offset < TexelCount; Offset += CONVERT_TEXELS_GRAIN)
+			{
+				convert_texels_range const Range = {Src + Offset * SrcBlockSize, Dst + Offset * DstBlockSize, glm::min<std::size_t>(TexelCount - Offset, CONVERT_TEXELS_GRAIN)};
+				Ranges.push_back(Range);
+			}
+		}
+
+		parallel_for(Ranges.size(), 1, [&](std::size_t Begin, std::size_t End)
+		{
+			vec4 Texels[CONVERT_TEXELS_BATCH];
+
+			for(std::size_t RangeIndex = Begin; RangeIndex < End; ++RangeIndex)
+			{
+				convert_texels_range const& Range = Ranges[RangeIndex];
+				for(std::size_t Offset = 0; Offset < Range.Count; Offset += CONVERT_TEXELS_BATCH)
+				{
+					std::size_t const Count = glm::min<std::size_t>(Range.Count - Offset, CONVERT_TEXELS_BATCH);
+					Source.Decode(Range.Source + Offset * SrcBlockSize, Texels, Count);
+					Destination.Encode(Texels, Range.Destination + Offset * DstBlockSize, Count);
+				}
+			}
+		});
+
+		return true;
+	}
+}//namespace detail
+
 	template <typename texture_type>
 	inline texture_type convert(texture_type const& Texture, format Format)
 	{
@@ -13,12 +83,28 @@ namespace gli
 		typedef typename detail::convert<texture_type, T, defaultp>::writeFunc write_type;
 
 		GLI_ASSERT(!Texture.empty());
+
+		// Block formats go through the 8 bits per component format of their codec
+		if(is_compressed(Texture.format()) && decompressed_format(Texture.format()) != FORMAT_UNDEFINED)
+		{
+			texture_type const Decompressed(decompress(Texture));
+			return Decompressed.format() == Format ? Decompressed : convert(Decompressed, Format);
+		}
+		if(is_compressed(Format) && detail::compress_supported(Format))
+		{
+			format const Uncompressed = decompressed_format(Format);
+			return texture_type(compress(Texture.format() == Uncompressed ? Texture : convert(Texture, Uncompressed), Format));
+		}
+
 		GLI_ASSERT(!is_compressed(Texture.format()) && !is_compressed(Format));
 
+		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
+		if(detail::convert_texels(Texture, Storage))
+			return texture_type(Storage);
+
 		fetch_type Fetch = detail::convert<texture_type, T, defaultp>::call(Texture.format()).Fetch;
 		write_type Write = detail::convert<texture_type, T, defaultp>::call(Format).Write;
 
-		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
 		texture_type Copy(Storage);
 
 		for(size_type Layer = 0; Layer < Texture.layers(); ++Layer)
@@ -0,0 +1,444 @@
+#include "bc.hpp"
+#include "etc.hpp"
+#include "parallel.hpp"
+#include <cstring>
+
+namespace gli{
+namespace detail
+{
+	enum
+	{
+		DECOMPRESS_TEXELS_GRAIN = 4096
+	};
+
+	// Same conversion as compScale<u8> used by convert_func to write 8 bits components
+	inline uint8_t decompress_unorm8(float Value)
+	{
+		return static_cast<uint8_t>(Value * 255.0f);
+	}
+
+	// GL conversion to 8 bits snorm, the inverse of the RGTC endpoint decoding so that signed endpoints round trip
+	inline uint8_t decompress_snorm8(float Value)
+	{
+		return static_cast<uint8_t>(glm::packSnorm1x8(Value));
+	}
+
+	// Endpoint colors of the 4 colors palette, same float math as decompress_dxt3 and decompress_dxt5
+	inline void decompress_color_palette(uint16_t Color0, uint16_t Color1, glm::vec3 Color[4])
+	{
+		Color[0] = glm::vec3(unpackUnorm1x5_1x6_1x5(Color0));
+		std::swap(Color[0].r, Color[0].b);
+		Color[1] = glm::vec3(unpackUnorm1x5_1x6_1x5(Color1));
+		std::swap(Color[1].r, Color[1].b);
+
+		Color[2] = (2.0f / 3.0f) * Color[0] + (1.0f / 3.0f) * Color[1];
+		Color[3] = (1.0f / 3.0f) * Color[0] + (2.0f / 3.0f) * Color[1];
+	}
+
+	// Each decoder writes the 4x4 texels of a block, row major, TEXEL_SIZE bytes per texel.
+	// The palette of the block is converted to 8 bits once so that decoding a texel is a lookup.
+	struct decompress_dxt1_decoder
+	{
+		typedef dxt1_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			// Same float math as decompress_dxt1, including the alpha of the interpolated colors
+			glm::vec4 Color[4];
+
+			Color[0] = glm::vec4(unpackUnorm1x5_1x6_1x5(Block.Color0), 1.0f);
+			std::swap(Color[0].r, Color[0].b);
+			Color[1] = glm::vec4(unpackUnorm1x5_1x6_1x5(Block.Color1), 1.0f);
+			std::swap(Color[1].r, Color[1].b);
+
+			if(Block.Color0 > Block.Color1)
+			{
+				Color[2] = (2.0f / 3.0f) * Color[0] + (1.0f / 3.0f) * Color[1];
+				Color[3] = (1.0f / 3.0f) * Color[0] + (2.0f / 3.0f) * Color[1];
+			}
+			else
+			{
+				Color[2] = (Color[0] + Color[1]) / 2.0f;
+				Color[3] = glm::vec4(0.0f);
+			}
+
+			uint8_t Palette[4][4];
+			for(int Index = 0; Index < 4; ++Index)
+			for(int Component = 0; Component < 4; ++Component)
+				Palette[Index][Component] = decompress_unorm8(Color[Index][Component]);
+
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+				memcpy(Texels + (Row * 4 + Col) * 4, Palette[(Block.Row[Row] >> (Col * 2)) & 0x3], 4);
+		}
+	};
+
+	struct decompress_dxt3_decoder
+	{
+		typedef dxt3_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			glm::vec3 Color[4];
+			decompress_color_palette(Block.Color0, Block.Color1, Color);
+
+			uint8_t Palette[4][3];
+			for(int Index = 0; Index < 4; ++Index)
+			for(int Component = 0; Component < 3; ++Component)
+				Palette[Index][Component] = decompress_unorm8(Color[Index][Component]);
+
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+			{
+				uint8_t* Texel = Texels + (Row * 4 + Col) * 4;
+				memcpy(Texel, Palette[(Block.Row[Row] >> (Col * 2)) & 0x3], 3);
+				Texel[3] = decompress_unorm8(((Block.AlphaRow[Row] >> (Col * 4)) & 0xF) / 15.0f);
+			}
+		}
+	};
+
+	struct decompress_dxt5_decoder
+	{
+		typedef dxt5_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			glm::vec3 Color[4];
+			decompress_color_palette(Block.Color0, Block.Color1, Color);
+
+			uint8_t Palette[4][3];
+			for(int Index = 0; Index < 4; ++Index)
+			for(int Component = 0; Component < 3; ++Component)
+				Palette[Index][Component] = decompress_unorm8(Color[Index][Component]);
+
+			// The alpha lookup table of decompress_dxt5 is the one of a BC4 unorm block
+			float AlphaLUT[8];
+			uint64_t AlphaBitmap;
+			single_channel_bitmap_data_unorm(Block.Alpha[0], Block.Alpha[1], Block.AlphaBitmap, AlphaLUT, AlphaBitmap);
+
+			uint8_t AlphaPalette[8];
+			for(int Index = 0; Index < 8; ++Index)
+				AlphaPalette[Index] = decompress_unorm8(AlphaLUT[Index]);
+
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+			{
+				uint8_t* Texel = Texels + (Row * 4 + Col) * 4;
+				memcpy(Texel, Palette[(Block.Row[Row] >> (Col * 2)) & 0x3], 3);
+				Texel[3] = AlphaPalette[(AlphaBitmap >> ((Row * 4 + Col) * 3)) & 0x7];
+			}
+		}
+	};
+
+	template <bool Signed>
+	struct decompress_bc4_decoder
+	{
+		typedef bc4_block block_type;
+		enum {TEXEL_SIZE = 1};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			float RedLUT[8];
+			uint64_t Bitmap;
+
+			uint8_t Palette[8];
+			if(Signed)
+			{
+				single_channel_bitmap_data_snorm(Block.Red0, Block.Red1, Block.Bitmap, RedLUT, Bitmap);
+				for(int Index = 0; Index < 8; ++Index)
+					Palette[Index] = decompress_snorm8(RedLUT[Index]);
+			}
+			else
+			{
+				single_channel_bitmap_data_unorm(Block.Red0, Block.Red1, Block.Bitmap, RedLUT, Bitmap);
+				for(int Index = 0; Index < 8; ++Index)
+					Palette[Index] = decompress_unorm8(RedLUT[Index]);
+			}
+
+			for(int Texel = 0; Texel < 16; ++Texel)
+				Texels[Texel] = Palette[(Bitmap >> (Texel * 3)) & 0x7];
+		}
+	};
+
+	template <bool Signed>
+	struct decompress_bc5_decoder
+	{
+		typedef bc5_block block_type;
+		enum {TEXEL_SIZE = 2};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			float RedLUT[8];
+			uint64_t RedBitmap;
+			float GreenLUT[8];
+			uint64_t GreenBitmap;
+
+			uint8_t RedPalette[8];
+			uint8_t GreenPalette[8];
+			if(Signed)
+			{
+				// Same as decompress_bc5snorm, each channel selects its interpolation from its own endpoints
+				single_channel_bitmap_data_snorm(Block.Red0, Block.Red1, Block.RedBitmap, RedLUT, RedBitmap);
+				single_channel_bitmap_data_snorm(Block.Green0, Block.Green1, Block.GreenBitmap, GreenLUT, GreenBitmap);
+				for(int Index = 0; Index < 8; ++Index)
+				{
+					RedPalette[Index] = decompress_snorm8(RedLUT[Index]);
+					GreenPalette[Index] = decompress_snorm8(GreenLUT[Index]);
+				}
+			}
+			else
+			{
+				single_channel_bitmap_data_unorm(Block.Red0, Block.Red1, Block.RedBitmap, RedLUT, RedBitmap);
+				single_channel_bitmap_data_unorm(Block.Green0, Block.Green1, Block.GreenBitmap, GreenLUT, GreenBitmap);
+				for(int Index = 0; Index < 8; ++Index)
+				{
+					RedPalette[Index] = decompress_unorm8(RedLUT[Index]);
+					GreenPalette[Index] = decompress_unorm8(GreenLUT[Index]);
+				}
+			}
+
+			for(int Texel = 0; Texel < 16; ++Texel)
+			{
+				Texels[Texel * 2 + 0] = RedPalette[(RedBitmap >> (Texel * 3)) & 0x7];
+				Texels[Texel * 2 + 1] = GreenPalette[(GreenBitmap >> (Texel * 3)) & 0x7];
+			}
+		}
+	};
+
+	template <bool PunchThrough>
+	struct decompress_etc2_decoder
+	{
+		typedef etc2_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			decompress_etc2_block(Block, PunchThrough, Texels);
+		}
+	};
+
+	struct decompress_etc2_eac_decoder
+	{
+		typedef etc2_eac_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			decompress_etc2_block(Block.Color, false, Texels);
+			decompress_eac_alpha_block(Block.Alpha, Texels + 3, 4);
+		}
+	};
+
+	template <bool Signed>
+	struct decompress_eac_r11_decoder
+	{
+		typedef eac_block block_type;
+		enum {TEXEL_SIZE = 2};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			uint16_t Values[16];
+			decompress_eac_r11_block(Block, Signed, Values, 1);
+			memcpy(Texels, Values, sizeof(Values));
+		}
+	};
+
+	template <bool Signed>
+	struct decompress_eac_rg11_decoder
+	{
+		typedef eac_rg_block block_type;
+		enum {TEXEL_SIZE = 4};
+
+		static void call(block_type const& Block, uint8_t* Texels)
+		{
+			uint16_t Values[32];
+			decompress_eac_r11_block(Block.Red, Signed, Values + 0, 2);
+			decompress_eac_r11_block(Block.Green, Signed, Values + 1, 2);
+			memcpy(Texels, Values, sizeof(Values));
+		}
+	};
+
+	// Decode the blocks of an image, one job per row of blocks of each slice.
+	// Full blocks are copied 4 texels at a time, blocks on the right and bottom edges are clipped.
+	template <typename decoder>
+	inline void decompress_image(void const* Source, extent3d const& Extent, void* Destination)
+	{
+		typedef typename decoder::block_type block_type;
+		std::size_t const TexelSize = decoder::TEXEL_SIZE;
+
+		std::size_t const BlockColumns = (static_cast<std::size_t>(Extent.x) + 3) / 4;
+		std::size_t const BlockRows = (static_cast<std::size_t>(Extent.y) + 3) / 4;
+		std::size_t const RowPitch = static_cast<std::size_t>(Extent.x) * TexelSize;
+		std::size_t const SlicePitch = RowPitch * Extent.y;
+		std::size_t const Grain = std::max<std::size_t>(DECOMPRESS_TEXELS_GRAIN / (BlockColumns * 16), 1);
+
+		block_type const* const Blocks = static_cast<block_type const*>(Source);
+		uint8_t* const Texels = static_cast<uint8_t*>(Destination);
+
+		parallel_for(BlockRows * Extent.z, Grain, [&](std::size_t Begin, std::size_t End)
+		{
+			uint8_t Decoded[16 * decoder::TEXEL_SIZE];
+
+			for(std::size_t Job = Begin; Job < End; ++Job)
+			{
+				std::size_t const Slice = Job / BlockRows;
+				std::size_t const BlockRow = Job % BlockRows;
+				std::size_t const Rows = std::min<std::size_t>(4, Extent.y - BlockRow * 4);
+
+				block_type const* const Row = Blocks + Job * BlockColumns;
+				uint8_t* const Dst = Texels + Slice * SlicePitch + BlockRow * 4 * RowPitch;
+
+				for(std::size_t BlockColumn = 0; BlockColumn < BlockColumns; ++BlockColumn)
+				{
+					decoder::call(Row[BlockColumn], Decoded);
+
+					std::size_t const Columns = std::min<std::size_t>(4, Extent.x - BlockColumn * 4);
+					for(std::size_t TexelRow = 0; TexelRow < Rows; ++TexelRow)
+						memcpy(Dst + TexelRow * RowPitch + BlockColumn * 4 * TexelSize, Decoded + TexelRow * 4 * TexelSize, Columns * TexelSize);
+				}
+			}
+		});
+	}
+
+	inline bool decompress_image(format Format, void const* Source, extent3d const& Extent, void* Destination)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			decompress_image<decompress_dxt1_decoder>(Source, Extent, Destination);
+			return true;
+		case FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+			decompress_image<decompress_dxt3_decoder>(Source, Extent, Destination);
+			return true;
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			decompress_image<decompress_dxt5_decoder>(Source, Extent, Destination);
+			return true;
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			decompress_image<decompress_bc4_decoder<false> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+			decompress_image<decompress_bc4_decoder<true> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			decompress_image<decompress_bc5_decoder<false> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			decompress_image<decompress_bc5_decoder<true> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RGB_ETC_UNORM_BLOCK8:
+		case FORMAT_RGB_ETC2_UNORM_BLOCK8:
+		case FORMAT_RGB_ETC2_SRGB_BLOCK8:
+			decompress_image<decompress_etc2_decoder<false> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RGBA_ETC2_UNORM_BLOCK8:
+		case FORMAT_RGBA_ETC2_SRGB_BLOCK8:
+			decompress_image<decompress_etc2_decoder<true> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RGBA_ETC2_UNORM_BLOCK16:
+		case FORMAT_RGBA_ETC2_SRGB_BLOCK16:
+			decompress_image<decompress_etc2_eac_decoder>(Source, Extent, Destination);
+			return true;
+		case FORMAT_R_EAC_UNORM_BLOCK8:
+			decompress_image<decompress_eac_r11_decoder<false> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_R_EAC_SNORM_BLOCK8:
+			decompress_image<decompress_eac_r11_decoder<true> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RG_EAC_UNORM_BLOCK16:
+			decompress_image<decompress_eac_rg11_decoder<false> >(Source, Extent, Destination);
+			return true;
+		case FORMAT_RG_EAC_SNORM_BLOCK16:
+			decompress_image<decompress_eac_rg11_decoder<true> >(Source, Extent, Destination);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline texture decompress(texture const& Texture, texture::size_type BaseLevel, texture::size_type LevelCount)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		format const Format = decompressed_format(Texture.format());
+		GLI_ASSERT(Format != FORMAT_UNDEFINED);
+		if(Format == FORMAT_UNDEFINED)
+			return texture();
+
+		texture Decompressed(Texture.target(), Format, Texture.extent(BaseLevel), Texture.layers(), Texture.faces(), LevelCount, Texture.swizzles());
+
+		for(texture::size_type Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(texture::size_type Face = 0; Face < Texture.faces(); ++Face)
+		for(texture::size_type Level = 0; Level < LevelCount; ++Level)
+		{
+			decompress_image(
+				Texture.format(), Texture.data(Layer, Face, BaseLevel + Level),
+				Texture.extent(BaseLevel + Level), Decompressed.data(Layer, Face, Level));
+		}
+
+		return Decompressed;
+	}
+}//namespace detail
+
+	inline format decompressed_format(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGB_ETC_UNORM_BLOCK8:
+		case FORMAT_RGB_ETC2_UNORM_BLOCK8:
+		case FORMAT_RGBA_ETC2_UNORM_BLOCK8:
+		case FORMAT_RGBA_ETC2_UNORM_BLOCK16:
+			return FORMAT_RGBA8_UNORM_PACK8;
+		// The sRGB encoded values are kept as is, like convert_func does
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+		case FORMAT_RGB_ETC2_SRGB_BLOCK8:
+		case FORMAT_RGBA_ETC2_SRGB_BLOCK8:
+		case FORMAT_RGBA_ETC2_SRGB_BLOCK16:
+			return FORMAT_RGBA8_SRGB_PACK8;
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			return FORMAT_R8_UNORM_PACK8;
+		case FORMAT_R_ATI1N_SNORM_BLOCK8:
+			return FORMAT_R8_SNORM_PACK8;
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return FORMAT_RG8_UNORM_PACK8;
+		case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+			return FORMAT_RG8_SNORM_PACK8;
+		// The 11 bits of EAC are extended to 16 bits
+		case FORMAT_R_EAC_UNORM_BLOCK8:
+			return FORMAT_R16_UNORM_PACK16;
+		case FORMAT_R_EAC_SNORM_BLOCK8:
+			return FORMAT_R16_SNORM_PACK16;
+		case FORMAT_RG_EAC_UNORM_BLOCK16:
+			return FORMAT_RG16_UNORM_PACK16;
+		case FORMAT_RG_EAC_SNORM_BLOCK16:
+			return FORMAT_RG16_SNORM_PACK16;
+		default:
+			return FORMAT_UNDEFINED;
+		}
+	}
+
+	inline texture decompress(texture const& Texture, texture::size_type Level)
+	{
+		GLI_ASSERT(Level < Texture.levels());
+		return detail::decompress(Texture, Level, 1);
+	}
+
+	inline texture decompress(texture const& Texture)
+	{
+		return detail::decompress(Texture, 0, Texture.levels());
+	}
+}//namespace gli
@@ -0,0 +1,41 @@
+/// @brief Include to decompress ETC1, ETC2 and EAC blocks
+/// @file gli/core/etc.hpp
+
+#pragma once
+
+namespace gli
+{
+	namespace detail
+	{
+		// 64 bits big endian blocks, texel indices are stored column major
+		struct etc2_block {
+			uint8_t Data[8];
+		};
+
+		struct eac_block {
+			uint8_t Data[8];
+		};
+
+		struct etc2_eac_block {
+			eac_block Alpha;
+			etc2_block Color;
+		};
+
+		struct eac_rg_block {
+			eac_block Red;
+			eac_block Green;
+		};
+
+		// Decode the 4x4 texels of an ETC1 or ETC2 RGB block to RGBA8, row major.
+		// With PunchThrough, the block is an RGB8_PUNCHTHROUGH_ALPHA1 block and the differential bit is the opaque bit.
+		void decompress_etc2_block(etc2_block const& Block, bool PunchThrough, uint8_t* Texels);
+
+		// Decode the 16 values of an EAC alpha block, row major, every Stride bytes
+		void decompress_eac_alpha_block(eac_block const& Block, uint8_t* Texels, std::size_t Stride);
+
+		// Decode the 16 values of an EAC R11 block to 16 bits, row major, every Stride values
+		void decompress_eac_r11_block(eac_block const& Block, bool Signed, uint16_t* Texels, std::size_t Stride);
+	}//namespace detail
+}//namespace gli
+
+#include "./etc.inl"
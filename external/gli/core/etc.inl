@@ -0,0 +1,229 @@
+#include <cstring>
+
+namespace gli
+{
+	namespace detail
+	{
+		inline uint64_t etc_block_bits(uint8_t const Data[8])
+		{
+			uint64_t Bits = 0;
+			for(int Byte = 0; Byte < 8; ++Byte)
+				Bits = (Bits << 8) | Data[Byte];
+			return Bits;
+		}
+
+		inline int etc_clamp(int Value)
+		{
+			return Value < 0 ? 0 : (Value > 255 ? 255 : Value);
+		}
+
+		inline uint32_t etc_bits(uint64_t Bits, int Lowest, int Count)
+		{
+			return static_cast<uint32_t>(Bits >> Lowest) & ((1u << Count) - 1u);
+		}
+
+		inline int etc_extend4(uint32_t Value){return static_cast<int>((Value << 4) | Value);}
+		inline int etc_extend5(uint32_t Value){return static_cast<int>((Value << 3) | (Value >> 2));}
+		inline int etc_extend6(uint32_t Value){return static_cast<int>((Value << 2) | (Value >> 4));}
+		inline int etc_extend7(uint32_t Value){return static_cast<int>((Value << 1) | (Value >> 6));}
+
+		inline void etc_store(uint8_t* Texel, int Red, int Green, int Blue, int Alpha)
+		{
+			Texel[0] = static_cast<uint8_t>(etc_clamp(Red));
+			Texel[1] = static_cast<uint8_t>(etc_clamp(Green));
+			Texel[2] = static_cast<uint8_t>(etc_clamp(Blue));
+			Texel[3] = static_cast<uint8_t>(Alpha);
+		}
+
+		inline void decompress_etc2_block(etc2_block const& Block, bool PunchThrough, uint8_t* Texels)
+		{
+			static int const Modifiers[8][4] =
+			{
+				{2, 8, -2, -8}, {5, 17, -5, -17}, {9, 29, -9, -29}, {13, 42, -13, -42},
+				{18, 60, -18, -60}, {24, 80, -24, -80}, {33, 106, -33, -106}, {47, 183, -47, -183}
+			};
+			static int const Distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+			static int const Deltas[8] = {0, 1, 2, 3, -4, -3, -2, -1};
+
+			uint64_t const Bits = etc_block_bits(Block.Data);
+			bool const Differential = PunchThrough || etc_bits(Bits, 33, 1);
+			bool const Opaque = !PunchThrough || etc_bits(Bits, 33, 1);
+
+			// Palette of 4 colors per sub block, the two sub blocks share the palette in T and H modes
+			uint8_t Palette[2][4][4];
+			bool SubBlocks = true;
+			bool const Flip = etc_bits(Bits, 32, 1) != 0;
+
+			int const Red = static_cast<int>(etc_bits(Bits, 59, 5)) + Deltas[etc_bits(Bits, 56, 3)];
+			int const Green = static_cast<int>(etc_bits(Bits, 51, 5)) + Deltas[etc_bits(Bits, 48, 3)];
+			int const Blue = static_cast<int>(etc_bits(Bits, 43, 5)) + Deltas[etc_bits(Bits, 40, 3)];
+
+			if(Differential && (Red < 0 || Red > 31))
+			{
+				// T mode
+				int const Red1 = etc_extend4((etc_bits(Bits, 59, 2) << 2) | etc_bits(Bits, 56, 2));
+				int const Green1 = etc_extend4(etc_bits(Bits, 52, 4));
+				int const Blue1 = etc_extend4(etc_bits(Bits, 48, 4));
+				int const Red2 = etc_extend4(etc_bits(Bits, 44, 4));
+				int const Green2 = etc_extend4(etc_bits(Bits, 40, 4));
+				int const Blue2 = etc_extend4(etc_bits(Bits, 36, 4));
+				int const Distance = Distances[(etc_bits(Bits, 34, 2) << 1) | etc_bits(Bits, 32, 1)];
+
+				etc_store(Palette[0][0], Red1, Green1, Blue1, 255);
+				etc_store(Palette[0][1], Red2 + Distance, Green2 + Distance, Blue2 + Distance, 255);
+				etc_store(Palette[0][2], Red2, Green2, Blue2, 255);
+				etc_store(Palette[0][3], Red2 - Distance, Green2 - Distance, Blue2 - Distance, 255);
+				SubBlocks = false;
+			}
+			else if(Differential && (Green < 0 || Green > 31))
+			{
+				// H mode
+				uint32_t const Red1 = etc_bits(Bits, 59, 4);
+				uint32_t const Green1 = (etc_bits(Bits, 56, 3) << 1) | etc_bits(Bits, 52, 1);
+				uint32_t const Blue1 = (etc_bits(Bits, 51, 1) << 3) | etc_bits(Bits, 47, 3);
+				uint32_t const Red2 = etc_bits(Bits, 43, 4);
+				uint32_t const Green2 = etc_bits(Bits, 39, 4);
+				uint32_t const Blue2 = etc_bits(Bits, 35, 4);
+				uint32_t const Order = ((Red1 << 8) | (Green1 << 4) | Blue1) >= ((Red2 << 8) | (Green2 << 4) | Blue2) ? 1 : 0;
+				int const Distance = Distances[(etc_bits(Bits, 34, 1) << 2) | (etc_bits(Bits, 32, 1) << 1) | Order];
+
+				etc_store(Palette[0][0], etc_extend4(Red1) + Distance, etc_extend4(Green1) + Distance, etc_extend4(Blue1) + Distance, 255);
+				etc_store(Palette[0][1], etc_extend4(Red1) - Distance, etc_extend4(Green1) - Distance, etc_extend4(Blue1) - Distance, 255);
+				etc_store(Palette[0][2], etc_extend4(Red2) + Distance, etc_extend4(Green2) + Distance, etc_extend4(Blue2) + Distance, 255);
+				etc_store(Palette[0][3], etc_extend4(Red2) - Distance, etc_extend4(Green2) - Distance, etc_extend4(Blue2) - Distance, 255);
+				SubBlocks = false;
+			}
+			else if(Differential && (Blue < 0 || Blue > 31))
+			{
+				// Planar mode, always opaque
+				int const RedO = etc_extend6(etc_bits(Bits, 57, 6));
+				int const GreenO = etc_extend7((etc_bits(Bits, 56, 1) << 6) | etc_bits(Bits, 49, 6));
+				int const BlueO = etc_extend6((etc_bits(Bits, 48, 1) << 5) | (etc_bits(Bits, 43, 2) << 3) | etc_bits(Bits, 39, 3));
+				int const RedH = etc_extend6((etc_bits(Bits, 34, 5) << 1) | etc_bits(Bits, 32, 1));
+				int const GreenH = etc_extend7(etc_bits(Bits, 25, 7));
+				int const BlueH = etc_extend6(etc_bits(Bits, 19, 6));
+				int const RedV = etc_extend6(etc_bits(Bits, 13, 6));
+				int const GreenV = etc_extend7(etc_bits(Bits, 6, 7));
+				int const BlueV = etc_extend6(etc_bits(Bits, 0, 6));
+
+				for(int y = 0; y < 4; ++y)
+				for(int x = 0; x < 4; ++x)
+				{
+					etc_store(Texels + (y * 4 + x) * 4,
+						(x * (RedH - RedO) + y * (RedV - RedO) + 4 * RedO + 2) >> 2,
+						(x * (GreenH - GreenO) + y * (GreenV - GreenO) + 4 * GreenO + 2) >> 2,
+						(x * (BlueH - BlueO) + y * (BlueV - BlueO) + 4 * BlueO + 2) >> 2, 255);
+				}
+				return;
+			}
+			else
+			{
+				// Individual or differential mode, a base color and a modifier table per sub block
+				int Base[2][3];
+				if(Differential)
+				{
+					Base[0][0] = etc_extend5(etc_bits(Bits, 59, 5));
+					Base[0][1] = etc_extend5(etc_bits(Bits, 51, 5));
+					Base[0][2] = etc_extend5(etc_bits(Bits, 43, 5));
+					Base[1][0] = etc_extend5(static_cast<uint32_t>(Red));
+					Base[1][1] = etc_extend5(static_cast<uint32_t>(Green));
+					Base[1][2] = etc_extend5(static_cast<uint32_t>(Blue));
+				}
+				else
+				{
+					for(int Component = 0; Component < 3; ++Component)
+					{
+						Base[0][Component] = etc_extend4(etc_bits(Bits, 60 - Component * 8, 4));
+						Base[1][Component] = etc_extend4(etc_bits(Bits, 56 - Component * 8, 4));
+					}
+				}
+
+				for(int SubBlock = 0; SubBlock < 2; ++SubBlock)
+				{
+					int const* const Modifier = Modifiers[etc_bits(Bits, 37 - SubBlock * 3, 3)];
+					for(int Index = 0; Index < 4; ++Index)
+					{
+						// Without the opaque bit, the index 0 has no modifier and the index 2 is transparent
+						int const Offset = !Opaque && Index == 0 ? 0 : Modifier[Index];
+						etc_store(Palette[SubBlock][Index], Base[SubBlock][0] + Offset, Base[SubBlock][1] + Offset, Base[SubBlock][2] + Offset, 255);
+					}
+				}
+			}
+
+			if(!Opaque)
+			{
+				memset(Palette[0][2], 0, 4);
+				memset(Palette[1][2], 0, 4);
+			}
+
+			uint32_t const Indices = static_cast<uint32_t>(Bits);
+			for(int y = 0; y < 4; ++y)
+			for(int x = 0; x < 4; ++x)
+			{
+				int const Bit = x * 4 + y;
+				uint32_t const Index = ((Indices >> (Bit + 15)) & 0x2) | ((Indices >> Bit) & 0x1);
+				int const SubBlock = SubBlocks ? (Flip ? y >= 2 : x >= 2) : 0;
+				memcpy(Texels + (y * 4 + x) * 4, Palette[SubBlock][Index], 4);
+			}
+		}
+
+		inline int const* eac_modifiers(uint8_t Table)
+		{
+			static int const Modifiers[16][8] =
+			{
+				{-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+				{-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10}, {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+				{-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9}, {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+				{-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9}, {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8}
+			};
+			return Modifiers[Table & 0xF];
+		}
+
+		inline void decompress_eac_alpha_block(eac_block const& Block, uint8_t* Texels, std::size_t Stride)
+		{
+			uint64_t const Bits = etc_block_bits(Block.Data);
+			int const Base = Block.Data[0];
+			int const Multiplier = Block.Data[1] >> 4;
+			int const* const Modifier = eac_modifiers(Block.Data[1]);
+
+			uint8_t Palette[8];
+			for(int Index = 0; Index < 8; ++Index)
+				Palette[Index] = static_cast<uint8_t>(etc_clamp(Base + Modifier[Index] * Multiplier));
+
+			for(int y = 0; y < 4; ++y)
+			for(int x = 0; x < 4; ++x)
+				Texels[(y * 4 + x) * Stride] = Palette[etc_bits(Bits, 45 - (x * 4 + y) * 3, 3)];
+		}
+
+		inline void decompress_eac_r11_block(eac_block const& Block, bool Signed, uint16_t* Texels, std::size_t Stride)
+		{
+			uint64_t const Bits = etc_block_bits(Block.Data);
+			int const Multiplier = Block.Data[1] >> 4;
+			int const* const Modifier = eac_modifiers(Block.Data[1]);
+
+			// 11 bits values extended to 16 bits by bit replication
+			uint16_t Palette[8];
+			for(int Index = 0; Index < 8; ++Index)
+			{
+				int const Scale = Multiplier == 0 ? 1 : Multiplier * 8;
+				if(Signed)
+				{
+					int const Base = glm::max(static_cast<int>(static_cast<int8_t>(Block.Data[0])), -127);
+					int const Value = glm::clamp(Base * 8 + Modifier[Index] * Scale, -1023, 1023);
+					int const Magnitude = Value < 0 ? -Value : Value;
+					int const Extended = (Magnitude << 5) | (Magnitude >> 5);
+					Palette[Index] = static_cast<uint16_t>(static_cast<int16_t>(Value < 0 ? -Extended : Extended));
+				}
+				else
+				{
+					int const Value = glm::clamp(Block.Data[0] * 8 + 4 + Modifier[Index] * Scale, 0, 2047);
+					Palette[Index] = static_cast<uint16_t>((Value << 5) | (Value >> 6));
+				}
+			}
+
+			for(int y = 0; y < 4; ++y)
+			for(int x = 0; x < 4; ++x)
+				Texels[(y * 4 + x) * Stride] = Palette[etc_bits(Bits, 45 - (x * 4 + y) * 3, 3)];
+		}
+	}//namespace detail
+}//namespace gli
@@ -0,0 +1,42 @@
+/// @brief Memory mapped file helper
+/// @file gli/core/file_mapping.hpp
+
+#pragma once
+
+#include "../format.hpp"
+#include <glm/simd/platform.h>
+#include <algorithm>
+#include <cstddef>
+
+namespace gli{
+namespace detail
+{
+	/// Private mapping of a whole file. Pages are shared with the system file cache until
+	/// written to, writes are copied on write and never carried to the file.
+	class file_mapping
+	{
+	public:
+		explicit file_mapping(char const* Filename);
+		~file_mapping();
+
+		bool empty() const{return this->Data == nullptr;}
+		char* data() const{return this->Data;}
+		std::size_t size() const{return this->Size;}
+
+	private:
+		file_mapping(file_mapping const &);
+		file_mapping& operator=(file_mapping const &);
+
+		char* Data;
+		std::size_t Size;
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			void* Mapping;
+#		endif
+	};
+
+	/// Alignment of the texel data of Format required to access it in place
+	std::size_t texel_alignment(format Format);
+}//namespace detail
+}//namespace gli
+
+#include "./file_mapping.inl"
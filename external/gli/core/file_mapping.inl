@@ -0,0 +1,94 @@
+#if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+#	if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+		inline file_mapping::file_mapping(char const* Filename)
+			: Data(nullptr)
+			, Size(0)
+			, Mapping(nullptr)
+		{
+			HANDLE File = CreateFileA(Filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if(File == INVALID_HANDLE_VALUE)
+				return;
+
+			LARGE_INTEGER FileSize;
+			if(GetFileSizeEx(File, &FileSize) && FileSize.QuadPart > 0)
+			{
+				this->Mapping = CreateFileMappingA(File, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+				if(this->Mapping)
+				{
+					this->Data = static_cast<char*>(MapViewOfFile(this->Mapping, FILE_MAP_COPY, 0, 0, 0));
+					this->Size = this->Data ? static_cast<std::size_t>(FileSize.QuadPart) : 0;
+				}
+			}
+
+			// The mapping keeps the file open
+			CloseHandle(File);
+		}
+
+		inline file_mapping::~file_mapping()
+		{
+			if(this->Data)
+				UnmapViewOfFile(this->Data);
+			if(this->Mapping)
+				CloseHandle(this->Mapping);
+		}
+#	else
+		inline file_mapping::file_mapping(char const* Filename)
+			: Data(nullptr)
+			, Size(0)
+		{
+			int File = open(Filename, O_RDONLY);
+			if(File == -1)
+				return;
+
+			struct stat Status;
+			if(fstat(File, &Status) == 0 && Status.st_size > 0)
+			{
+				void* Pointer = mmap(nullptr, static_cast<std::size_t>(Status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0);
+				if(Pointer != MAP_FAILED)
+				{
+					this->Data = static_cast<char*>(Pointer);
+					this->Size = static_cast<std::size_t>(Status.st_size);
+				}
+			}
+
+			// The mapping keeps the file open
+			close(File);
+		}
+
+		inline file_mapping::~file_mapping()
+		{
+			if(this->Data)
+				munmap(this->Data, this->Size);
+		}
+#	endif
+
+	inline std::size_t texel_alignment(format Format)
+	{
+		// Block decoders read 32-bit words
+		if(is_compressed(Format))
+			return 4;
+
+		std::size_t const BlockSize = block_size(Format);
+		std::size_t const ComponentSize = BlockSize / component_count(Format);
+		std::size_t const BlockAlignment = BlockSize & (~BlockSize + 1);
+		return std::min(BlockAlignment, ComponentSize >= 8 ? static_cast<std::size_t>(8) : static_cast<std::size_t>(4));
+	}
+}//namespace detail
+}//namespace gli
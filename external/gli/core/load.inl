@@ -30,6 +30,19 @@ namespace gli
 	/// Load a texture (DDS, KTX or KMG) from file
 	inline texture load(char const * Filename)
 	{
+		std::shared_ptr<detail::file_mapping> Mapping(std::make_shared<detail::file_mapping>(Filename));
+		if(!Mapping->empty())
+		{
+			char const* Data = Mapping->data();
+			std::size_t const Size = Mapping->size();
+
+			if(Size >= sizeof(detail::FOURCC_DDS) && strncmp(Data, detail::FOURCC_DDS, sizeof(detail::FOURCC_DDS)) == 0)
+				return detail::load_dds(Data, Size, Mapping);
+			if(Size >= sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10) && memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
+				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10), Mapping, sizeof(detail::FOURCC_KTX10));
+			return load(Data, Size);
+		}
+
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
 			return texture();
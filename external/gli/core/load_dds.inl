@@ -158,9 +158,9 @@ namespace detail
 			return dx::D3DFMT_AT2N;
 		}
 	}
-}//namespace detail
 
-	inline texture load_dds(char const * Data, std::size_t Size)
+	/// Load a DDS texture, referencing the images of Mapping when Data is its content and they can be accessed in place
+	inline texture load_dds(char const * Data, std::size_t Size, std::shared_ptr<file_mapping> const & Mapping)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_DDS)));
 
@@ -287,10 +287,18 @@ namespace detail
 		if(Header.CubemapFlags & detail::DDSCAPS2_VOLUME)
 			DepthCount = Header.Depth;
 
-		texture Texture(
-			get_target(Header, Header10), Format,
-			texture::extent_type(Header.Width, Header.Height, DepthCount),
-			std::max<texture::size_type>(Header10.ArraySize, 1), FaceCount, MipMapCount);
+		target const Target = get_target(Header, Header10);
+		texture::extent_type const Extent(Header.Width, Header.Height, DepthCount);
+		texture::size_type const Layers = std::max<texture::size_type>(Header10.ArraySize, 1);
+
+		if(Mapping && Offset % texel_alignment(Format) == 0)
+		{
+			std::shared_ptr<texture::storage_type> Storage(std::make_shared<texture::storage_type>(Format, Extent, Layers, FaceCount, MipMapCount, Mapping, Offset));
+			if(Offset + Storage->size() <= Size)
+				return texture(Target, Format, Storage);
+		}
+
+		texture Texture(Target, Format, Extent, Layers, FaceCount, MipMapCount);
 
 		std::size_t const SourceSize = Offset + Texture.size();
 		GLI_ASSERT(SourceSize == Size);
@@ -299,9 +307,19 @@ namespace detail
 
 		return Texture;
 	}
+}//namespace detail
+
+	inline texture load_dds(char const * Data, std::size_t Size)
+	{
+		return detail::load_dds(Data, Size, std::shared_ptr<detail::file_mapping>());
+	}
 
 	inline texture load_dds(char const * Filename)
 	{
+		std::shared_ptr<detail::file_mapping> Mapping(std::make_shared<detail::file_mapping>(Filename));
+		if(!Mapping->empty())
+			return detail::load_dds(Mapping->data(), Mapping->size(), Mapping);
+
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
 			return texture();
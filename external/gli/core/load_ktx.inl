@@ -50,7 +50,9 @@ namespace detail
 			return TARGET_2D;
 	}
 
-	inline texture load_ktx10(char const* Data, std::size_t Size)
+	/// Data follows the KTX identifier. A single level is laid out like storage_linear after its image size
+	/// when faces are 4-byte aligned, then its images are referenced in Mapping rather than copied.
+	inline texture load_ktx10(char const* Data, std::size_t Size, std::shared_ptr<file_mapping> const & Mapping, std::size_t MappingOffset)
 	{
 		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data));
 
@@ -68,16 +70,25 @@ namespace detail
 
 		texture::size_type const BlockSize = block_size(Format);
 
-		texture Texture(
-			detail::get_target(Header),
-			Format,
-			texture::extent_type(
-				Header.PixelWidth,
-				std::max<texture::size_type>(Header.PixelHeight, 1),
-				std::max<texture::size_type>(Header.PixelDepth, 1)),
-			std::max<texture::size_type>(Header.NumberOfArrayElements, 1),
-			std::max<texture::size_type>(Header.NumberOfFaces, 1),
-			std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1));
+		target const Target = detail::get_target(Header);
+		texture::extent_type const Extent(
+			Header.PixelWidth,
+			std::max<texture::size_type>(Header.PixelHeight, 1),
+			std::max<texture::size_type>(Header.PixelDepth, 1));
+		texture::size_type const Layers = std::max<texture::size_type>(Header.NumberOfArrayElements, 1);
+		texture::size_type const Faces = std::max<texture::size_type>(Header.NumberOfFaces, 1);
+		texture::size_type const Levels = std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1);
+
+		std::size_t const ImageOffset = MappingOffset + Offset + sizeof(std::uint32_t);
+		if(Mapping && Levels == 1 && ImageOffset % texel_alignment(Format) == 0)
+		{
+			std::shared_ptr<texture::storage_type> Storage(std::make_shared<texture::storage_type>(Format, Extent, Layers, Faces, Levels, Mapping, ImageOffset));
+			texture::size_type const FaceSize = Storage->level_size(0);
+			if((Layers * Faces == 1 || FaceSize % 4 == 0) && ImageOffset + Storage->size() <= Mapping->size())
+				return texture(Target, Format, Storage);
+		}
+
+		texture Texture(Target, Format, Extent, Layers, Faces, Levels);
 
 		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
 		{
@@ -105,7 +116,7 @@ namespace detail
 		// KTX10
 		{
 			if(memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
-				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10));
+				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10), std::shared_ptr<detail::file_mapping>(), 0);
 		}
 
 		return texture();
@@ -113,6 +124,14 @@ namespace detail
 
 	inline texture load_ktx(char const* Filename)
 	{
+		std::shared_ptr<detail::file_mapping> Mapping(std::make_shared<detail::file_mapping>(Filename));
+		if(!Mapping->empty())
+		{
+			if(Mapping->size() < sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10) || memcmp(Mapping->data(), detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) != 0)
+				return texture();
+			return detail::load_ktx10(Mapping->data() + sizeof(detail::FOURCC_KTX10), Mapping->size() - sizeof(detail::FOURCC_KTX10), Mapping, sizeof(detail::FOURCC_KTX10));
+		}
+
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
 			return texture();
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "filter_compute.hpp"
+#include "texel_codec.hpp"
+#include "parallel.hpp"
+#include <vector>
 
 namespace gli{
 namespace detail
@@ -40,6 +43,161 @@ namespace detail
 		}
 	}
 
+	/// Destination texels of a level processed together by a worker
+	enum
+	{
+		MIPMAP_TEXELS_GRAIN = 4096
+	};
+
+	/// Texel coordinates and blend weight along an axis, computed like make_coord_linear and nearest for the whole axis of a level
+	struct mipmap_axis
+	{
+		int Floor;
+		int Ceil;
+		float Blend;
+	};
+
+	template <typename normalized_value_type>
+	inline void compute_mipmap_axis(std::vector<mipmap_axis>& Axis, int ExtentDst, int ExtentSrc, filter Min)
+	{
+		normalized_value_type const Scale = normalized_value_type(1) / normalized_value_type(glm::max(ExtentDst - 1, 1));
+		normalized_value_type const TexelLast = normalized_value_type(ExtentSrc) - normalized_value_type(1);
+
+		Axis.resize(static_cast<std::size_t>(ExtentDst));
+		for(int i = 0; i < ExtentDst; ++i)
+		{
+			normalized_value_type const ScaledCoord = normalized_value_type(i) * Scale * TexelLast;
+			mipmap_axis& Coord = Axis[static_cast<std::size_t>(i)];
+			if(Min == FILTER_LINEAR)
+			{
+				normalized_value_type const ScaledCoordFloor = normalized_value_type(static_cast<int>(ScaledCoord));
+				Coord.Floor = glm::min(static_cast<int>(ScaledCoordFloor), ExtentSrc - 1);
+				Coord.Ceil = glm::min(static_cast<int>(ScaledCoord + normalized_value_type(0.5)), ExtentSrc - 1);
+				Coord.Blend = static_cast<float>(ScaledCoord - ScaledCoordFloor);
+			}
+			else
+			{
+				Coord.Floor = Coord.Ceil = glm::min(static_cast<int>(ScaledCoord + normalized_value_type(0.5)), ExtentSrc - 1);
+				Coord.Blend = 0.0f;
+			}
+		}
+	}
+
+	/// Generate a level of every slice of an uncompressed 2d texture from raw rows, without the fetch, write and filter indirections
+	template <typename codec, typename texture_type, typename normalized_type, typename texel_type>
+	inline void generate_mipmaps_2d_level
+	(
+		texture_type & Texture,
+		typename texture_type::size_type BaseLayer, typename texture_type::size_type MaxLayer,
+		typename texture_type::size_type BaseFace, typename texture_type::size_type MaxFace,
+		typename texture_type::size_type Level,
+		filter Min
+	)
+	{
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename texture_type::size_type size_type;
+		typedef typename codec::storage_type storage_type;
+		typedef typename normalized_type::value_type normalized_value_type;
+
+		extent_type const ExtentSrc = Texture.extent(Level);
+		extent_type const ExtentDst = Texture.extent(Level + 1);
+
+		std::vector<mipmap_axis> AxisX, AxisY;
+		compute_mipmap_axis<normalized_value_type>(AxisX, ExtentDst.x, ExtentSrc.x, Min);
+		compute_mipmap_axis<normalized_value_type>(AxisY, ExtentDst.y, ExtentSrc.y, Min);
+
+		size_type const Faces = MaxFace - BaseFace + 1;
+		size_type const Rows = static_cast<size_type>(ExtentDst.y);
+		size_type const Slices = (MaxLayer - BaseLayer + 1) * Faces;
+		texture& Storage = Texture;
+
+		parallel_for(Slices * Rows, MIPMAP_TEXELS_GRAIN / static_cast<size_type>(ExtentDst.x) + 1, [&](std::size_t Begin, std::size_t End)
+		{
+			for(std::size_t RowIndex = Begin; RowIndex < End; ++RowIndex)
+			{
+				size_type const Slice = RowIndex / Rows;
+				size_type const Layer = BaseLayer + Slice / Faces;
+				size_type const Face = BaseFace + Slice % Faces;
+				mipmap_axis const& CoordY = AxisY[RowIndex % Rows];
+
+				storage_type const* const Src = static_cast<storage_type const*>(Storage.data(Layer, Face, Level));
+				storage_type const* const SrcRow0 = Src + static_cast<std::size_t>(CoordY.Floor) * ExtentSrc.x;
+				storage_type const* const SrcRow1 = Src + static_cast<std::size_t>(CoordY.Ceil) * ExtentSrc.x;
+				storage_type* const DstRow = static_cast<storage_type*>(Storage.data(Layer, Face, Level + 1)) + (RowIndex % Rows) * ExtentDst.x;
+
+				for(int i = 0; i < ExtentDst.x; ++i)
+				{
+					mipmap_axis const& CoordX = AxisX[static_cast<std::size_t>(i)];
+					texel_type Texel;
+					if(Min == FILTER_LINEAR)
+					{
+						texel_type const Texel00(codec::decode(SrcRow0[CoordX.Floor]));
+						texel_type const Texel10(codec::decode(SrcRow0[CoordX.Ceil]));
+						texel_type const Texel11(codec::decode(SrcRow1[CoordX.Ceil]));
+						texel_type const Texel01(codec::decode(SrcRow1[CoordX.Floor]));
+
+						texel_type const ValueA(mix(Texel00, Texel10, CoordX.Blend));
+						texel_type const ValueB(mix(Texel01, Texel11, CoordX.Blend));
+						Texel = mix(ValueA, ValueB, CoordY.Blend);
+					}
+					else
+						Texel = texel_type(codec::decode(SrcRow0[CoordX.Floor]));
+
+					DstRow[i] = codec::encode(vec4(Texel));
+				}
+			}
+		});
+	}
+
+	/// Generate a level with the codec of the texture format
+	template <typename texture_type, typename normalized_type, typename texel_type>
+	struct generate_mipmaps_2d_visitor
+	{
+		template <typename codec>
+		void call()
+		{
+			generate_mipmaps_2d_level<codec, texture_type, normalized_type, texel_type>(this->Texture, this->BaseLayer, this->MaxLayer, this->BaseFace, this->MaxFace, this->Level, this->Min);
+		}
+
+		texture_type & Texture;
+		typename texture_type::size_type BaseLayer, MaxLayer;
+		typename texture_type::size_type BaseFace, MaxFace;
+		typename texture_type::size_type Level;
+		filter Min;
+	};
+
+	/// Fast paths of float samplers for the formats with a texel_codec, same results as the generic path
+	template <typename sampler_value_type>
+	struct generate_mipmaps_2d_fast
+	{
+		template <typename texture_type, typename normalized_type, typename texel_type>
+		static bool call(texture_type &, typename texture_type::size_type, typename texture_type::size_type, typename texture_type::size_type, typename texture_type::size_type, typename texture_type::size_type, filter)
+		{
+			return false;
+		}
+	};
+
+	template <>
+	struct generate_mipmaps_2d_fast<float>
+	{
+		template <typename texture_type, typename normalized_type, typename texel_type>
+		static bool call
+		(
+			texture_type & Texture,
+			typename texture_type::size_type BaseLayer, typename texture_type::size_type MaxLayer,
+			typename texture_type::size_type BaseFace, typename texture_type::size_type MaxFace,
+			typename texture_type::size_type Level,
+			filter Min
+		)
+		{
+			if(Min != FILTER_LINEAR && Min != FILTER_NEAREST)
+				return false;
+
+			generate_mipmaps_2d_visitor<texture_type, normalized_type, texel_type> Visitor = {Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level, Min};
+			return visit_texel_codec(Texture.format(), Visitor);
+		}
+	};
+
 	template <typename texture_type, typename sampler_value_type, typename fetch_func, typename write_func, typename normalized_type, typename texel_type>
 	inline void generate_mipmaps_2d
 	(
@@ -59,20 +217,36 @@ namespace detail
 		filter_func const Filter = detail::get_filter<filter_func, detail::DIMENSION_2D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type, sampler_value_type>(FILTER_NEAREST, Min, false);
 		GLI_ASSERT(Filter);
 
-		for(size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
-		for(size_type Face = BaseFace; Face <= MaxFace; ++Face)
+		// Each level depends on the previous one, the rows of all the layers and faces of a level are generated in parallel
 		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
 		{
-			extent_type const& ExtentDst = Texture.extent(Level + 1);
-			normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
+			if(generate_mipmaps_2d_fast<sampler_value_type>::template call<texture_type, normalized_type, texel_type>(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, Level, Min))
+				continue;
 
-			for(component_type j = 0; j < ExtentDst.y; ++j)
-			for(component_type i = 0; i < ExtentDst.x; ++i)
+			extent_type const ExtentDst = Texture.extent(Level + 1);
+			normalized_type const Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
+
+			size_type const Faces = MaxFace - BaseFace + 1;
+			size_type const Rows = static_cast<size_type>(ExtentDst.y);
+			size_type const Slices = (MaxLayer - BaseLayer + 1) * Faces;
+
+			parallel_for(Slices * Rows, MIPMAP_TEXELS_GRAIN / static_cast<size_type>(ExtentDst.x) + 1, [&](std::size_t Begin, std::size_t End)
 			{
-				normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
-				texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
-				Write(Texture, extent_type(i, j), Layer, Face, Level + 1, Texel);
-			}
+				for(std::size_t RowIndex = Begin; RowIndex < End; ++RowIndex)
+				{
+					size_type const Slice = RowIndex / Rows;
+					size_type const Layer = BaseLayer + Slice / Faces;
+					size_type const Face = BaseFace + Slice % Faces;
+					component_type const j = static_cast<component_type>(RowIndex % Rows);
+
+					for(component_type i = 0; i < ExtentDst.x; ++i)
+					{
+						normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
+						texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
+						Write(Texture, extent_type(i, j), Layer, Face, Level + 1, Texel);
+					}
+				}
+			});
 		}
 	}
 
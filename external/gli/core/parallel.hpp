@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// Call Func(Begin, End) over [0, Count) split in chunks of Grain items, spread on the hardware threads.
+	/// Runs on the calling thread only when there is a single chunk. Func must be safe to call concurrently on disjoint ranges.
+	template <typename func_type>
+	inline void parallel_for(std::size_t Count, std::size_t Grain, func_type const& Func)
+	{
+		Grain = std::max<std::size_t>(Grain, 1);
+		std::size_t const ChunkCount = (Count + Grain - 1) / Grain;
+		std::size_t const ThreadCount = std::min<std::size_t>(ChunkCount, std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+
+		if(ThreadCount <= 1)
+		{
+			if(Count > 0)
+				Func(static_cast<std::size_t>(0), Count);
+			return;
+		}
+
+		std::atomic<std::size_t> NextChunk(0);
+		auto const Worker = [&]()
+		{
+			for(std::size_t Chunk = NextChunk++; Chunk < ChunkCount; Chunk = NextChunk++)
+				Func(Chunk * Grain, std::min(Count, (Chunk + 1) * Grain));
+		};
+
+		std::vector<std::thread> Threads;
+		Threads.reserve(ThreadCount - 1);
+		for(std::size_t ThreadIndex = 1; ThreadIndex < ThreadCount; ++ThreadIndex)
+			Threads.push_back(std::thread(Worker));
+
+		Worker();
+
+		for(std::size_t ThreadIndex = 0; ThreadIndex < Threads.size(); ++ThreadIndex)
+			Threads[ThreadIndex].join();
+	}
+}//namespace detail
+}//namespace gli
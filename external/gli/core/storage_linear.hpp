@@ -11,6 +11,7 @@
 
 #include "../type.hpp"
 #include "../format.hpp"
+#include "file_mapping.hpp"
 
 // GLM
 #include <glm/gtc/round.hpp>
@@ -42,6 +43,18 @@ namespace gli
 			size_type Faces,
 			size_type Levels);
 
+		/// Storage referencing images laid out as storage_linear at Offset bytes in a file mapping
+		/// rather than owning a copy of them. Mutations are copied on write by the mapping.
+		/// The caller checks that the images fit in the mapping.
+		storage_linear(
+			format_type Format,
+			extent_type const & Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<detail::file_mapping> const & Mapping,
+			size_type Offset);
+
 		bool empty() const;
 		size_type size() const; // Express is bytes
 		size_type layers() const;
@@ -92,6 +105,9 @@ namespace gli
 		extent_type const BlockExtent;
 		extent_type const Extent;
 		std::vector<data_type> Data;
+		std::shared_ptr<detail::file_mapping> Mapping;
+		data_type* MappedData;
+		size_type MappedSize;
 	};
 }//namespace gli
 
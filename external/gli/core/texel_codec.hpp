@@ -0,0 +1,466 @@
+#pragma once
+
+#include "convert_func.hpp"
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace gli{
+namespace detail
+{
+	/// Texel decoding and encoding of the row paths, the same operations as the CONVERT_MODE fetch and write functions for float samplers.
+	/// Unlike the fetch and write functions, a codec is resolved once per operation and inlined in the loops over texels.
+	template <typename T, length_t L, convertMode Mode>
+	struct texel_codec
+	{};
+
+	/// Decoded values of every 8-bit component, computed once by the same functions as the fetch functions
+	struct texel_table
+	{
+		texel_table(bool SRGB)
+		{
+			for(std::size_t Value = 0; Value < this->Data.size(); ++Value)
+			{
+				vec<1, float, defaultp> const Normalized(compNormalize<float>(vec<1, u8, defaultp>(static_cast<u8>(Value))));
+				this->Data[Value] = SRGB ? convertSRGBToLinear(Normalized).x : Normalized.x;
+			}
+		}
+
+		std::array<float, 256> Data;
+	};
+
+	inline float const* get_texel_unorm_table()
+	{
+		static texel_table const Table(false);
+		return &Table.Data[0];
+	}
+
+	inline float const* get_texel_srgb_table()
+	{
+		static texel_table const Table(true);
+		return &Table.Data[0];
+	}
+
+	/// Smallest linear value written as each 8-bit sRGB value by the write functions. The encoding is monotonic, so a texel is encoded by searching the thresholds instead of evaluating a pow.
+	/// The search starts from the value of the float bucket of the texel, a bucket of 2^15 floats in [0, 1] spans at most two encoded values.
+	struct texel_srgb_thresholds
+	{
+		enum
+		{
+			BUCKET_SHIFT = 15
+		};
+
+		texel_srgb_thresholds()
+		{
+			std::uint32_t const OnePastOne = 0x3F800001;
+
+			this->Data[0] = -std::numeric_limits<float>::infinity();
+			for(std::size_t Value = 1; Value < this->Data.size(); ++Value)
+			{
+				// Binary search on the bit patterns of the floats in [0, 1], ordered like the floats
+				std::uint32_t Low = 0;
+				std::uint32_t High = OnePastOne;
+				while(Low < High)
+				{
+					std::uint32_t const Middle = Low + (High - Low) / 2;
+					if(encode(to_float(Middle)) >= Value)
+						High = Middle;
+					else
+						Low = Middle + 1;
+				}
+				this->Data[Value] = Low == OnePastOne ? std::numeric_limits<float>::infinity() : to_float(Low);
+			}
+
+			for(std::size_t Bucket = 0; Bucket < this->Buckets.size(); ++Bucket)
+				this->Buckets[Bucket] = static_cast<u8>(encode(to_float(static_cast<std::uint32_t>(Bucket << BUCKET_SHIFT))));
+			this->One = static_cast<u8>(encode(1.0f));
+		}
+
+		static float to_float(std::uint32_t Bits)
+		{
+			float Value;
+			std::memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		static std::size_t encode(float Value)
+		{
+			return gli::compScale<u8>(convertLinearToSRGB(vec<1, float, defaultp>(Value))).x;
+		}
+
+		/// Same result as encode, the values outside of [0, 1] are clamped like convertLinearToSRGB does
+		u8 operator()(float Value) const
+		{
+			if(!(Value > 0.0f))
+				return 0;
+			if(Value >= 1.0f)
+				return this->One;
+
+			std::uint32_t Bits;
+			std::memcpy(&Bits, &Value, sizeof(Bits));
+
+			std::size_t const Index = this->Buckets[Bits >> BUCKET_SHIFT];
+			return static_cast<u8>(Index + (Value >= this->Data[Index + 1] ? 1 : 0));
+		}
+
+		std::array<float, 257> Data;
+		std::array<u8, (0x3F800000 >> BUCKET_SHIFT)> Buckets;
+		u8 One;
+	};
+
+	inline texel_srgb_thresholds const& get_texel_srgb_thresholds()
+	{
+		static texel_srgb_thresholds const Thresholds;
+		return Thresholds;
+	}
+
+	/// Decoded values of every half float, computed once by the same function as the fetch functions
+	struct texel_half_table
+	{
+		texel_half_table()
+		{
+			for(std::size_t Value = 0; Value < this->Data.size(); ++Value)
+				this->Data[Value] = unpackHalf(vec<1, u16, defaultp>(static_cast<u16>(Value))).x;
+		}
+
+		std::array<float, 65536> Data;
+	};
+
+	inline float const* get_texel_half_table()
+	{
+		static texel_half_table const Table;
+		return &Table.Data[0];
+	}
+
+	/// Same results as packHalf, the normalized halfs are assembled without branches and the other values go through packHalf
+	inline u16 encode_texel_half(float Value)
+	{
+		std::uint32_t Bits;
+		std::memcpy(&Bits, &Value, sizeof(Bits));
+
+		std::uint32_t const Sign = (Bits >> 16) & 0x8000;
+		std::uint32_t const Exponent = (Bits >> 23) & 0xff;
+		std::uint32_t const Mantissa = Bits & 0x007fffff;
+
+		if(Exponent < 127 - 14 || Exponent > 127 + 15)
+			return packHalf(vec<1, float, defaultp>(Value)).x;
+
+		// Rounds to nearest, the carry of the mantissa increments the exponent and an exponent overflow saturates to infinity
+		std::uint32_t const Half = (((Exponent - (127 - 15)) << 10) | (Mantissa >> 13)) + ((Mantissa >> 12) & 1);
+		return static_cast<u16>(Sign | glm::min(Half, 0x7c00u));
+	}
+
+	template <length_t L>
+	struct texel_codec<u8, L, CONVERT_MODE_NORM>
+	{
+		typedef vec<L, u8, defaultp> storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			float const* const Table = get_texel_unorm_table();
+
+			vec<L, float, defaultp> Result;
+			for(length_t Component = 0; Component < L; ++Component)
+				Result[Component] = Table[Texel[Component]];
+			return make_vec4<float, defaultp>(Result);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return storage_type(compScale<u8>(vec<L, float, defaultp>(Texel)));
+		}
+	};
+
+	template <length_t L>
+	struct texel_codec<u8, L, CONVERT_MODE_SRGB>
+	{
+		typedef vec<L, u8, defaultp> storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			float const* const Table = get_texel_srgb_table();
+			float const* const AlphaTable = get_texel_unorm_table();
+
+			// Like convertSRGBToLinear, alpha remains linear
+			vec<L, float, defaultp> Result;
+			for(length_t Component = 0; Component < L; ++Component)
+				Result[Component] = (Component == 3 ? AlphaTable : Table)[Texel[Component]];
+			return make_vec4<float, defaultp>(Result);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			texel_srgb_thresholds const& Thresholds = get_texel_srgb_thresholds();
+
+			storage_type Result;
+			for(length_t Component = 0; Component < L; ++Component)
+				Result[Component] = Component == 3 ? compScale<u8>(vec<1, float, defaultp>(Texel[Component])).x : Thresholds(Texel[Component]);
+			return Result;
+		}
+	};
+
+	template <length_t L>
+	struct texel_codec<u16, L, CONVERT_MODE_HALF>
+	{
+		typedef vec<L, u16, defaultp> storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			float const* const Table = get_texel_half_table();
+
+			vec<L, float, defaultp> Result;
+			for(length_t Component = 0; Component < L; ++Component)
+				Result[Component] = Table[Texel[Component]];
+			return make_vec4<float, defaultp>(Result);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			storage_type Result;
+			for(length_t Component = 0; Component < L; ++Component)
+				Result[Component] = encode_texel_half(Texel[Component]);
+			return Result;
+		}
+	};
+
+	template <length_t L>
+	struct texel_codec<f32, L, CONVERT_MODE_CAST>
+	{
+		typedef vec<L, f32, defaultp> storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return make_vec4<float, defaultp>(Texel);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return storage_type(Texel);
+		}
+	};
+
+	template <>
+	struct texel_codec<u32, 4, CONVERT_MODE_RGB10A2UNORM>
+	{
+		typedef uint32 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackUnorm3x10_1x2(Texel));
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packUnorm3x10_1x2(Texel);
+		}
+	};
+
+	template <>
+	struct texel_codec<u16, 3, CONVERT_MODE_565UNORM>
+	{
+		typedef uint16 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackUnorm1x5_1x6_1x5(Texel), 1.0f);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packUnorm1x5_1x6_1x5(vec3(Texel));
+		}
+	};
+
+	template <>
+	struct texel_codec<u16, 4, CONVERT_MODE_4444UNORM>
+	{
+		typedef uint16 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackUnorm4x4(Texel));
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packUnorm4x4(Texel);
+		}
+	};
+
+	template <>
+	struct texel_codec<u16, 4, CONVERT_MODE_5551UNORM>
+	{
+		typedef uint16 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackUnorm3x5_1x1(Texel));
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packUnorm3x5_1x1(Texel);
+		}
+	};
+
+	template <>
+	struct texel_codec<u32, 3, CONVERT_MODE_RG11B10F>
+	{
+		typedef uint32 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackF2x11_1x10(Texel), 1.0f);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packF2x11_1x10(vec3(Texel));
+		}
+	};
+
+	template <>
+	struct texel_codec<u32, 3, CONVERT_MODE_RGB9E5>
+	{
+		typedef uint32 storage_type;
+
+		static vec4 decode(storage_type const& Texel)
+		{
+			return vec4(unpackF3x9_E1x5(Texel), 1.0f);
+		}
+
+		static storage_type encode(vec4 const& Texel)
+		{
+			return packF3x9_E1x5(vec3(Texel));
+		}
+	};
+
+	/// Call Visitor.template call<codec>() with the codec of Format. Returns false when Format has no codec and needs the fetch and write functions.
+	template <typename visitor>
+	inline bool visit_texel_codec(format Format, visitor & Visitor)
+	{
+		switch(Format)
+		{
+		default:
+			return false;
+		case FORMAT_R8_UNORM_PACK8:
+		case FORMAT_L8_UNORM_PACK8:
+		case FORMAT_A8_UNORM_PACK8:
+			Visitor.template call<texel_codec<u8, 1, CONVERT_MODE_NORM> >();
+			return true;
+		case FORMAT_RG8_UNORM_PACK8:
+		case FORMAT_LA8_UNORM_PACK8:
+			Visitor.template call<texel_codec<u8, 2, CONVERT_MODE_NORM> >();
+			return true;
+		case FORMAT_RGB8_UNORM_PACK8:
+		case FORMAT_BGR8_UNORM_PACK8:
+			Visitor.template call<texel_codec<u8, 3, CONVERT_MODE_NORM> >();
+			return true;
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_BGRA8_UNORM_PACK8:
+		case FORMAT_BGR8_UNORM_PACK32:
+			Visitor.template call<texel_codec<u8, 4, CONVERT_MODE_NORM> >();
+			return true;
+		case FORMAT_R8_SRGB_PACK8:
+			Visitor.template call<texel_codec<u8, 1, CONVERT_MODE_SRGB> >();
+			return true;
+		case FORMAT_RG8_SRGB_PACK8:
+			Visitor.template call<texel_codec<u8, 2, CONVERT_MODE_SRGB> >();
+			return true;
+		case FORMAT_RGB8_SRGB_PACK8:
+		case FORMAT_BGR8_SRGB_PACK8:
+			Visitor.template call<texel_codec<u8, 3, CONVERT_MODE_SRGB> >();
+			return true;
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_BGRA8_SRGB_PACK8:
+		case FORMAT_BGR8_SRGB_PACK32:
+			Visitor.template call<texel_codec<u8, 4, CONVERT_MODE_SRGB> >();
+			return true;
+		case FORMAT_R16_SFLOAT_PACK16:
+			Visitor.template call<texel_codec<u16, 1, CONVERT_MODE_HALF> >();
+			return true;
+		case FORMAT_RG16_SFLOAT_PACK16:
+			Visitor.template call<texel_codec<u16, 2, CONVERT_MODE_HALF> >();
+			return true;
+		case FORMAT_RGB16_SFLOAT_PACK16:
+			Visitor.template call<texel_codec<u16, 3, CONVERT_MODE_HALF> >();
+			return true;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			Visitor.template call<texel_codec<u16, 4, CONVERT_MODE_HALF> >();
+			return true;
+		case FORMAT_R32_SFLOAT_PACK32:
+			Visitor.template call<texel_codec<f32, 1, CONVERT_MODE_CAST> >();
+			return true;
+		case FORMAT_RG32_SFLOAT_PACK32:
+			Visitor.template call<texel_codec<f32, 2, CONVERT_MODE_CAST> >();
+			return true;
+		case FORMAT_RGB32_SFLOAT_PACK32:
+			Visitor.template call<texel_codec<f32, 3, CONVERT_MODE_CAST> >();
+			return true;
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			Visitor.template call<texel_codec<f32, 4, CONVERT_MODE_CAST> >();
+			return true;
+		case FORMAT_RGB10A2_UNORM_PACK32:
+			Visitor.template call<texel_codec<u32, 4, CONVERT_MODE_RGB10A2UNORM> >();
+			return true;
+		case FORMAT_R5G6B5_UNORM_PACK16:
+		case FORMAT_B5G6R5_UNORM_PACK16:
+			Visitor.template call<texel_codec<u16, 3, CONVERT_MODE_565UNORM> >();
+			return true;
+		case FORMAT_RGBA4_UNORM_PACK16:
+		case FORMAT_BGRA4_UNORM_PACK16:
+			Visitor.template call<texel_codec<u16, 4, CONVERT_MODE_4444UNORM> >();
+			return true;
+		case FORMAT_RGB5A1_UNORM_PACK16:
+		case FORMAT_BGR5A1_UNORM_PACK16:
+		case FORMAT_A1RGB5_UNORM_PACK16:
+			Visitor.template call<texel_codec<u16, 4, CONVERT_MODE_5551UNORM> >();
+			return true;
+		case FORMAT_RG11B10_UFLOAT_PACK32:
+			Visitor.template call<texel_codec<u32, 3, CONVERT_MODE_RG11B10F> >();
+			return true;
+		case FORMAT_RGB9E5_UFLOAT_PACK32:
+			Visitor.template call<texel_codec<u32, 3, CONVERT_MODE_RGB9E5> >();
+			return true;
+		}
+	}
+
+	/// Decode and encode contiguous texels, the loops of a single codec are inlined
+	typedef void (*decode_texels_func)(void const* Source, vec4* Texels, std::size_t Count);
+	typedef void (*encode_texels_func)(vec4 const* Texels, void* Destination, std::size_t Count);
+
+	template <typename codec>
+	inline void decode_texels(void const* Source, vec4* Texels, std::size_t Count)
+	{
+		typename codec::storage_type const* const Src = static_cast<typename codec::storage_type const*>(Source);
+		for(std::size_t Index = 0; Index < Count; ++Index)
+			Texels[Index] = codec::decode(Src[Index]);
+	}
+
+	template <typename codec>
+	inline void encode_texels(vec4 const* Texels, void* Destination, std::size_t Count)
+	{
+		typename codec::storage_type* const Dst = static_cast<typename codec::storage_type*>(Destination);
+		for(std::size_t Index = 0; Index < Count; ++Index)
+			Dst[Index] = codec::encode(Texels[Index]);
+	}
+
+	struct texel_codec_funcs
+	{
+		texel_codec_funcs() :
+			Decode(nullptr),
+			Encode(nullptr)
+		{}
+
+		template <typename codec>
+		void call()
+		{
+			this->Decode = decode_texels<codec>;
+			this->Encode = encode_texels<codec>;
+		}
+
+		decode_texels_func Decode;
+		encode_texels_func Encode;
+	};
+}//namespace detail
+}//namespace gli
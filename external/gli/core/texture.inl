@@ -36,6 +36,25 @@ namespace gli
 		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
 	}
 
+	inline texture::texture
+	(
+		target_type Target,
+		format_type Format,
+		std::shared_ptr<storage_type> const& Storage,
+		swizzles_type const& Swizzles
+	)
+		: Storage(Storage)
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Storage->layers() - 1)
+		, BaseFace(0), MaxFace(Storage->faces() - 1)
+		, BaseLevel(0), MaxLevel(Storage->levels() - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(block_size(Format) == Storage->block_size());
+	}
+
 	inline texture::texture
 	(
 		texture const& Texture,
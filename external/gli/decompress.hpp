@@ -0,0 +1,26 @@
+/// @brief Include to decompress DXT, ATI1N, ATI2N, ETC1, ETC2 and EAC textures.
+/// @file gli/decompress.hpp
+
+#pragma once
+
+#include "texture.hpp"
+
+namespace gli
+{
+	/// Decompress a level of a texture, block rows are decoded in parallel.
+	/// The DXT, ATI1N and ATI2N texels are identical to the ones fetched one by one by convert_func written with compScale.
+	///
+	/// @param Texture Source texture, the format must be one of the DXT, ATI1N, ATI2N, ETC1, ETC2 or EAC block formats.
+	/// @param Level Level to decompress
+	/// @return A single level texture with the target, layers and faces of Texture, RGBA8 for DXT and ETC formats, R8 for ATI1N, RG8 for ATI2N, R16 for R11 EAC and RG16 for RG11 EAC.
+	/// Returns an empty texture if the format isn't supported.
+	texture decompress(texture const& Texture, texture::size_type Level);
+
+	/// Decompress every level of a texture, see decompress(Texture, Level)
+	texture decompress(texture const& Texture);
+
+	/// Format of the texture returned by decompress or FORMAT_UNDEFINED if Format can't be decompressed
+	format decompressed_format(format Format);
+}//namespace gli
+
+#include "./core/decompress.inl"
@@ -60,6 +60,8 @@ namespace gli
 
 #include "duplicate.hpp"
 #include "convert.hpp"
+#include "decompress.hpp"
+#include "compress.hpp"
 #include "view.hpp"
 #include "comparison.hpp"
 
@@ -72,712 +72,230 @@ void caps::initVersion()
 	}
 }
 
-void caps::initExtensions()
+void caps::initExtensions(extension_registry const & Registry)
 {
 	memset(&ExtensionData, 0, sizeof(ExtensionData));
 
 	glGetIntegerv(GL_NUM_EXTENSIONS, &VersionData.NUM_EXTENSIONS);
 
-	if((this->VersionData.PROFILE == CORE) || (this->VersionData.PROFILE == COMPATIBILITY))
-	{
-		for (GLint i = 0; i < VersionData.NUM_EXTENSIONS; ++i)
-		{
-			const char* Extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
-			if(!strcmp("GL_ARB_multitexture", Extension)) {
-				ExtensionData.ARB_multitexture = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transpose_matrix", Extension)) {
-				ExtensionData.ARB_transpose_matrix = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_multisample", Extension)) {
-				ExtensionData.ARB_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_add", Extension)) {
-				ExtensionData.ARB_texture_env_add = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_cube_map", Extension)) {
-				ExtensionData.ARB_texture_cube_map = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression", Extension)) {
-				ExtensionData.ARB_texture_compression = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_border_clamp", Extension)) {
-				ExtensionData.ARB_texture_border_clamp = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_point_parameters", Extension)) {
-				ExtensionData.ARB_point_parameters = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_blend", Extension)) {
-				ExtensionData.ARB_vertex_blend = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_matrix_palette", Extension)) {
-				ExtensionData.ARB_matrix_palette = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_combine", Extension)) {
-				ExtensionData.ARB_texture_env_combine = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_crossbar", Extension)) {
-				ExtensionData.ARB_texture_env_crossbar = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_dot3", Extension)) {
-				ExtensionData.ARB_texture_env_dot3 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_mirrored_repeat", Extension)) { 
-				ExtensionData.ARB_texture_mirrored_repeat = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_texture", Extension)) {
-				ExtensionData.ARB_depth_texture = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shadow", Extension)) {
-				ExtensionData.ARB_shadow = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shadow_ambient", Extension)) {
-				ExtensionData.ARB_shadow_ambient = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_window_pos", Extension)) {
-				ExtensionData.ARB_window_pos = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_program", Extension)) {
-				ExtensionData.ARB_vertex_program = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_program", Extension)) {
-				ExtensionData.ARB_fragment_program = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_buffer_object", Extension)) {
-				ExtensionData.ARB_vertex_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_occlusion_query", Extension)) {
-				ExtensionData.ARB_occlusion_query = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_objects", Extension)) {
-				ExtensionData.ARB_shader_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_shader", Extension)) {
-				ExtensionData.ARB_vertex_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_shader", Extension)) {
-				ExtensionData.ARB_fragment_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shading_language_100", Extension)) {
-				ExtensionData.ARB_shading_language_100 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_non_power_of_two", Extension)) {
-				ExtensionData.ARB_texture_non_power_of_two = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_point_sprite", Extension)) {
-				ExtensionData.ARB_point_sprite = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_program_shadow", Extension)) {
-				ExtensionData.ARB_fragment_program_shadow = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_buffers", Extension)) {
-				ExtensionData.ARB_draw_buffers = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rectangle", Extension)) {
-				ExtensionData.ARB_texture_rectangle = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_color_buffer_float", Extension)) {
-				ExtensionData.ARB_color_buffer_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_half_float_pixel", Extension)) {
-				ExtensionData.ARB_half_float_pixel = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_float", Extension)) {
-				ExtensionData.ARB_texture_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_pixel_buffer_object", Extension)) {
-				ExtensionData.ARB_pixel_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_buffer_float", Extension)) {
-				ExtensionData.ARB_depth_buffer_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_instanced", Extension)) {
-				ExtensionData.ARB_draw_instanced = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_framebuffer_object", Extension)) {
-				ExtensionData.ARB_framebuffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_framebuffer_sRGB", Extension)) {
-				ExtensionData.ARB_framebuffer_sRGB = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_geometry_shader4", Extension)) {
-				ExtensionData.ARB_geometry_shader4 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_half_float_vertex", Extension)) {
-				ExtensionData.ARB_half_float_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_instanced_arrays", Extension)) {
-				ExtensionData.ARB_instanced_arrays = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_map_buffer_range", Extension)) {
-				ExtensionData.ARB_map_buffer_range = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_buffer_object", Extension)) {
-				ExtensionData.ARB_texture_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression_rgtc", Extension)) {
-				ExtensionData.ARB_texture_compression_rgtc = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rg", Extension)) {
-				ExtensionData.ARB_texture_rg = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_array_object", Extension)) {
-				ExtensionData.ARB_vertex_array_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_uniform_buffer_object", Extension)) {
-				ExtensionData.ARB_uniform_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_compatibility", Extension)) {
-				ExtensionData.ARB_compatibility = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_copy_buffer", Extension)) {
-				ExtensionData.ARB_copy_buffer = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_texture_lod", Extension)) {
-				ExtensionData.ARB_shader_texture_lod = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_clamp", Extension)) {
-				ExtensionData.ARB_depth_clamp = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_elements_base_vertex", Extension)) {
-				ExtensionData.ARB_draw_elements_base_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_coord_conventions", Extension)) {
-				ExtensionData.ARB_fragment_coord_conventions = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_provoking_vertex", Extension)) {
-				ExtensionData.ARB_provoking_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_seamless_cube_map", Extension)) {
-				ExtensionData.ARB_seamless_cube_map = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sync", Extension)) {
-				ExtensionData.ARB_sync = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_multisample", Extension)) {
-				ExtensionData.ARB_texture_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_array_bgra", Extension)) {
-				ExtensionData.ARB_vertex_array_bgra = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_buffers_blend", Extension)) {
-				ExtensionData.ARB_draw_buffers_blend = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sample_shading", Extension)) {
-				ExtensionData.ARB_sample_shading = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_cube_map_array", Extension)) {
-				ExtensionData.ARB_texture_cube_map_array = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_gather", Extension)) {
-				ExtensionData.ARB_texture_gather = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_query_lod", Extension)) {
-				ExtensionData.ARB_texture_query_lod = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shading_language_include", Extension)) {
-				ExtensionData.ARB_shading_language_include = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression_bptc", Extension)) {
-				ExtensionData.ARB_texture_compression_bptc = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_blend_func_extended", Extension)) {
-				ExtensionData.ARB_blend_func_extended = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_explicit_attrib_location", Extension)) {
-				ExtensionData.ARB_explicit_attrib_location = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_occlusion_query2", Extension)) {
-				ExtensionData.ARB_occlusion_query2 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sampler_objects", Extension)) {
-				ExtensionData.ARB_sampler_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_bit_encoding", Extension)) {
-				ExtensionData.ARB_shader_bit_encoding = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rgb10_a2ui", Extension)) {
-				ExtensionData.ARB_texture_rgb10_a2ui = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_swizzle", Extension)) {
-				ExtensionData.ARB_texture_swizzle = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_timer_query", Extension)) {
-				ExtensionData.ARB_timer_query = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_type_2_10_10_10_rev", Extension)) {
-				ExtensionData.ARB_vertex_type_2_10_10_10_rev = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_indirect", Extension)) {
-				ExtensionData.ARB_draw_indirect = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_gpu_shader5", Extension)) {
-				ExtensionData.ARB_gpu_shader5 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_gpu_shader_fp64", Extension)) {
-				ExtensionData.ARB_gpu_shader_fp64 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_subroutine", Extension)) {
-				ExtensionData.ARB_shader_subroutine = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_tessellation_shader", Extension)) {
-				ExtensionData.ARB_tessellation_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_buffer_object_rgb32", Extension)) {
-				ExtensionData.ARB_texture_buffer_object_rgb32 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transform_feedback2", Extension)) {
-				ExtensionData.ARB_transform_feedback2 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transform_feedback3", Extension)) {
-				ExtensionData.ARB_transform_feedback3 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_ES2_compatibility", Extension)) {
-				ExtensionData.ARB_ES2_compatibility = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_get_program_binary", Extension)) {
-				ExtensionData.ARB_get_program_binary = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_separate_shader_objects", Extension)) {
-				ExtensionData.ARB_separate_shader_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_precision", Extension)) {
-				ExtensionData.ARB_shader_precision = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_attrib_64bit", Extension)) {
-				ExtensionData.ARB_vertex_attrib_64bit = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_viewport_array", Extension)) {
-				ExtensionData.ARB_viewport_array = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_cl_event", Extension)) {
-				ExtensionData.ARB_cl_event = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_debug_output", Extension)) {
-				ExtensionData.ARB_debug_output = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_robustness", Extension)) {
-				ExtensionData.ARB_robustness = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_stencil_export", Extension)) {
-				ExtensionData.ARB_shader_stencil_export = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_base_instance", Extension)) {
-				ExtensionData.ARB_base_instance = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shading_language_420pack", Extension)) {
-				ExtensionData.ARB_shading_language_420pack = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_transform_feedback_instanced", Extension)) {
-				ExtensionData.ARB_transform_feedback_instanced = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_compressed_texture_pixel_storage", Extension)) {
-				ExtensionData.ARB_compressed_texture_pixel_storage = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_conservative_depth", Extension)) {
-				ExtensionData.ARB_conservative_depth = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_internalformat_query", Extension)) {
-				ExtensionData.ARB_internalformat_query = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_map_buffer_alignment", Extension)) {
-				ExtensionData.ARB_map_buffer_alignment = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shader_atomic_counters", Extension)) {
-				ExtensionData.ARB_shader_atomic_counters = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shader_image_load_store", Extension)) {
-				ExtensionData.ARB_shader_image_load_store = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shading_language_packing", Extension)) {
-				ExtensionData.ARB_shading_language_packing = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_texture_storage", Extension)) {
-				ExtensionData.ARB_texture_storage = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_texture_compression_astc_hdr", Extension)) {
-				ExtensionData.KHR_texture_compression_astc_hdr = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_texture_compression_astc_ldr", Extension)) {
-				ExtensionData.KHR_texture_compression_astc_ldr = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_debug", Extension)) {
-				ExtensionData.KHR_debug = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_arrays_of_arrays", Extension)) {
-				ExtensionData.ARB_arrays_of_arrays = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_clear_buffer_object", Extension))
-				ExtensionData.ARB_clear_buffer_object = true;
-			else if(!strcmp("GL_ARB_compute_shader", Extension))
-				ExtensionData.ARB_compute_shader = true;
-			else if(!strcmp("GL_ARB_copy_image", Extension))
-				ExtensionData.ARB_copy_image = true;
-			else if(!strcmp("GL_ARB_texture_view", Extension))
-				ExtensionData.ARB_texture_view = true;
-			else if(!strcmp("GL_ARB_vertex_attrib_binding", Extension))
-				ExtensionData.ARB_vertex_attrib_binding = true;
-			else if(!strcmp("GL_ARB_robustness_isolation", Extension))
-				ExtensionData.ARB_robustness_isolation = true;
-			else if(!strcmp("GL_ARB_ES3_compatibility", Extension))
-				ExtensionData.ARB_ES3_compatibility = true;
-			else if(!strcmp("GL_ARB_explicit_uniform_location", Extension))
-				ExtensionData.ARB_explicit_uniform_location = true;
-			else if(!strcmp("GL_ARB_fragment_layer_viewport", Extension))
-				ExtensionData.ARB_fragment_layer_viewport = true;
-			else if(!strcmp("GL_ARB_framebuffer_no_attachments", Extension))
-				ExtensionData.ARB_framebuffer_no_attachments = true;
-			else if(!strcmp("GL_ARB_internalformat_query2", Extension))
-				ExtensionData.ARB_internalformat_query2 = true;
-			else if(!strcmp("GL_ARB_invalidate_subdata", Extension))
-				ExtensionData.ARB_invalidate_subdata = true;
-			else if(!strcmp("GL_ARB_multi_draw_indirect", Extension))
-				ExtensionData.ARB_multi_draw_indirect = true;
-			else if(!strcmp("GL_ARB_program_interface_query", Extension))
-				ExtensionData.ARB_program_interface_query = true;
-			else if(!strcmp("GL_ARB_robust_buffer_access_behavior", Extension))
-				ExtensionData.ARB_robust_buffer_access_behavior = true;
-			else if(!strcmp("GL_ARB_shader_image_size", Extension))
-				ExtensionData.ARB_shader_image_size = true;
-			else if(!strcmp("GL_ARB_shader_storage_buffer_object", Extension))
-				ExtensionData.ARB_shader_storage_buffer_object = true;
-			else if(!strcmp("GL_ARB_stencil_texturing", Extension))
-				ExtensionData.ARB_stencil_texturing = true;
-			else if(!strcmp("GL_ARB_texture_buffer_range", Extension))
-				ExtensionData.ARB_texture_buffer_range = true;
-			else if(!strcmp("GL_ARB_texture_query_levels", Extension))
-				ExtensionData.ARB_texture_query_levels = true;
-			else if(!strcmp("GL_ARB_texture_storage_multisample", Extension))
-				ExtensionData.ARB_texture_storage_multisample = true;
-			else if(!strcmp("GL_ARB_buffer_storage", Extension))
-				ExtensionData.ARB_buffer_storage = true;
-			else if(!strcmp("GL_ARB_clear_texture", Extension))
-				ExtensionData.ARB_clear_texture = true;
-			else if(!strcmp("GL_ARB_enhanced_layouts", Extension))
-				ExtensionData.ARB_enhanced_layouts = true;
-			else if(!strcmp("GL_ARB_multi_bind", Extension))
-				ExtensionData.ARB_multi_bind = true;
-			else if(!strcmp("GL_ARB_query_buffer_object", Extension))
-				ExtensionData.ARB_query_buffer_object = true;
-			else if(!strcmp("GL_ARB_texture_mirror_clamp_to_edge", Extension))
-				ExtensionData.ARB_texture_mirror_clamp_to_edge = true;
-			else if(!strcmp("GL_ARB_texture_stencil8", Extension))
-				ExtensionData.ARB_texture_stencil8 = true;
-			else if(!strcmp("GL_ARB_vertex_type_10f_11f_11f_rev", Extension))
-				ExtensionData.ARB_vertex_type_10f_11f_11f_rev = true;
-			else if(!strcmp("GL_ARB_bindless_texture", Extension))
-				ExtensionData.ARB_bindless_texture = true;
-			else if(!strcmp("GL_ARB_compute_variable_group_size", Extension))
-				ExtensionData.ARB_compute_variable_group_size = true;
-			else if(!strcmp("GL_ARB_indirect_parameters", Extension))
-				ExtensionData.ARB_indirect_parameters = true;
-			else if(!strcmp("GL_ARB_seamless_cubemap_per_texture", Extension))
-				ExtensionData.ARB_seamless_cubemap_per_texture = true;
-			else if(!strcmp("GL_ARB_shader_draw_parameters", Extension))
-				ExtensionData.ARB_shader_draw_parameters = true;
-			else if(!strcmp("GL_ARB_shader_group_vote", Extension))
-				ExtensionData.ARB_shader_group_vote = true;
-			else if(!strcmp("GL_ARB_sparse_texture", Extension))
-				ExtensionData.ARB_sparse_texture = true;
-			else if(!strcmp("GL_ARB_ES3_1_compatibility", Extension))
-				ExtensionData.ARB_ES3_1_compatibility = true;
-			else if(!strcmp("GL_ARB_clip_control", Extension))
-				ExtensionData.ARB_clip_control = true;
-			else if(!strcmp("GL_ARB_conditional_render_inverted", Extension))
-				ExtensionData.ARB_conditional_render_inverted = true;
-			else if(!strcmp("GL_ARB_derivative_control", Extension))
-				ExtensionData.ARB_derivative_control = true;
-			else if(!strcmp("GL_ARB_direct_state_access", Extension))
-				ExtensionData.ARB_direct_state_access = true;
-			else if(!strcmp("GL_ARB_get_texture_sub_image", Extension))
-				ExtensionData.ARB_get_texture_sub_image = true;
-			else if(!strcmp("GL_ARB_shader_texture_image_samples", Extension))
-				ExtensionData.ARB_shader_texture_image_samples = true;
-			else if(!strcmp("GL_ARB_texture_barrier", Extension))
-				ExtensionData.ARB_texture_barrier = true;
-			else if(!strcmp("GL_KHR_context_flush_control", Extension))
-				ExtensionData.KHR_context_flush_control = true;
-			else if(!strcmp("GL_KHR_robust_buffer_access_behavior", Extension))
-				ExtensionData.KHR_robust_buffer_access_behavior = true;
-			else if(!strcmp("GL_KHR_robustness", Extension))
-				ExtensionData.KHR_robustness = true;
-			else if(!strcmp("GL_ARB_pipeline_statistics_query", Extension))
-				ExtensionData.ARB_pipeline_statistics_query = true;
-			else if(!strcmp("GL_ARB_sparse_buffer", Extension))
-				ExtensionData.ARB_sparse_buffer = true;
-			else if(!strcmp("GL_ARB_transform_feedback_overflow_query", Extension))
-				ExtensionData.ARB_transform_feedback_overflow_query = true;
-
-			// EXT
-			if(!strcmp("GL_EXT_texture_compression_s3tc", Extension)) {
-				ExtensionData.EXT_texture_compression_s3tc = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_compression_latc", Extension)) {
-				ExtensionData.EXT_texture_compression_latc = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_transform_feedback", Extension)) {
-				ExtensionData.EXT_transform_feedback = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_direct_state_access", Extension)) {
-				ExtensionData.EXT_direct_state_access = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_filter_anisotropic", Extension)) {
-				ExtensionData.EXT_texture_filter_anisotropic = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_array", Extension)) {
-				ExtensionData.EXT_texture_array = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_snorm", Extension)) {
-				ExtensionData.EXT_texture_snorm = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_sRGB_decode", Extension)) {
-				ExtensionData.EXT_texture_sRGB_decode = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_framebuffer_multisample_blit_scaled", Extension)) {
-				ExtensionData.EXT_framebuffer_multisample_blit_scaled = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_shader_integer_mix", Extension)) {
-				ExtensionData.EXT_shader_integer_mix = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_polygon_offset_clamp", Extension)) {
-				ExtensionData.EXT_polygon_offset_clamp = true;
-				continue;
-			}
-
-			// NV
-			if(!strcmp("GL_NV_explicit_multisample", Extension)) {
-				ExtensionData.NV_explicit_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_buffer_load", Extension)) {
-				ExtensionData.NV_shader_buffer_load = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_vertex_buffer_unified_memory", Extension)) {
-				ExtensionData.NV_vertex_buffer_unified_memory = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_buffer_store", Extension)) {
-				ExtensionData.NV_shader_buffer_store = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_bindless_multi_draw_indirect", Extension)) {
-				ExtensionData.NV_bindless_multi_draw_indirect = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_blend_equation_advanced", Extension)) {
-				ExtensionData.NV_blend_equation_advanced = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_deep_texture3D", Extension)) {
-				ExtensionData.NV_deep_texture3D = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_thread_group", Extension)) {
-				ExtensionData.NV_shader_thread_group = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_thread_shuffle", Extension)) {
-				ExtensionData.NV_shader_thread_shuffle = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_atomic_int64", Extension)) {
-				ExtensionData.NV_shader_atomic_int64 = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_bindless_multi_draw_indirect_count", Extension)) {
-				ExtensionData.NV_bindless_multi_draw_indirect_count = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_uniform_buffer_unified_memory", Extension)) {
-				ExtensionData.NV_uniform_buffer_unified_memory = true;
-				continue;
-			}
-
-			// AMD
-
-			if(!strcmp("GL_ATI_texture_compression_3dc", Extension)) {
-				ExtensionData.ATI_texture_compression_3dc = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_depth_clamp_separate", Extension)) {
-				ExtensionData.AMD_depth_clamp_separate = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_stencil_operation_extended", Extension)) {
-				ExtensionData.AMD_stencil_operation_extended = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_vertex_shader_viewport_index", Extension)) {
-				ExtensionData.AMD_vertex_shader_viewport_index = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_vertex_shader_layer", Extension)) {
-				ExtensionData.AMD_vertex_shader_layer = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_trinary_minmax", Extension)) {
-				ExtensionData.AMD_shader_trinary_minmax = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_interleaved_elements", Extension)) {
-				ExtensionData.AMD_interleaved_elements = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_atomic_counter_ops", Extension)) {
-				ExtensionData.AMD_shader_atomic_counter_ops = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_stencil_value_export", Extension)) {
-				ExtensionData.AMD_shader_stencil_value_export = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_transform_feedback4", Extension)) {
-				ExtensionData.AMD_transform_feedback4 = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_gpu_shader_int64", Extension)) {
-				ExtensionData.AMD_gpu_shader_int64 = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_gcn_shader", Extension)) {
-				ExtensionData.AMD_gcn_shader = true;
-				continue;
-			}
-
-			// Intel
-			if(!strcmp("GL_INTEL_map_texture", Extension)) {
-				ExtensionData.INTEL_map_texture = true;
-				continue;
-			}
-			if(!strcmp("GL_INTEL_fragment_shader_ordering", Extension)) {
-				ExtensionData.INTEL_fragment_shader_ordering = true;
-				continue;
-			}
-			if(!strcmp("GL_INTEL_performance_query", Extension)) {
-				ExtensionData.INTEL_performance_query = true;
-				continue;
-			}
-		}
-	}
+	if((this->VersionData.PROFILE != CORE) && (this->VersionData.PROFILE != COMPATIBILITY))
+		return;
+
+	// Names hashed at compile time, each field is set by a single lookup in the extensions of the context
+	struct field
+	{
+		std::uint32_t Hash;
+		char const* Name;
+		bool extensions::* Member;
+	};
+
+#	define CAPS_EXTENSION(Name) {extension_hash("GL_" #Name), "GL_" #Name, &extensions::Name}
+	static field const Fields[] =
+	{
+		CAPS_EXTENSION(ARB_multitexture),
+		CAPS_EXTENSION(ARB_transpose_matrix),
+		CAPS_EXTENSION(ARB_multisample),
+		CAPS_EXTENSION(ARB_texture_env_add),
+		CAPS_EXTENSION(ARB_texture_cube_map),
+		CAPS_EXTENSION(ARB_texture_compression),
+		CAPS_EXTENSION(ARB_texture_border_clamp),
+		CAPS_EXTENSION(ARB_point_parameters),
+		CAPS_EXTENSION(ARB_vertex_blend),
+		CAPS_EXTENSION(ARB_matrix_palette),
+		CAPS_EXTENSION(ARB_texture_env_combine),
+		CAPS_EXTENSION(ARB_texture_env_crossbar),
+		CAPS_EXTENSION(ARB_texture_env_dot3),
+		CAPS_EXTENSION(ARB_texture_mirrored_repeat),
+		CAPS_EXTENSION(ARB_depth_texture),
+		CAPS_EXTENSION(ARB_shadow),
+		CAPS_EXTENSION(ARB_shadow_ambient),
+		CAPS_EXTENSION(ARB_window_pos),
+		CAPS_EXTENSION(ARB_vertex_program),
+		CAPS_EXTENSION(ARB_fragment_program),
+		CAPS_EXTENSION(ARB_vertex_buffer_object),
+		CAPS_EXTENSION(ARB_occlusion_query),
+		CAPS_EXTENSION(ARB_shader_objects),
+		CAPS_EXTENSION(ARB_vertex_shader),
+		CAPS_EXTENSION(ARB_fragment_shader),
+		CAPS_EXTENSION(ARB_shading_language_100),
+		CAPS_EXTENSION(ARB_texture_non_power_of_two),
+		CAPS_EXTENSION(ARB_point_sprite),
+		CAPS_EXTENSION(ARB_fragment_program_shadow),
+		CAPS_EXTENSION(ARB_draw_buffers),
+		CAPS_EXTENSION(ARB_texture_rectangle),
+		CAPS_EXTENSION(ARB_color_buffer_float),
+		CAPS_EXTENSION(ARB_half_float_pixel),
+		CAPS_EXTENSION(ARB_texture_float),
+		CAPS_EXTENSION(ARB_pixel_buffer_object),
+		CAPS_EXTENSION(ARB_depth_buffer_float),
+		CAPS_EXTENSION(ARB_draw_instanced),
+		CAPS_EXTENSION(ARB_framebuffer_object),
+		CAPS_EXTENSION(ARB_framebuffer_sRGB),
+		CAPS_EXTENSION(ARB_geometry_shader4),
+		CAPS_EXTENSION(ARB_half_float_vertex),
+		CAPS_EXTENSION(ARB_instanced_arrays),
+		CAPS_EXTENSION(ARB_map_buffer_range),
+		CAPS_EXTENSION(ARB_texture_buffer_object),
+		CAPS_EXTENSION(ARB_texture_compression_rgtc),
+		CAPS_EXTENSION(ARB_texture_rg),
+		CAPS_EXTENSION(ARB_vertex_array_object),
+		CAPS_EXTENSION(ARB_uniform_buffer_object),
+		CAPS_EXTENSION(ARB_compatibility),
+		CAPS_EXTENSION(ARB_copy_buffer),
+		CAPS_EXTENSION(ARB_shader_texture_lod),
+		CAPS_EXTENSION(ARB_depth_clamp),
+		CAPS_EXTENSION(ARB_draw_elements_base_vertex),
+		CAPS_EXTENSION(ARB_fragment_coord_conventions),
+		CAPS_EXTENSION(ARB_provoking_vertex),
+		CAPS_EXTENSION(ARB_seamless_cube_map),
+		CAPS_EXTENSION(ARB_sync),
+		CAPS_EXTENSION(ARB_texture_multisample),
+		CAPS_EXTENSION(ARB_vertex_array_bgra),
+		CAPS_EXTENSION(ARB_draw_buffers_blend),
+		CAPS_EXTENSION(ARB_sample_shading),
+		CAPS_EXTENSION(ARB_texture_cube_map_array),
+		CAPS_EXTENSION(ARB_texture_gather),
+		CAPS_EXTENSION(ARB_texture_query_lod),
+		CAPS_EXTENSION(ARB_shading_language_include),
+		CAPS_EXTENSION(ARB_texture_compression_bptc),
+		CAPS_EXTENSION(ARB_blend_func_extended),
+		CAPS_EXTENSION(ARB_explicit_attrib_location),
+		CAPS_EXTENSION(ARB_occlusion_query2),
+		CAPS_EXTENSION(ARB_sampler_objects),
+		CAPS_EXTENSION(ARB_shader_bit_encoding),
+		CAPS_EXTENSION(ARB_texture_rgb10_a2ui),
+		CAPS_EXTENSION(ARB_texture_swizzle),
+		CAPS_EXTENSION(ARB_timer_query),
+		CAPS_EXTENSION(ARB_vertex_type_2_10_10_10_rev),
+		CAPS_EXTENSION(ARB_draw_indirect),
+		CAPS_EXTENSION(ARB_gpu_shader5),
+		CAPS_EXTENSION(ARB_gpu_shader_fp64),
+		CAPS_EXTENSION(ARB_shader_subroutine),
+		CAPS_EXTENSION(ARB_tessellation_shader),
+		CAPS_EXTENSION(ARB_texture_buffer_object_rgb32),
+		CAPS_EXTENSION(ARB_transform_feedback2),
+		CAPS_EXTENSION(ARB_transform_feedback3),
+		CAPS_EXTENSION(ARB_ES2_compatibility),
+		CAPS_EXTENSION(ARB_get_program_binary),
+		CAPS_EXTENSION(ARB_separate_shader_objects),
+		CAPS_EXTENSION(ARB_shader_precision),
+		CAPS_EXTENSION(ARB_vertex_attrib_64bit),
+		CAPS_EXTENSION(ARB_viewport_array),
+		CAPS_EXTENSION(ARB_cl_event),
+		CAPS_EXTENSION(ARB_debug_output),
+		CAPS_EXTENSION(ARB_robustness),
+		CAPS_EXTENSION(ARB_shader_stencil_export),
+		CAPS_EXTENSION(ARB_base_instance),
+		CAPS_EXTENSION(ARB_shading_language_420pack),
+		CAPS_EXTENSION(ARB_transform_feedback_instanced),
+		CAPS_EXTENSION(ARB_compressed_texture_pixel_storage),
+		CAPS_EXTENSION(ARB_conservative_depth),
+		CAPS_EXTENSION(ARB_internalformat_query),
+		CAPS_EXTENSION(ARB_map_buffer_alignment),
+		CAPS_EXTENSION(ARB_shader_atomic_counters),
+		CAPS_EXTENSION(ARB_shader_image_load_store),
+		CAPS_EXTENSION(ARB_shading_language_packing),
+		CAPS_EXTENSION(ARB_texture_storage),
+		CAPS_EXTENSION(KHR_texture_compression_astc_hdr),
+		CAPS_EXTENSION(KHR_texture_compression_astc_ldr),
+		CAPS_EXTENSION(KHR_debug),
+		CAPS_EXTENSION(ARB_arrays_of_arrays),
+		CAPS_EXTENSION(ARB_clear_buffer_object),
+		CAPS_EXTENSION(ARB_compute_shader),
+		CAPS_EXTENSION(ARB_copy_image),
+		CAPS_EXTENSION(ARB_texture_view),
+		CAPS_EXTENSION(ARB_vertex_attrib_binding),
+		CAPS_EXTENSION(ARB_robustness_isolation),
+		CAPS_EXTENSION(ARB_ES3_compatibility),
+		CAPS_EXTENSION(ARB_explicit_uniform_location),
+		CAPS_EXTENSION(ARB_fragment_layer_viewport),
+		CAPS_EXTENSION(ARB_framebuffer_no_attachments),
+		CAPS_EXTENSION(ARB_internalformat_query2),
+		CAPS_EXTENSION(ARB_invalidate_subdata),
+		CAPS_EXTENSION(ARB_multi_draw_indirect),
+		CAPS_EXTENSION(ARB_program_interface_query),
+		CAPS_EXTENSION(ARB_robust_buffer_access_behavior),
+		CAPS_EXTENSION(ARB_shader_image_size),
+		CAPS_EXTENSION(ARB_shader_storage_buffer_object),
+		CAPS_EXTENSION(ARB_stencil_texturing),
+		CAPS_EXTENSION(ARB_texture_buffer_range),
+		CAPS_EXTENSION(ARB_texture_query_levels),
+		CAPS_EXTENSION(ARB_texture_storage_multisample),
+		CAPS_EXTENSION(ARB_buffer_storage),
+		CAPS_EXTENSION(ARB_clear_texture),
+		CAPS_EXTENSION(ARB_enhanced_layouts),
+		CAPS_EXTENSION(ARB_multi_bind),
+		CAPS_EXTENSION(ARB_query_buffer_object),
+		CAPS_EXTENSION(ARB_texture_mirror_clamp_to_edge),
+		CAPS_EXTENSION(ARB_texture_stencil8),
+		CAPS_EXTENSION(ARB_vertex_type_10f_11f_11f_rev),
+		CAPS_EXTENSION(ARB_bindless_texture),
+		CAPS_EXTENSION(ARB_compute_variable_group_size),
+		CAPS_EXTENSION(ARB_indirect_parameters),
+		CAPS_EXTENSION(ARB_seamless_cubemap_per_texture),
+		CAPS_EXTENSION(ARB_shader_draw_parameters),
+		CAPS_EXTENSION(ARB_shader_group_vote),
+		CAPS_EXTENSION(ARB_sparse_texture),
+		CAPS_EXTENSION(ARB_ES3_1_compatibility),
+		CAPS_EXTENSION(ARB_clip_control),
+		CAPS_EXTENSION(ARB_conditional_render_inverted),
+		CAPS_EXTENSION(ARB_cull_distance),
+		CAPS_EXTENSION(ARB_derivative_control),
+		CAPS_EXTENSION(ARB_direct_state_access),
+		CAPS_EXTENSION(ARB_get_texture_sub_image),
+		CAPS_EXTENSION(ARB_shader_texture_image_samples),
+		CAPS_EXTENSION(ARB_texture_barrier),
+		CAPS_EXTENSION(KHR_context_flush_control),
+		CAPS_EXTENSION(KHR_robust_buffer_access_behavior),
+		CAPS_EXTENSION(KHR_robustness),
+		CAPS_EXTENSION(ARB_pipeline_statistics_query),
+		CAPS_EXTENSION(ARB_sparse_buffer),
+		CAPS_EXTENSION(ARB_transform_feedback_overflow_query),
+		CAPS_EXTENSION(EXT_texture_compression_latc),
+		CAPS_EXTENSION(EXT_transform_feedback),
+		CAPS_EXTENSION(EXT_direct_state_access),
+		CAPS_EXTENSION(EXT_texture_filter_anisotropic),
+		CAPS_EXTENSION(EXT_texture_compression_s3tc),
+		CAPS_EXTENSION(EXT_texture_array),
+		CAPS_EXTENSION(EXT_texture_snorm),
+		CAPS_EXTENSION(EXT_texture_sRGB_decode),
+		CAPS_EXTENSION(EXT_framebuffer_multisample_blit_scaled),
+		CAPS_EXTENSION(EXT_shader_integer_mix),
+		CAPS_EXTENSION(EXT_shader_image_load_formatted),
+		CAPS_EXTENSION(EXT_polygon_offset_clamp),
+		CAPS_EXTENSION(NV_explicit_multisample),
+		CAPS_EXTENSION(NV_shader_buffer_load),
+		CAPS_EXTENSION(NV_vertex_buffer_unified_memory),
+		CAPS_EXTENSION(NV_shader_buffer_store),
+		CAPS_EXTENSION(NV_bindless_multi_draw_indirect),
+		CAPS_EXTENSION(NV_blend_equation_advanced),
+		CAPS_EXTENSION(NV_deep_texture3D),
+		CAPS_EXTENSION(NV_shader_thread_group),
+		CAPS_EXTENSION(NV_shader_thread_shuffle),
+		CAPS_EXTENSION(NV_shader_atomic_int64),
+		CAPS_EXTENSION(NV_bindless_multi_draw_indirect_count),
+		CAPS_EXTENSION(NV_uniform_buffer_unified_memory),
+		CAPS_EXTENSION(ATI_texture_compression_3dc),
+		CAPS_EXTENSION(AMD_depth_clamp_separate),
+		CAPS_EXTENSION(AMD_stencil_operation_extended),
+		CAPS_EXTENSION(AMD_vertex_shader_viewport_index),
+		CAPS_EXTENSION(AMD_vertex_shader_layer),
+		CAPS_EXTENSION(AMD_shader_trinary_minmax),
+		CAPS_EXTENSION(AMD_interleaved_elements),
+		CAPS_EXTENSION(AMD_shader_atomic_counter_ops),
+		CAPS_EXTENSION(AMD_occlusion_query_event),
+		CAPS_EXTENSION(AMD_shader_stencil_value_export),
+		CAPS_EXTENSION(AMD_transform_feedback4),
+		CAPS_EXTENSION(AMD_gpu_shader_int64),
+		CAPS_EXTENSION(AMD_gcn_shader),
+		CAPS_EXTENSION(INTEL_map_texture),
+		CAPS_EXTENSION(INTEL_fragment_shader_ordering),
+		CAPS_EXTENSION(INTEL_performance_query)
+	};
+#	undef CAPS_EXTENSION
+
+	for(std::size_t i = 0; i < sizeof(Fields) / sizeof(Fields[0]); ++i)
+		this->ExtensionData.*Fields[i].Member = Registry.supported(Fields[i].Hash, Fields[i].Name);
 }
 
 void caps::initDebug()
@@ -1338,7 +856,21 @@ void caps::initFormats()
 	}
 }
 
+namespace
+{
+	extension_registry current_extensions()
+	{
+		extension_registry Registry;
+		Registry.init();
+		return Registry;
+	}
+}//namespace
+
 caps::caps(profile const & Profile) :
+	caps(Profile, current_extensions())
+{}
+
+caps::caps(profile const & Profile, extension_registry const & Registry) :
 	VersionData(Profile),
 	Version(VersionData),
 	Extensions(ExtensionData),
@@ -1348,7 +880,7 @@ caps::caps(profile const & Profile) :
 	Formats(FormatsData)
 {
 	this->initVersion();
-	this->initExtensions();
+	this->initExtensions(Registry);
 
 	if(this->check(4, 3) || Extensions.KHR_debug)
 		glGetIntegerv(GL_CONTEXT_FLAGS, &VersionData.CONTEXT_FLAGS);
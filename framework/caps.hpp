@@ -1,6 +1,7 @@
 #pragma once
 
 #include "test.hpp"
+#include "extensions.hpp"
 #include <string>
 
 struct caps
@@ -267,7 +268,7 @@ private:
 		bool INTEL_performance_query;
 	} ExtensionData;
 
-	void initExtensions();
+	void initExtensions(extension_registry const & Registry);
 
 	struct debug
 	{
@@ -526,6 +527,8 @@ private:
 
 public:
 	caps(profile const & Profile);
+	// Registry holds the extensions of the current context, framework::getExtensions()
+	caps(profile const & Profile, extension_registry const & Registry);
 
 	version const & Version;
 	extensions const & Extensions;
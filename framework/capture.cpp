@@ -0,0 +1,205 @@
+#include "capture.hpp"
+#include <cassert>
+
+capture::capture() :
+	Mode(CAPTURE_CLIENT),
+	ReadRGBA(false),
+	Issued(0),
+	Resolved(0),
+	Mapped(nullptr)
+{
+	for(std::size_t SlotIndex = 0; SlotIndex < this->Slots.size(); ++SlotIndex)
+	{
+		slot& Slot = this->Slots[SlotIndex];
+		Slot.Buffer = 0;
+		Slot.Fence = 0;
+		Slot.Persistent = nullptr;
+		Slot.Capacity = 0;
+		Slot.Size = glm::uvec2(0);
+		Slot.Index = 0;
+	}
+}
+
+void capture::init(mode Mode, bool ReadRGBA)
+{
+	this->release();
+	this->Mode = Mode;
+	this->ReadRGBA = ReadRGBA;
+}
+
+void capture::release()
+{
+	this->unmap();
+
+	for(std::size_t SlotIndex = 0; SlotIndex < this->Slots.size(); ++SlotIndex)
+	{
+		slot& Slot = this->Slots[SlotIndex];
+		if(Slot.Fence)
+			glDeleteSync(Slot.Fence);
+		if(Slot.Buffer)
+		{
+			if(Slot.Persistent)
+			{
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, Slot.Buffer);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			}
+			glDeleteBuffers(1, &Slot.Buffer);
+		}
+		Slot.Buffer = 0;
+		Slot.Fence = 0;
+		Slot.Persistent = nullptr;
+		Slot.Capacity = 0;
+		Slot.Client.clear();
+	}
+
+	this->Issued = 0;
+	this->Resolved = 0;
+}
+
+void capture::unmap()
+{
+	if(!this->Mapped)
+		return;
+
+	GLint PackBuffer = 0;
+	glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &PackBuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, this->Mapped->Buffer);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(PackBuffer));
+	this->Mapped = nullptr;
+}
+
+void capture::read(glm::uvec2 const & Size, std::size_t Index)
+{
+	assert(!this->full());
+
+	this->unmap();
+
+	slot& Slot = this->Slots[this->Issued % CAPTURE_SLOT_COUNT];
+	Slot.Size = Size;
+	Slot.Index = Index;
+
+	GLenum const Format = this->ReadRGBA ? GL_RGBA : GL_RGB;
+	std::size_t const ByteSize = static_cast<std::size_t>(Size.x) * Size.y * (this->ReadRGBA ? 4 : 3);
+	GLsizei const Width = static_cast<GLsizei>(Size.x);
+	GLsizei const Height = static_cast<GLsizei>(Size.y);
+
+	// Rows tightly packed, in the layout of the comparison
+	GLint PackAlignment = 4;
+	glGetIntegerv(GL_PACK_ALIGNMENT, &PackAlignment);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	if(this->Mode == CAPTURE_CLIENT)
+	{
+		Slot.Client.resize(ByteSize);
+		glReadPixels(0, 0, Width, Height, Format, GL_UNSIGNED_BYTE, &Slot.Client[0]);
+	}
+	else
+	{
+		GLint PackBuffer = 0;
+		glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &PackBuffer);
+
+		if(Slot.Capacity < ByteSize)
+		{
+			if(Slot.Buffer)
+			{
+				if(Slot.Persistent)
+				{
+					glBindBuffer(GL_PIXEL_PACK_BUFFER, Slot.Buffer);
+					glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				}
+				glDeleteBuffers(1, &Slot.Buffer);
+			}
+
+			glGenBuffers(1, &Slot.Buffer);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, Slot.Buffer);
+			if(this->Mode == CAPTURE_PERSISTENT)
+			{
+				GLbitfield const Access = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glBufferStorage(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(ByteSize), nullptr, Access | GL_CLIENT_STORAGE_BIT);
+				Slot.Persistent = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(ByteSize), Access);
+			}
+			else
+				glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(ByteSize), nullptr, GL_STREAM_READ);
+			Slot.Capacity = ByteSize;
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, Slot.Buffer);
+		glReadPixels(0, 0, Width, Height, Format, GL_UNSIGNED_BYTE, nullptr);
+		Slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(PackBuffer));
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, PackAlignment);
+
+	++this->Issued;
+}
+
+capture::status capture::resolve(bool Wait, frame & Frame)
+{
+	if(this->empty())
+		return RESOLVE_PENDING;
+
+	this->unmap();
+
+	slot& Slot = this->Slots[this->Resolved % CAPTURE_SLOT_COUNT];
+	std::size_t const TexelCount = static_cast<std::size_t>(Slot.Size.x) * Slot.Size.y;
+	std::uint8_t const* Data = nullptr;
+
+	if(this->Mode == CAPTURE_CLIENT)
+		Data = &Slot.Client[0];
+	else
+	{
+		// Only flush on the first wait so that polling doesn't force a submission each frame
+		GLenum Status = glClientWaitSync(Slot.Fence, Wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, 0);
+		while(Wait && Status == GL_TIMEOUT_EXPIRED)
+			Status = glClientWaitSync(Slot.Fence, 0, 1000000);
+		if(Status == GL_TIMEOUT_EXPIRED)
+			return RESOLVE_PENDING;
+
+		glDeleteSync(Slot.Fence);
+		Slot.Fence = 0;
+
+		if(Status == GL_WAIT_FAILED)
+			Data = nullptr;
+		else if(this->Mode == CAPTURE_PERSISTENT)
+			Data = static_cast<std::uint8_t const*>(Slot.Persistent);
+		else
+		{
+			GLint PackBuffer = 0;
+			glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &PackBuffer);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, Slot.Buffer);
+			Data = static_cast<std::uint8_t const*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(Slot.Capacity), GL_MAP_READ_BIT));
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(PackBuffer));
+			if(Data)
+				this->Mapped = &Slot;
+		}
+	}
+
+	++this->Resolved;
+
+	Frame.Index = Slot.Index;
+	Frame.Size = Slot.Size;
+	Frame.Data = nullptr;
+
+	if(!Data)
+		return RESOLVE_FAILED;
+
+	if(this->ReadRGBA)
+	{
+		this->Converted.resize(TexelCount * 3);
+		for(std::size_t TexelIndex = 0; TexelIndex < TexelCount; ++TexelIndex)
+		{
+			this->Converted[TexelIndex * 3 + 0] = Data[TexelIndex * 4 + 0];
+			this->Converted[TexelIndex * 3 + 1] = Data[TexelIndex * 4 + 1];
+			this->Converted[TexelIndex * 3 + 2] = Data[TexelIndex * 4 + 2];
+		}
+		Data = &this->Converted[0];
+	}
+
+	Frame.Data = Data;
+
+	return RESOLVE_READY;
+}
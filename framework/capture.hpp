@@ -0,0 +1,79 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Asynchronous framebuffer readback through a ring of pixel pack buffers and fences.
+// Frames are resolved frames later in the tightly packed RGB8 layout the template
+// comparison works on, directly from the mapped buffer when possible.
+class capture
+{
+public:
+	enum mode
+	{
+		CAPTURE_CLIENT,		// Synchronous glReadPixels in client memory, eg OpenGL ES 2.0
+		CAPTURE_MAP,		// Pixel pack buffers mapped once their fence is signaled
+		CAPTURE_PERSISTENT	// Pixel pack buffers persistently mapped, GL_ARB_buffer_storage
+	};
+
+	enum
+	{
+		CAPTURE_SLOT_COUNT = 3
+	};
+
+	enum status
+	{
+		RESOLVE_PENDING,	// Nothing to resolve, or the oldest readback isn't complete and Wait is false
+		RESOLVE_READY,
+		RESOLVE_FAILED		// The oldest readback failed, it is dropped and Frame.Data is null
+	};
+
+	struct frame
+	{
+		std::size_t Index;
+		glm::uvec2 Size;
+		std::uint8_t const* Data;
+	};
+
+	capture();
+
+	// Requires a current context. ReadRGBA for implementations only reading GL_RGBA, the alpha channel is dropped when resolving
+	void init(mode Mode, bool ReadRGBA);
+	void release();
+
+	// Queue a readback of the bound read framebuffer, Index identifies the frame when resolved
+	void read(glm::uvec2 const & Size, std::size_t Index);
+
+	// Retrieve the oldest readback, when Wait is false only if its fence is already signaled.
+	// Frame.Data remains valid until the next call to read, resolve or release.
+	status resolve(bool Wait, frame & Frame);
+
+	bool full() const{return this->Issued - this->Resolved == CAPTURE_SLOT_COUNT;}
+	bool empty() const{return this->Issued == this->Resolved;}
+
+private:
+	struct slot
+	{
+		GLuint Buffer;
+		GLsync Fence;
+		void* Persistent;
+		std::size_t Capacity;
+		std::vector<std::uint8_t> Client;
+		glm::uvec2 Size;
+		std::size_t Index;
+	};
+
+	void unmap();
+
+	mode Mode;
+	bool ReadRGBA;
+	std::array<slot, CAPTURE_SLOT_COUNT> Slots;
+	std::size_t Issued;
+	std::size_t Resolved;
+	slot* Mapped;
+	std::vector<std::uint8_t> Converted;
+};
@@ -0,0 +1,468 @@
+#include "compare.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__AVX2__)
+#	define OGL_SAMPLES_COMPARE_AVX2
+#	define OGL_SAMPLES_COMPARE_SSE2
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define OGL_SAMPLES_COMPARE_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace
+{
+	// Enough for a row of 9 texels of the neighbourhood plus padding
+	enum {WINDOW_SIZE = 32};
+
+#	if defined(OGL_SAMPLES_COMPARE_AVX2)
+		enum {CHUNK_SIZE = 32};
+#	elif defined(OGL_SAMPLES_COMPARE_SSE2)
+		enum {CHUNK_SIZE = 16};
+#	else
+		enum {CHUNK_SIZE = 1};
+#	endif
+
+	inline std::uint8_t absolute_difference(std::uint8_t A, std::uint8_t B)
+	{
+		return static_cast<std::uint8_t>(A > B ? A - B : B - A);
+	}
+
+#	if defined(OGL_SAMPLES_COMPARE_SSE2)
+		inline __m128i absolute_difference(__m128i A, __m128i B)
+		{
+			return _mm_or_si128(_mm_subs_epu8(A, B), _mm_subs_epu8(B, A));
+		}
+#	endif
+
+#	if defined(OGL_SAMPLES_COMPARE_AVX2)
+		inline __m256i absolute_difference(__m256i A, __m256i B)
+		{
+			return _mm256_or_si256(_mm256_subs_epu8(A, B), _mm256_subs_epu8(B, A));
+		}
+#	endif
+
+	// A chunk holds the absolute differences of CHUNK_SIZE bytes
+#	if defined(OGL_SAMPLES_COMPARE_AVX2)
+		typedef __m256i chunk;
+
+		inline chunk chunk_difference(std::uint8_t const* A, std::uint8_t const* B)
+		{
+			return absolute_difference(
+				_mm256_loadu_si256(reinterpret_cast<__m256i const*>(A)),
+				_mm256_loadu_si256(reinterpret_cast<__m256i const*>(B)));
+		}
+
+		inline chunk chunk_max(chunk A, chunk B)
+		{
+			return _mm256_max_epu8(A, B);
+		}
+
+		inline chunk chunk_zero()
+		{
+			return _mm256_setzero_si256();
+		}
+
+		// Bit i set when byte i exceeds Tolerance
+		inline std::uint32_t chunk_exceed(chunk Difference, std::uint8_t Tolerance)
+		{
+			__m256i const Exceed = _mm256_subs_epu8(Difference, _mm256_set1_epi8(static_cast<char>(Tolerance)));
+			return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Exceed, _mm256_setzero_si256())));
+		}
+
+		inline std::uint8_t chunk_reduce_max(chunk Difference)
+		{
+			std::uint8_t Lanes[32];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Lanes), Difference);
+			return *std::max_element(Lanes, Lanes + 32);
+		}
+#	elif defined(OGL_SAMPLES_COMPARE_SSE2)
+		typedef __m128i chunk;
+
+		inline chunk chunk_difference(std::uint8_t const* A, std::uint8_t const* B)
+		{
+			return absolute_difference(
+				_mm_loadu_si128(reinterpret_cast<__m128i const*>(A)),
+				_mm_loadu_si128(reinterpret_cast<__m128i const*>(B)));
+		}
+
+		inline chunk chunk_max(chunk A, chunk B)
+		{
+			return _mm_max_epu8(A, B);
+		}
+
+		inline chunk chunk_zero()
+		{
+			return _mm_setzero_si128();
+		}
+
+		inline std::uint32_t chunk_exceed(chunk Difference, std::uint8_t Tolerance)
+		{
+			__m128i const Exceed = _mm_subs_epu8(Difference, _mm_set1_epi8(static_cast<char>(Tolerance)));
+			return static_cast<std::uint32_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(Exceed, _mm_setzero_si128()))) & 0xFFFF;
+		}
+
+		inline std::uint8_t chunk_reduce_max(chunk Difference)
+		{
+			std::uint8_t Lanes[16];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Difference);
+			return *std::max_element(Lanes, Lanes + 16);
+		}
+#	else
+		typedef std::uint8_t chunk;
+
+		inline chunk chunk_difference(std::uint8_t const* A, std::uint8_t const* B)
+		{
+			return absolute_difference(*A, *B);
+		}
+
+		inline chunk chunk_max(chunk A, chunk B)
+		{
+			return std::max(A, B);
+		}
+
+		inline chunk chunk_zero()
+		{
+			return 0;
+		}
+
+		inline std::uint32_t chunk_exceed(chunk Difference, std::uint8_t Tolerance)
+		{
+			return Difference > Tolerance ? 1 : 0;
+		}
+
+		inline std::uint8_t chunk_reduce_max(chunk Difference)
+		{
+			return Difference;
+		}
+#	endif
+
+	// Bit i set when byte i of the WINDOW_SIZE bytes windows is within Tolerance
+	inline std::uint32_t window_match(std::uint8_t const* Window, std::uint8_t const* Pattern, std::uint8_t Tolerance)
+	{
+		std::uint32_t Exceed = 0;
+		for(int Offset = 0; Offset < WINDOW_SIZE; Offset += CHUNK_SIZE)
+			Exceed |= chunk_exceed(chunk_difference(Window + Offset, Pattern + Offset), Tolerance) << Offset;
+		return ~Exceed;
+	}
+
+	// Looks for a texel of B within Tolerance of TexelA in the neighbourhood of (X, Y), one window per kernel row
+	bool neighbourhood_match(std::uint8_t const* TexelA, std::uint8_t const* B, int Width, int Height, int X, int Y, int KernelSize, std::uint8_t Tolerance)
+	{
+		int const Radius = KernelSize / 2;
+
+		std::uint8_t Pattern[WINDOW_SIZE] = {0};
+		std::uint8_t Window[WINDOW_SIZE] = {0};
+		for(int KernelIndex = 0; KernelIndex < KernelSize; ++KernelIndex)
+			std::memcpy(Pattern + KernelIndex * 3, TexelA, 3);
+
+		// Bits 0, 3, 6... flag the first channel of each texel of the window
+		std::uint32_t TexelBits = 0;
+		for(int KernelIndex = 0; KernelIndex < KernelSize; ++KernelIndex)
+			TexelBits |= 1u << (KernelIndex * 3);
+
+		bool const Interior = X - Radius >= 0 && X + Radius < Width;
+
+		for(int KernelIndexY = -Radius; KernelIndexY <= Radius; ++KernelIndexY)
+		{
+			std::uint8_t const* RowB = B + static_cast<std::size_t>(std::min(std::max(Y + KernelIndexY, 0), Height - 1)) * Width * 3;
+
+			if(Interior)
+				std::memcpy(Window, RowB + (X - Radius) * 3, KernelSize * 3);
+			else for(int KernelIndexX = -Radius; KernelIndexX <= Radius; ++KernelIndexX)
+				std::memcpy(Window + (KernelIndexX + Radius) * 3, RowB + std::min(std::max(X + KernelIndexX, 0), Width - 1) * 3, 3);
+
+			// A texel matches when its three channel bits are set
+			std::uint32_t const Match = window_match(Window, Pattern, Tolerance);
+			if(Match & (Match >> 1) & (Match >> 2) & TexelBits)
+				return true;
+		}
+
+		return false;
+	}
+
+	void reset_kernels(rgb8::kernel* Kernels, std::size_t KernelCount)
+	{
+		assert(KernelCount <= rgb8::MAX_KERNEL_COUNT);
+		for(std::size_t KernelIndex = 0; KernelIndex < KernelCount; ++KernelIndex)
+		{
+			assert(Kernels[KernelIndex].Size > 0 && Kernels[KernelIndex].Size % 2 == 1 && Kernels[KernelIndex].Size * 3 <= WINDOW_SIZE);
+			Kernels[KernelIndex].Pass = true;
+		}
+	}
+
+	// Measures the texels [BeginX, EndX) x [BeginY, EndY), the neighbourhoods extend to the whole images
+	chunk measure_region(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height,
+		std::size_t BeginX, std::size_t EndX, std::size_t BeginY, std::size_t EndY, rgb8::kernel* Kernels, std::size_t KernelCount, chunk Max)
+	{
+		std::size_t const RowSize = Width * 3;
+		std::size_t const RegionBegin = BeginX * 3;
+		std::size_t const RegionEnd = EndX * 3;
+		std::size_t LastTexels[rgb8::MAX_KERNEL_COUNT];
+
+		for(std::size_t TexelIndexY = BeginY; TexelIndexY < EndY; ++TexelIndexY)
+		{
+			std::uint8_t const* RowA = A + TexelIndexY * RowSize;
+			std::uint8_t const* RowB = B + TexelIndexY * RowSize;
+
+			std::fill(LastTexels, LastTexels + rgb8::MAX_KERNEL_COUNT, static_cast<std::size_t>(-1));
+
+			for(std::size_t Offset = RegionBegin; Offset < RegionEnd; Offset += CHUNK_SIZE)
+			{
+				chunk Difference;
+				if(Offset + CHUNK_SIZE <= RegionEnd)
+					Difference = chunk_difference(RowA + Offset, RowB + Offset);
+				else
+				{
+					// Pad the end of the region with equal bytes
+					std::uint8_t TailA[CHUNK_SIZE] = {0};
+					std::uint8_t TailB[CHUNK_SIZE] = {0};
+					std::memcpy(TailA, RowA + Offset, RegionEnd - Offset);
+					std::memcpy(TailB, RowB + Offset, RegionEnd - Offset);
+					Difference = chunk_difference(TailA, TailB);
+				}
+				Max = chunk_max(Max, Difference);
+
+				// Most texels match, only the ones exceeding the tolerance need a neighbourhood search
+				for(std::size_t KernelIndex = 0; KernelIndex < KernelCount; ++KernelIndex)
+				{
+					rgb8::kernel& Kernel = Kernels[KernelIndex];
+					if(!Kernel.Pass)
+						continue;
+
+					std::uint32_t Exceed = chunk_exceed(Difference, Kernel.Tolerance);
+					for(std::size_t ByteIndex = 0; Exceed && Kernel.Pass; ++ByteIndex, Exceed >>= 1)
+					{
+						if(!(Exceed & 1))
+							continue;
+
+						std::size_t const TexelIndexX = (Offset + ByteIndex) / 3;
+						if(TexelIndexX == LastTexels[KernelIndex])
+							continue;
+						LastTexels[KernelIndex] = TexelIndexX;
+
+						Kernel.Pass = neighbourhood_match(RowA + TexelIndexX * 3, B, static_cast<int>(Width), static_cast<int>(Height),
+							static_cast<int>(TexelIndexX), static_cast<int>(TexelIndexY), Kernel.Size, Kernel.Tolerance);
+					}
+				}
+			}
+		}
+
+		return Max;
+	}
+
+
+	// Bytes of a tile row
+	std::size_t const SEGMENT_SIZE = rgb8::TILE_SIZE * 3;
+
+	std::uint64_t const TILE_HASH_SEED = 2870177450012600261ull;
+
+	inline std::uint64_t load64(std::uint8_t const* Data)
+	{
+		std::uint64_t Value;
+		std::memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	// xxHash64 steps
+	inline std::uint64_t hash_segment(std::uint64_t Hash, std::uint8_t const* Segment)
+	{
+		for(std::size_t Offset = 0; Offset < SEGMENT_SIZE; Offset += 8)
+		{
+			std::uint64_t Value = load64(Segment + Offset) * 14029467366897019727ull;
+			Value = ((Value << 31) | (Value >> 33)) * 11400714785074694791ull;
+			Hash ^= Value;
+			Hash = ((Hash << 27) | (Hash >> 37)) * 11400714785074694791ull + 9650029242287828579ull;
+		}
+		return Hash;
+	}
+
+	inline std::uint64_t avalanche(std::uint64_t Hash)
+	{
+		Hash ^= Hash >> 33;
+		Hash *= 14029467366897019727ull;
+		Hash ^= Hash >> 29;
+		Hash *= 1609587929392839161ull;
+		Hash ^= Hash >> 32;
+		return Hash;
+	}
+}//namespace
+
+namespace rgb8
+{
+	void absolute_difference(std::uint8_t const* A, std::uint8_t const* B, std::uint8_t* Result, std::size_t Size, std::uint8_t Scale)
+	{
+		std::size_t Offset = 0;
+
+#		if defined(OGL_SAMPLES_COMPARE_AVX2)
+			__m256i const Scale256 = _mm256_set1_epi16(Scale);
+			__m256i const LowByte256 = _mm256_set1_epi16(0x00FF);
+			for(; Offset + 32 <= Size; Offset += 32)
+			{
+				__m256i Diff = ::absolute_difference(
+					_mm256_loadu_si256(reinterpret_cast<__m256i const*>(A + Offset)),
+					_mm256_loadu_si256(reinterpret_cast<__m256i const*>(B + Offset)));
+				if(Scale != 1)
+				{
+					__m256i const Low = _mm256_and_si256(_mm256_mullo_epi16(_mm256_unpacklo_epi8(Diff, _mm256_setzero_si256()), Scale256), LowByte256);
+					__m256i const High = _mm256_and_si256(_mm256_mullo_epi16(_mm256_unpackhi_epi8(Diff, _mm256_setzero_si256()), Scale256), LowByte256);
+					Diff = _mm256_packus_epi16(Low, High);
+				}
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(Result + Offset), Diff);
+			}
+#		endif
+
+#		if defined(OGL_SAMPLES_COMPARE_SSE2)
+			__m128i const Scale128 = _mm_set1_epi16(Scale);
+			__m128i const LowByte128 = _mm_set1_epi16(0x00FF);
+			for(; Offset + 16 <= Size; Offset += 16)
+			{
+				__m128i Diff = ::absolute_difference(
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(A + Offset)),
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(B + Offset)));
+				if(Scale != 1)
+				{
+					__m128i const Low = _mm_and_si128(_mm_mullo_epi16(_mm_unpacklo_epi8(Diff, _mm_setzero_si128()), Scale128), LowByte128);
+					__m128i const High = _mm_and_si128(_mm_mullo_epi16(_mm_unpackhi_epi8(Diff, _mm_setzero_si128()), Scale128), LowByte128);
+					Diff = _mm_packus_epi16(Low, High);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Result + Offset), Diff);
+			}
+#		endif
+
+		for(; Offset < Size; ++Offset)
+			Result[Offset] = static_cast<std::uint8_t>(::absolute_difference(A[Offset], B[Offset]) * Scale);
+	}
+
+	void count_differences(std::uint8_t const* A, std::uint8_t const* B, std::size_t TexelCount, std::size_t Counts[3])
+	{
+		std::size_t const Size = TexelCount * 3;
+		std::size_t Offset = 0;
+		Counts[0] = Counts[1] = Counts[2] = 0;
+
+#		if defined(OGL_SAMPLES_COMPARE_SSE2)
+			// 48 bytes hold 16 whole texels: Channels[c][i] is 1 when byte i belongs to channel c
+			std::uint8_t Channels[3][48];
+			for(int ByteIndex = 0; ByteIndex < 48; ++ByteIndex)
+			for(int ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex)
+				Channels[ChannelIndex][ByteIndex] = ByteIndex % 3 == ChannelIndex ? 1 : 0;
+
+			__m128i Sums[3] = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+			for(; Offset + 48 <= Size; Offset += 48)
+			for(int VectorIndex = 0; VectorIndex < 3; ++VectorIndex)
+			{
+				__m128i const Equal = _mm_cmpeq_epi8(
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(A + Offset + VectorIndex * 16)),
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(B + Offset + VectorIndex * 16)));
+
+				for(int ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex)
+				{
+					__m128i const Channel = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Channels[ChannelIndex] + VectorIndex * 16));
+					Sums[ChannelIndex] = _mm_add_epi64(Sums[ChannelIndex], _mm_sad_epu8(_mm_andnot_si128(Equal, Channel), _mm_setzero_si128()));
+				}
+			}
+
+			for(int ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex)
+			{
+				std::uint64_t Lanes[2];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Sums[ChannelIndex]);
+				Counts[ChannelIndex] = static_cast<std::size_t>(Lanes[0] + Lanes[1]);
+			}
+#		endif
+
+		for(; Offset < Size; ++Offset)
+			if(A[Offset] != B[Offset])
+				++Counts[Offset % 3];
+	}
+
+	std::uint8_t measure(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, kernel* Kernels, std::size_t KernelCount)
+	{
+		reset_kernels(Kernels, KernelCount);
+		return chunk_reduce_max(measure_region(A, B, Width, Height, 0, Width, 0, Height, Kernels, KernelCount, chunk_zero()));
+	}
+
+	std::uint8_t measure_tiles(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, std::uint8_t const* Mismatch, kernel* Kernels, std::size_t KernelCount)
+	{
+		reset_kernels(Kernels, KernelCount);
+
+		std::size_t const TileCountX = tile_count(Width);
+		std::size_t const TileCountY = tile_count(Height);
+		chunk Max = chunk_zero();
+		for(std::size_t TileIndexY = 0; TileIndexY < TileCountY; ++TileIndexY)
+		for(std::size_t TileIndexX = 0; TileIndexX < TileCountX; ++TileIndexX)
+		{
+			if(!Mismatch[TileIndexY * TileCountX + TileIndexX])
+				continue;
+
+			Max = measure_region(A, B, Width, Height,
+				TileIndexX * TILE_SIZE, std::min((TileIndexX + 1) * TILE_SIZE, Width),
+				TileIndexY * TILE_SIZE, std::min((TileIndexY + 1) * TILE_SIZE, Height),
+				Kernels, KernelCount, Max);
+		}
+
+		return chunk_reduce_max(Max);
+	}
+
+	void tile_hashes(std::uint8_t const* Data, std::size_t Width, std::size_t Height, std::uint64_t* Hashes)
+	{
+		std::size_t const TileCountX = tile_count(Width);
+		std::size_t const TileCountY = tile_count(Height);
+		std::size_t const RowSize = Width * 3;
+
+		for(std::size_t TileIndexY = 0; TileIndexY < TileCountY; ++TileIndexY)
+		{
+			std::uint64_t* const TileRow = Hashes + TileIndexY * TileCountX;
+			std::fill(TileRow, TileRow + TileCountX, TILE_HASH_SEED);
+
+			// Row by row, the chains of the tiles of a row are independent so their multiplications overlap
+			std::size_t const EndY = std::min((TileIndexY + 1) * TILE_SIZE, Height);
+			for(std::size_t TexelIndexY = TileIndexY * TILE_SIZE; TexelIndexY < EndY; ++TexelIndexY)
+			{
+				std::uint8_t const* Row = Data + TexelIndexY * RowSize;
+
+				std::size_t TileIndexX = 0;
+				for(; (TileIndexX + 1) * SEGMENT_SIZE <= RowSize; ++TileIndexX)
+					TileRow[TileIndexX] = hash_segment(TileRow[TileIndexX], Row + TileIndexX * SEGMENT_SIZE);
+
+				// Partial tile at the end of the row, padded with zeros
+				if(TileIndexX < TileCountX)
+				{
+					std::uint8_t Tail[SEGMENT_SIZE] = {0};
+					std::memcpy(Tail, Row + TileIndexX * SEGMENT_SIZE, RowSize - TileIndexX * SEGMENT_SIZE);
+					TileRow[TileIndexX] = hash_segment(TileRow[TileIndexX], Tail);
+				}
+			}
+
+			for(std::size_t TileIndexX = 0; TileIndexX < TileCountX; ++TileIndexX)
+				TileRow[TileIndexX] = avalanche(TileRow[TileIndexX]);
+		}
+	}
+
+	std::uint8_t max_absolute_difference(std::uint8_t const* A, std::uint8_t const* B, std::size_t Size)
+	{
+		assert(Size % 3 == 0);
+		return measure(A, B, Size / 3, 1, nullptr, 0);
+	}
+
+	bool kernel_tolerance(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, int KernelSize, std::uint8_t Tolerance)
+	{
+		kernel Kernel = {KernelSize, Tolerance, false};
+		measure(A, B, Width, Height, &Kernel, 1);
+		return Kernel.Pass;
+	}
+
+	bool channel_tolerance(std::uint8_t const* A, std::uint8_t const* B, std::size_t TexelCount, std::uint8_t MaxTolerance, std::uint8_t MinTolerance)
+	{
+		for(std::size_t TexelIndex = 0; TexelIndex < TexelCount; ++TexelIndex)
+		{
+			std::uint8_t const Red = ::absolute_difference(A[TexelIndex * 3 + 0], B[TexelIndex * 3 + 0]);
+			std::uint8_t const Green = ::absolute_difference(A[TexelIndex * 3 + 1], B[TexelIndex * 3 + 1]);
+			std::uint8_t const Blue = ::absolute_difference(A[TexelIndex * 3 + 2], B[TexelIndex * 3 + 2]);
+			if(std::max(std::max(Red, Green), Blue) > MaxTolerance || std::min(std::min(Red, Green), Blue) > MinTolerance)
+				return false;
+		}
+		return true;
+	}
+}//namespace rgb8
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Template comparison kernels on tightly packed RGB8 images.
+// They are vectorized with AVX2 or SSE2 when the compiler targets them and
+// return the same results as the scalar fallback.
+namespace rgb8
+{
+	// Result[i] = |A[i] - B[i]| * Scale, modulo 256 like glm::u8vec3 arithmetic
+	void absolute_difference(std::uint8_t const* A, std::uint8_t const* B, std::uint8_t* Result, std::size_t Size, std::uint8_t Scale);
+
+	// Largest |A[i] - B[i]| over all channels
+	std::uint8_t max_absolute_difference(std::uint8_t const* A, std::uint8_t const* B, std::size_t Size);
+
+	// Number of texels whose red, green and blue channels differ
+	void count_differences(std::uint8_t const* A, std::uint8_t const* B, std::size_t TexelCount, std::size_t Counts[3]);
+
+	enum {MAX_KERNEL_COUNT = 4};
+
+	// Neighbourhood tolerance criterion, see kernel_tolerance
+	struct kernel
+	{
+		int Size;
+		std::uint8_t Tolerance;
+		bool Pass;
+	};
+
+	// Single streaming pass over both images evaluating up to MAX_KERNEL_COUNT kernels together.
+	// A kernel stops being evaluated once it fails. Returns the largest difference.
+	std::uint8_t measure(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, kernel* Kernels, std::size_t KernelCount);
+
+	enum {TILE_SIZE = 16};
+
+	// Number of tiles covering Size texels, the last one may be partial
+	inline std::size_t tile_count(std::size_t Size)
+	{
+		return (Size + TILE_SIZE - 1) / TILE_SIZE;
+	}
+
+	// 64 bits hash of each TILE_SIZE x TILE_SIZE tile, Hashes holds tile_count(Width) * tile_count(Height) values, row major.
+	// Equal tiles of two images of the same size have the same hash.
+	void tile_hashes(std::uint8_t const* Data, std::size_t Width, std::size_t Height, std::uint64_t* Hashes);
+
+	// measure restricted to the tiles whose Mismatch entry isn't zero, the other tiles of A and B must be equal.
+	// The results are the ones of measure, the neighbourhoods of the kernels still extend over the whole images.
+	std::uint8_t measure_tiles(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, std::uint8_t const* Mismatch, kernel* Kernels, std::size_t KernelCount);
+
+	// Every texel of A whose difference with B exceeds Tolerance in a channel must
+	// match, within Tolerance on all channels, a texel of B in the KernelSize x KernelSize
+	// neighbourhood, coordinates clamped to the image. KernelSize is odd and at most 9.
+	bool kernel_tolerance(std::uint8_t const* A, std::uint8_t const* B, std::size_t Width, std::size_t Height, int KernelSize, std::uint8_t Tolerance);
+
+	// Every texel has its largest channel difference within MaxTolerance and its smallest within MinTolerance
+	bool channel_tolerance(std::uint8_t const* A, std::uint8_t const* B, std::size_t TexelCount, std::uint8_t MaxTolerance, std::uint8_t MinTolerance);
+}//namespace rgb8
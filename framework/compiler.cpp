@@ -17,6 +17,24 @@
 #include <sstream>
 #include <fstream>
 #include <cstdarg>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#	include <direct.h>
+#	include <process.h>
+#else
+#	include <sys/types.h>
+#	include <unistd.h>
+#endif
 
 std::string getDataDirectory();
 
@@ -92,24 +110,163 @@ std::string compiler::commandline::getDefines() const
 
 // compiler::parser
 
+namespace
+{
+	// Identifies a version of a file, Time is -1 when the file doesn't exist
+	struct stamp
+	{
+		long long Time;
+		long long Size;
+	};
+
+	bool operator==(stamp const & A, stamp const & B)
+	{
+		return A.Time == B.Time && A.Size == B.Size;
+	}
+
+	stamp get_stamp(std::string const & Filename)
+	{
+		stamp Stamp;
+		struct stat Status;
+		if(stat(Filename.c_str(), &Status) != 0)
+		{
+			Stamp.Time = -1;
+			Stamp.Size = 0;
+		}
+		else
+		{
+			Stamp.Time = static_cast<long long>(Status.st_mtime);
+			Stamp.Size = static_cast<long long>(Status.st_size);
+		}
+		return Stamp;
+	}
+
+	struct file
+	{
+		stamp Stamp;
+		std::string Text;
+	};
+
+	// A file the preprocessed text depends on, including the include paths probed without success
+	struct dependency
+	{
+		std::string Path;
+		stamp Stamp;
+	};
+
+	struct preprocessed
+	{
+		std::string Text;
+		std::vector<dependency> Dependencies;
+	};
+
+	// Process wide so that the samples of a batch run share the shaders and includes already preprocessed
+	struct source_cache
+	{
+		std::mutex Mutex;
+		std::map<std::string, file> Files;
+		std::map<std::string, preprocessed> Sources;
+	};
+
+	source_cache & get_source_cache()
+	{
+		static source_cache Cache;
+		return Cache;
+	}
+
+	// Content of a file, only loaded again when its stamp changed. Files are loaded outside of
+	// the lock so that worker threads preprocess in parallel.
+	std::string read_file(source_cache & Cache, std::string const & Filename, stamp const & Stamp)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Cache.Mutex);
+			std::map<std::string, file>::const_iterator Iterator = Cache.Files.find(Filename);
+			if(Iterator != Cache.Files.end() && Iterator->second.Stamp == Stamp)
+				return Iterator->second.Text;
+		}
+
+		file File;
+		File.Stamp = Stamp;
+		File.Text = load_file(Filename);
+
+		std::lock_guard<std::mutex> Lock(Cache.Mutex);
+		Cache.Files[Filename] = File;
+		return File.Text;
+	}
+
+	bool is_up_to_date(std::vector<dependency> const & Dependencies)
+	{
+		for(std::size_t i = 0; i < Dependencies.size(); ++i)
+			if(!(get_stamp(Dependencies[i].Path) == Dependencies[i].Stamp))
+				return false;
+		return true;
+	}
+
+	void add_dependency(std::vector<dependency> & Dependencies, std::string const & Path, stamp const & Stamp)
+	{
+		dependency Dependency;
+		Dependency.Path = Path;
+		Dependency.Stamp = Stamp;
+		Dependencies.push_back(Dependency);
+	}
+
+	// A piece of the preprocessed text, followed by a new line for source lines
+	struct span
+	{
+		char const* Data;
+		std::size_t Size;
+		bool NewLine;
+	};
+
+	void add_span(std::vector<span> & Spans, char const* Data, std::size_t Size, bool NewLine)
+	{
+		span Span;
+		Span.Data = Data;
+		Span.Size = Size;
+		Span.NewLine = NewLine;
+		Spans.push_back(Span);
+	}
+}//namespace
+
 std::string compiler::parser::operator()(commandline const & CommandLine, std::string const & Filename) const
 {
-	std::string Source = load_file(Filename);
-	assert(!Source.empty());
+	std::vector<std::string> const Includes = CommandLine.getIncludes();
+	std::string const Defines = CommandLine.getDefines();
 
-	std::stringstream Stream;
-	Stream << Source;
-	std::string Line, Text;
+	std::string Key = format("%s\n%d %s\n", Filename.c_str(), CommandLine.getVersion(), CommandLine.getProfile().c_str()) + Defines;
+	for(std::size_t i = 0; i < Includes.size(); ++i)
+		Key += Includes[i] + "\n";
 
-	// Handle command line version and profile arguments
-	if(CommandLine.getVersion() != -1)
-		Text += format("#version %d %s\n", CommandLine.getVersion(), CommandLine.getProfile().c_str());
+	source_cache & Cache = get_source_cache();
 
-	// Handle command line defines
-	Text += CommandLine.getDefines();
+	{
+		std::lock_guard<std::mutex> Lock(Cache.Mutex);
+		std::map<std::string, preprocessed>::const_iterator Cached = Cache.Sources.find(Key);
+		if(Cached != Cache.Sources.end() && is_up_to_date(Cached->second.Dependencies))
+			return Cached->second.Text;
+	}
+
+	preprocessed Result;
+
+	stamp const SourceStamp = get_stamp(Filename);
+	add_dependency(Result.Dependencies, Filename, SourceStamp);
+	std::string const Source = read_file(Cache, Filename, SourceStamp);
+	assert(!Source.empty());
+
+	// Gather the pieces of the text first so that it is built in a single allocation
+	std::deque<std::string> IncludeSources;
+	std::vector<span> Versions;
+	std::vector<span> Spans;
 
-	while(std::getline(Stream, Line))
+	for(std::size_t LineBegin = 0; LineBegin < Source.size();)
 	{
+		std::size_t LineEnd = Source.find('\n', LineBegin);
+		if(LineEnd == std::string::npos)
+			LineEnd = Source.size();
+		std::string const Line = Source.substr(LineBegin, LineEnd - LineBegin);
+		char const* LineData = Source.data() + LineBegin;
+		LineBegin = LineEnd + 1;
+
 		std::size_t Offset = 0;
 
 		// Version
@@ -122,7 +279,7 @@ std::string compiler::parser::operator()(commandline const & CommandLine, std::s
 
 			// Reorder so that the #version line is always the first of a shader text
 			if(CommandLine.getVersion() == -1)
-				Text = Line + std::string("\n") + Text;
+				add_span(Versions, LineData, Line.size(), true);
 			// else skip is version is only mentionned
 			continue;
 		}
@@ -137,27 +294,62 @@ std::string compiler::parser::operator()(commandline const & CommandLine, std::s
 
 			std::string Include = parseInclude(Line, Offset);
 
-			std::vector<std::string> Includes = CommandLine.getIncludes();
-
 			for(std::size_t i = 0; i < Includes.size(); ++i)
 			{
 				std::string PathName = Includes[i] + Include;
-				std::string IncludeSource = load_file(PathName);
-				if (!IncludeSource.empty())
+				stamp const IncludeStamp = get_stamp(PathName);
+				add_dependency(Result.Dependencies, PathName, IncludeStamp);
+				if(IncludeStamp.Time == -1)
+					continue;
+
+				IncludeSources.push_back(read_file(Cache, PathName, IncludeStamp));
+				std::string const & IncludeSource = IncludeSources.back();
+				if(!IncludeSource.empty())
 				{
-					Text += IncludeSource;
+					add_span(Spans, IncludeSource.data(), IncludeSource.size(), false);
 					break;
 				}
 			}
 
 			continue;
-		} 
+		}
 
-		Text += Line + "\n";
+		add_span(Spans, LineData, Line.size(), true);
+	}
+
+	// Handle command line version and profile arguments
+	std::string const Version = CommandLine.getVersion() != -1 ? format("#version %d %s\n", CommandLine.getVersion(), CommandLine.getProfile().c_str()) : std::string();
+
+	std::size_t Size = Version.size() + Defines.size();
+	for(std::size_t i = 0; i < Versions.size(); ++i)
+		Size += Versions[i].Size + 1;
+	for(std::size_t i = 0; i < Spans.size(); ++i)
+		Size += Spans[i].Size + (Spans[i].NewLine ? 1 : 0);
+
+	std::string & Text = Result.Text;
+	Text.clear();
+	Text.reserve(Size);
+
+	// The last #version line of the source comes first, as when each was moved in front of the text
+	for(std::size_t i = Versions.size(); i > 0; --i)
+		Text.append(Versions[i - 1].Data, Versions[i - 1].Size).push_back('\n');
+	Text += Version;
+
+	// Handle command line defines
+	Text += Defines;
+
+	for(std::size_t i = 0; i < Spans.size(); ++i)
+	{
+		Text.append(Spans[i].Data, Spans[i].Size);
+		if(Spans[i].NewLine)
+			Text.push_back('\n');
 	}
 
 	//Text += glf::format("\nconst float G_TRUC_GNI = %f;\n", glm::linearRand(0.0f, 1.0f));
 
+	std::lock_guard<std::mutex> Lock(Cache.Mutex);
+	Cache.Sources[Key] = Result;
+
 	return Text;
 }
 
@@ -172,26 +364,269 @@ std::string compiler::parser::parseInclude(std::string const & Line, std::size_t
 }
 
 // compiler
+
+namespace
+{
+	// FNV-1a
+	glm::uint64 hash(void const* Data, std::size_t Size, glm::uint64 Seed)
+	{
+		glm::uint8 const* Bytes = static_cast<glm::uint8 const*>(Data);
+		glm::uint64 Result = Seed;
+		for(std::size_t i = 0; i < Size; ++i)
+			Result = (Result ^ Bytes[i]) * 1099511628211ull;
+		return Result;
+	}
+
+	glm::uint64 hash(char const* String, glm::uint64 Seed)
+	{
+		return String ? hash(String, std::strlen(String) + 1, Seed) : Seed;
+	}
+
+	glm::uint64 const HASH_SEED = 14695981039346656037ull;
+
+	char const PROGRAM_BINARY_MAGIC[8] = {'O', 'G', 'L', 'P', 'R', 'O', 'G', '1'};
+
+	bool has_program_cache()
+	{
+#		if defined(OGL_SAMPLES_PROGRAM_CACHE)
+			if(!glGetProgramBinary || !glProgramBinary || !glProgramParameteri)
+				return false;
+
+			GLint FormatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatCount);
+			return FormatCount > 0;
+#		else
+			return false;
+#		endif
+	}
+
+	std::vector<GLint> get_program_binary_formats()
+	{
+		GLint FormatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatCount);
+		std::vector<GLint> Formats(static_cast<std::size_t>(glm::max(FormatCount, 0)));
+		if(!Formats.empty())
+			glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, &Formats[0]);
+		return Formats;
+	}
+
+	// GL_PROGRAM_SEPARABLE is only a valid query from OpenGL 4.1 and OpenGL ES 3.1
+	bool has_separable_programs()
+	{
+		int Major = 0, Minor = 0;
+		char const* Version = reinterpret_cast<char const*>(glGetString(GL_VERSION));
+		if(Version && std::sscanf(Version, "OpenGL ES %d.%d", &Major, &Minor) == 2)
+			return Major > 3 || (Major == 3 && Minor >= 1);
+		return GLEW_VERSION_4_1 || GLEW_ARB_separate_shader_objects;
+	}
+
+	enum
+	{
+		COMPLETION_POLL_MS = 1,
+		COMPLETION_TIMEOUT_MS = 1000
+	};
+
+	bool has_parallel_compile()
+	{
+		return GLEW_ARB_parallel_shader_compile || GLEW_KHR_parallel_shader_compile;
+	}
+
+	// Order the shaders as the driver threads complete them, polling GL_COMPLETION_STATUS with a sleep between the
+	// polls. Shaders still compiling at the deadline come last, their status queries block in the driver.
+	std::vector<GLuint> order_by_completion(std::vector<GLuint> Pending)
+	{
+		if(!has_parallel_compile())
+			return Pending;
+
+		std::vector<GLuint> Completed;
+		Completed.reserve(Pending.size());
+
+		std::chrono::steady_clock::time_point const Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(COMPLETION_TIMEOUT_MS);
+		for(;;)
+		{
+			std::size_t PendingCount = 0;
+			for(std::size_t i = 0; i < Pending.size(); ++i)
+			{
+				GLint Status = GL_TRUE;
+				glGetShaderiv(Pending[i], GL_COMPLETION_STATUS_ARB, &Status);
+				if(Status == GL_TRUE)
+					Completed.push_back(Pending[i]);
+				else
+					Pending[PendingCount++] = Pending[i];
+			}
+			Pending.resize(PendingCount);
+
+			if(Pending.empty() || std::chrono::steady_clock::now() >= Deadline)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(COMPLETION_POLL_MS));
+		}
+
+		Completed.insert(Completed.end(), Pending.begin(), Pending.end());
+		return Completed;
+	}
+
+	// Prints the info log of a shader that failed to compile
+	bool check_shader(GLuint ShaderName)
+	{
+		GLint Result = GL_FALSE;
+		glGetShaderiv(ShaderName, GL_COMPILE_STATUS, &Result);
+
+		if(Result == GL_TRUE)
+			return true;
+
+		int InfoLogLength;
+		glGetShaderiv(ShaderName, GL_INFO_LOG_LENGTH, &InfoLogLength);
+		if(InfoLogLength > 0)
+		{
+			std::vector<char> Buffer(InfoLogLength);
+			glGetShaderInfoLog(ShaderName, InfoLogLength, NULL, &Buffer[0]);
+			fprintf(stdout, "%s\n", &Buffer[0]);
+		}
+
+		return false;
+	}
+
+	std::vector<GLuint> get_attached_shaders(GLuint ProgramName)
+	{
+		GLint ShaderCount = 0;
+		glGetProgramiv(ProgramName, GL_ATTACHED_SHADERS, &ShaderCount);
+
+		std::vector<GLuint> ShaderNames(static_cast<std::size_t>(glm::max(ShaderCount, 0)));
+		if(!ShaderNames.empty())
+			glGetAttachedShaders(ProgramName, ShaderCount, NULL, &ShaderNames[0]);
+		return ShaderNames;
+	}
+
+	// Shared by the samples and the batch workers, whatever their binary directory
+	std::string get_program_cache_directory()
+	{
+		static std::string const Directory(std::string(OGL_SAMPLES_BINARY_DIR) + "/program-cache/");
+		static bool const Created = make_directory(Directory);
+		(void)Created;
+		return Directory;
+	}
+
+	std::string get_program_binary_path(glm::uint64 Key)
+	{
+		return get_program_cache_directory() + format("%016llx.bin", static_cast<unsigned long long>(Key));
+	}
+
+	int get_process_id()
+	{
+#		if defined(_WIN32)
+			return _getpid();
+#		else
+			return static_cast<int>(getpid());
+#		endif
+	}
+
+	bool load_program_binary(std::string const & Filename, glm::uint64 Key, GLenum & Format, std::vector<glm::uint8> & Data)
+	{
+		FILE* File = fopen(Filename.c_str(), "rb");
+		if(!File)
+			return false;
+
+		char Magic[sizeof(PROGRAM_BINARY_MAGIC)];
+		glm::uint64 FileKey = 0;
+		GLint Size = 0;
+
+		bool Success =
+			fread(Magic, sizeof(Magic), 1, File) == 1 &&
+			std::memcmp(Magic, PROGRAM_BINARY_MAGIC, sizeof(Magic)) == 0 &&
+			fread(&FileKey, sizeof(FileKey), 1, File) == 1 && FileKey == Key &&
+			fread(&Format, sizeof(Format), 1, File) == 1 &&
+			fread(&Size, sizeof(Size), 1, File) == 1 && Size > 0;
+
+		if(Success)
+		{
+			Data.resize(static_cast<std::size_t>(Size));
+			Success = fread(&Data[0], Data.size(), 1, File) == 1;
+		}
+
+		fclose(File);
+		return Success;
+	}
+
+	// Written next to its destination then renamed, so that concurrent workers never read a partial file
+	bool save_program_binary(std::string const & Filename, glm::uint64 Key, GLenum Format, std::vector<glm::uint8> const & Data)
+	{
+		std::string const Temporary = Filename + format(".%d.tmp", get_process_id());
+
+		FILE* File = fopen(Temporary.c_str(), "wb");
+		if(!File)
+			return false;
+
+		GLint const Size = static_cast<GLint>(Data.size());
+		bool Success =
+			fwrite(PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC), 1, File) == 1 &&
+			fwrite(&Key, sizeof(Key), 1, File) == 1 &&
+			fwrite(&Format, sizeof(Format), 1, File) == 1 &&
+			fwrite(&Size, sizeof(Size), 1, File) == 1 &&
+			fwrite(&Data[0], Data.size(), 1, File) == 1;
+		Success = fclose(File) == 0 && Success;
+
+		// On Windows rename fails when another worker already stored the same program
+		if(Success && std::rename(Temporary.c_str(), Filename.c_str()) == 0)
+			return true;
+
+		std::remove(Temporary.c_str());
+		return false;
+	}
+}//namespace
+
+compiler::compiler(mode Mode) :
+	Mode(Mode)
+{}
+
 compiler::~compiler()
 {
 	this->clear();
 }
 
-GLuint compiler::create(GLenum Type, std::string const & Filename, std::string const & Arguments)
+std::string compiler::preprocess(std::string const & Filename, std::string const & Arguments)
 {
 	assert(!Filename.empty());
-	
+
 	commandline CommandLine(Filename, Arguments);
+	return parser()(CommandLine, Filename);
+}
+
+GLuint compiler::create(GLenum Type, std::string const & Filename, std::string const & Arguments)
+{
+	return this->submit(Type, Filename, preprocess(Filename, Arguments));
+}
 
-	std::string PreprocessedSource = parser()(CommandLine, Filename);
+std::vector<GLuint> compiler::create(std::vector<source> const & Sources)
+{
+	std::vector<std::future<std::string> > PreprocessedSources(Sources.size());
+	for(std::size_t i = 0; i < Sources.size(); ++i)
+		PreprocessedSources[i] = std::async(std::launch::async, &compiler::preprocess, Sources[i].Filename, Sources[i].Arguments);
+
+	// With parallel shader compile the driver compiles the first shaders while the others are still preprocessed
+	std::vector<GLuint> Names(Sources.size());
+	for(std::size_t i = 0; i < Sources.size(); ++i)
+		Names[i] = this->submit(Sources[i].Type, Sources[i].Filename, PreprocessedSources[i].get());
+
+	return Names;
+}
+
+GLuint compiler::submit(GLenum Type, std::string const & Filename, std::string const & PreprocessedSource)
+{
 	assert(!PreprocessedSource.empty());
 	char const* PreprocessedSourcePointer = PreprocessedSource.c_str();
 
-	fprintf(stdout, "%s\n", PreprocessedSource.c_str());
+#	if defined(OGL_SAMPLES_DUMP_SHADERS)
+		fprintf(stdout, "%s\n", PreprocessedSource.c_str());
+#	endif
 
 	GLuint Name = glCreateShader(Type);
 	glShaderSource(Name, 1, &PreprocessedSourcePointer, NULL);
-	glCompileShader(Name);
+
+	// Without a program cache link_program always compiles, the driver might as well start now
+	if(this->Mode == DEFERRED && has_program_cache())
+		this->DeferredShaders.insert(Name);
+	else
+		glCompileShader(Name);
 
 	std::pair<files_map::iterator, bool> ResultFiles = this->ShaderFiles.insert(std::make_pair(Name, Filename));
 	assert(ResultFiles.second);
@@ -199,6 +634,7 @@ GLuint compiler::create(GLenum Type, std::string const & Filename, std::string c
 	assert(ResultNames.second);
 	std::pair<names_map::iterator, bool> ResultChecks = this->PendingChecks.insert(std::make_pair(Filename, Name));
 	assert(ResultChecks.second);
+	this->ShaderHashes[Name] = hash(&Type, sizeof(Type), hash(PreprocessedSource.c_str(), HASH_SEED));
 
 	return Name;
 }
@@ -210,6 +646,9 @@ bool compiler::destroy(GLuint const & Name)
 		return false; // Shader name not found
 	std::string File = NameIterator->second;
 	this->ShaderFiles.erase(NameIterator);
+	this->ShaderHashes.erase(Name);
+	this->DeferredShaders.erase(Name);
+	this->DeferredChecks.erase(Name);
 
 	// Remove from the pending checks list
 	names_map::iterator PendingIterator = this->PendingChecks.find(File);
@@ -224,6 +663,106 @@ bool compiler::destroy(GLuint const & Name)
 	return true;
 }
 
+bool compiler::program_key(GLuint ProgramName, glm::uint64 & Key) const
+{
+	std::vector<GLuint> const ShaderNames = get_attached_shaders(ProgramName);
+	if(ShaderNames.empty())
+		return false;
+
+	// Attachment order doesn't matter
+	std::vector<glm::uint64> ShaderHashes;
+	for(std::size_t i = 0; i < ShaderNames.size(); ++i)
+	{
+		hashes_map::const_iterator Iterator = this->ShaderHashes.find(ShaderNames[i]);
+		if(Iterator == this->ShaderHashes.end())
+			return false;
+		ShaderHashes.push_back(Iterator->second);
+	}
+	std::sort(ShaderHashes.begin(), ShaderHashes.end());
+
+	GLint Separable = GL_FALSE;
+	if(has_separable_programs())
+		glGetProgramiv(ProgramName, GL_PROGRAM_SEPARABLE, &Separable);
+
+	std::vector<GLint> const Formats = get_program_binary_formats();
+
+	Key = hash(reinterpret_cast<char const*>(glGetString(GL_RENDERER)), HASH_SEED);
+	Key = hash(reinterpret_cast<char const*>(glGetString(GL_VERSION)), Key);
+	Key = hash(&Formats[0], Formats.size() * sizeof(GLint), Key);
+	Key = hash(&Separable, sizeof(Separable), Key);
+	Key = hash(&ShaderHashes[0], ShaderHashes.size() * sizeof(glm::uint64), Key);
+
+	return true;
+}
+
+void compiler::compile_deferred(GLuint ProgramName)
+{
+	std::vector<GLuint> const ShaderNames = get_attached_shaders(ProgramName);
+	for(std::size_t i = 0; i < ShaderNames.size(); ++i)
+	{
+		shaders_set::iterator Iterator = this->DeferredShaders.find(ShaderNames[i]);
+		if(Iterator == this->DeferredShaders.end())
+			continue;
+
+		glCompileShader(ShaderNames[i]);
+		this->DeferredShaders.erase(Iterator);
+		this->DeferredChecks.insert(ShaderNames[i]);
+	}
+}
+
+void compiler::link_program(GLuint ProgramName)
+{
+	glm::uint64 Key = 0;
+	if(!has_program_cache() || !this->program_key(ProgramName, Key))
+	{
+		this->compile_deferred(ProgramName);
+		glLinkProgram(ProgramName);
+		return;
+	}
+
+	std::vector<GLint> const Formats = get_program_binary_formats();
+
+	GLenum Format = 0;
+	std::vector<glm::uint8> Data;
+	if(load_program_binary(get_program_binary_path(Key), Key, Format, Data) && std::find(Formats.begin(), Formats.end(), static_cast<GLint>(Format)) != Formats.end())
+	{
+		glProgramBinary(ProgramName, Format, &Data[0], static_cast<GLsizei>(Data.size()));
+
+		GLint Status = GL_FALSE;
+		glGetProgramiv(ProgramName, GL_LINK_STATUS, &Status);
+		if(Status == GL_TRUE)
+			return;
+	}
+
+	// The driver rejected the binary or it wasn't cached yet, the shaders are still attached
+	this->compile_deferred(ProgramName);
+	glProgramParameteri(ProgramName, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(ProgramName);
+
+	this->PendingBinaries[ProgramName] = Key;
+}
+
+void compiler::store_binary(GLuint ProgramName, glm::uint64 Key) const
+{
+	// The program was deleted, or its name reused for other shaders
+	glm::uint64 CurrentKey = 0;
+	if(!glIsProgram(ProgramName) || !this->program_key(ProgramName, CurrentKey) || CurrentKey != Key)
+		return;
+
+	GLint Status = GL_FALSE;
+	glGetProgramiv(ProgramName, GL_LINK_STATUS, &Status);
+	GLint Length = 0;
+	if(Status == GL_TRUE)
+		glGetProgramiv(ProgramName, GL_PROGRAM_BINARY_LENGTH, &Length);
+	if(Length <= 0)
+		return;
+
+	GLenum Format = 0;
+	std::vector<glm::uint8> Data(static_cast<std::size_t>(Length));
+	glGetProgramBinary(ProgramName, Length, NULL, &Format, &Data[0]);
+	save_program_binary(get_program_binary_path(Key), Key, Format, Data);
+}
+
 bool compiler::validate_program(GLuint ProgramName) const
 {
 	if(!ProgramName)
@@ -254,10 +793,24 @@ bool compiler::check_program(GLuint ProgramName) const
 	if(!ProgramName)
 		return false;
 
+	hashes_map::iterator PendingIterator = this->PendingBinaries.find(ProgramName);
+	if(PendingIterator != this->PendingBinaries.end())
+	{
+		this->store_binary(PendingIterator->first, PendingIterator->second);
+		this->PendingBinaries.erase(PendingIterator);
+	}
+
+	// Shaders compiled by link_program weren't checked by check()
+	bool CompileSuccess = true;
+	std::vector<GLuint> const ShaderNames = get_attached_shaders(ProgramName);
+	for(std::size_t i = 0; i < ShaderNames.size(); ++i)
+		if(this->DeferredChecks.erase(ShaderNames[i]) > 0)
+			CompileSuccess = check_shader(ShaderNames[i]) && CompileSuccess;
+
 	GLint Result = GL_FALSE;
 	glGetProgramiv(ProgramName, GL_LINK_STATUS, &Result);
 
-	if(Result == GL_TRUE)
+	if(Result == GL_TRUE && CompileSuccess)
 		return true;
 
 	//fprintf(stdout, "Linking program\n");
@@ -270,7 +823,7 @@ bool compiler::check_program(GLuint ProgramName) const
 		fprintf(stdout, "%s\n", &Buffer[0]);
 	}
 
-	return Result == GL_TRUE;
+	return Result == GL_TRUE && CompileSuccess;
 }
 
 // TODO Interaction with KHR_debug
@@ -278,37 +831,28 @@ bool compiler::check()
 {
 	bool Success(true);
 
-	for
-	(
-		names_map::iterator ShaderIterator = PendingChecks.begin();
-		ShaderIterator != PendingChecks.end();
-		++ShaderIterator
-	)
-	{
-		GLuint ShaderName = ShaderIterator->second;
-		GLint Result = GL_FALSE;
-		glGetShaderiv(ShaderName, GL_COMPILE_STATUS, &Result);
-
-		if(Result == GL_TRUE)
-			continue;
-
-		int InfoLogLength;
-		glGetShaderiv(ShaderName, GL_INFO_LOG_LENGTH, &InfoLogLength);
-		if(InfoLogLength > 0)
-		{
-			std::vector<char> Buffer(InfoLogLength);
-			glGetShaderInfoLog(ShaderName, InfoLogLength, NULL, &Buffer[0]);
-			fprintf(stdout, "%s\n", &Buffer[0]);
-		}
+	// Shaders never compiled have no status to check
+	std::vector<GLuint> Names;
+	for(names_map::iterator ShaderIterator = PendingChecks.begin(); ShaderIterator != PendingChecks.end(); ++ShaderIterator)
+		if(this->DeferredShaders.find(ShaderIterator->second) == this->DeferredShaders.end())
+			Names.push_back(ShaderIterator->second);
+	Names = order_by_completion(Names);
 
-		Success = Success && Result == GL_TRUE;
+	for(std::size_t i = 0; i < Names.size(); ++i)
+	{
+		this->DeferredChecks.erase(Names[i]);
+		Success = check_shader(Names[i]) && Success;
 	}
-	
+
 	return Success; 
 }
 
 void compiler::clear()
 {
+	for(hashes_map::iterator PendingIterator = this->PendingBinaries.begin(); PendingIterator != this->PendingBinaries.end(); ++PendingIterator)
+		this->store_binary(PendingIterator->first, PendingIterator->second);
+	this->PendingBinaries.clear();
+
 	for(
 		names_map::iterator ShaderNameIterator = this->ShaderNames.begin(); 
 		ShaderNameIterator != this->ShaderNames.end(); 
@@ -318,6 +862,9 @@ void compiler::clear()
 	this->ShaderNames.clear();
 	this->ShaderFiles.clear();
 	this->PendingChecks.clear();
+	this->ShaderHashes.clear();
+	this->DeferredShaders.clear();
+	this->DeferredChecks.clear();
 }
 
 std::string load_file(std::string const & Filename)
@@ -351,15 +898,16 @@ bool load_binary
 
 	if(File)
 	{
-		fread(&Format, sizeof(GLenum), 1, File);
-		fread(&Size, sizeof(Size), 1, File);
-		if(Size > 0)
+		bool Success =
+			fread(&Format, sizeof(GLenum), 1, File) == 1 &&
+			fread(&Size, sizeof(Size), 1, File) == 1 && Size > 0;
+		if(Success)
 		{
 			Data.resize(Size);
-			fread(&Data[0], Size, 1, File);
-			return true;
+			Success = fread(&Data[0], Size, 1, File) == 1;
 		}
 		fclose(File);
+		return Success;
 	}
 	return false;
 }
@@ -384,3 +932,12 @@ bool save_binary
 	}
 	return false;
 }
+
+bool make_directory(std::string const & Path)
+{
+#	if defined(_WIN32)
+		return _mkdir(Path.c_str()) == 0;
+#	else
+		return mkdir(Path.c_str(), 0755) == 0;
+#	endif
+}
@@ -4,6 +4,7 @@
 #include <glm/gtc/type_precision.hpp>
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,8 @@ class compiler
 {
 	typedef std::map<std::string, GLuint> names_map;
 	typedef std::map<GLuint, std::string> files_map;
+	typedef std::map<GLuint, glm::uint64> hashes_map;
+	typedef std::set<GLuint> shaders_set;
 
 	class commandline
 	{
@@ -50,25 +53,67 @@ class compiler
 	};
 
 public:
+	enum mode
+	{
+		IMMEDIATE,
+		// Shaders are compiled by link_program, only when the program binary cache doesn't have the
+		// program. Every program using the shaders of such a compiler must be linked with link_program.
+		DEFERRED
+	};
+
+	struct source
+	{
+		GLenum Type;
+		std::string Filename;
+		std::string Arguments;
+	};
+
+	explicit compiler(mode Mode = IMMEDIATE);
 	~compiler();
 
 	GLuint create(GLenum Type, std::string const & Filename, std::string const & Arguments = std::string());
+	// Preprocess the sources on worker threads then submit them to the driver together, names in the order of the sources
+	std::vector<GLuint> create(std::vector<source> const & Sources);
 	bool destroy(GLuint const & Name);
 
+	// Link a program whose shaders were created by this compiler, loading it from the program binary
+	// cache when the same sources were linked before by the same driver. Bindings set with
+	// glBindAttribLocation, glBindFragDataLocation or glTransformFeedbackVaryings are not part of the
+	// cache key, link such programs with glLinkProgram. The binary is stored by check_program or clear
+	// so that the link doesn't block when the driver links on its own threads.
+	void link_program(GLuint ProgramName);
+
+	// The checks wait for the driver to finish compiling and linking. With parallel shader compile, create
+	// the other objects of the sample between link_program and the checks so that the driver overlaps them.
 	bool check_program(GLuint ProgramName) const;
 	bool validate_program(GLuint ProgramName) const;
 
+	// Shaders whose compilation is deferred are checked by check_program once link_program compiled them.
+	// With parallel shader compile, the shaders are checked as the driver completes them, without blocking
+	// on the ones still compiling until a deadline.
 	bool check();
 	// TODO: Not defined
 	bool check(GLuint const & Name);
 	void clear();
 
 private:
+	static std::string preprocess(std::string const & Filename, std::string const & Arguments);
+	GLuint submit(GLenum Type, std::string const & Filename, std::string const & Source);
+	bool program_key(GLuint ProgramName, glm::uint64 & Key) const;
+	void store_binary(GLuint ProgramName, glm::uint64 Key) const;
+	void compile_deferred(GLuint ProgramName);
+
+	mode Mode;
 	names_map ShaderNames;
 	files_map ShaderFiles;
 	names_map PendingChecks;
+	hashes_map ShaderHashes;
+	mutable hashes_map PendingBinaries;
+	shaders_set DeferredShaders;
+	mutable shaders_set DeferredChecks;
 };
 
 std::string load_file(std::string const & Filename);
 bool load_binary(std::string const & Filename, GLenum & Format, std::vector<glm::uint8> & Data, GLint & Size);
 bool save_binary(std::string const & Filename, GLenum const & Format, std::vector<glm::uint8> const & Data, GLint const & Size);
+bool make_directory(std::string const & Path);
@@ -17,23 +17,31 @@ std::string format(const char * Message, ...)
 	return Text;
 }
 
-void csv::log(char const* String, double Convergent, double Min, double Max)
+void csv::log(char const* String, char const* Series, stats const & Stats)
 {
-	this->Data.push_back(data(String, Convergent, Min, Max));
+	this->Data.push_back(data(String, Series, Stats));
 }
 
 void csv::save(char const* Filename)
 {
 	FILE* File(fopen(Filename, "a+"));
 	assert(File);
-	fprintf(File, "%s;%s;%s;%s\n", "Tests", "average", "max", "min");
+
+	// Only write the header once so that runs can be appended and diffed
+	fseek(File, 0, SEEK_END);
+	if(ftell(File) == 0)
+		fprintf(File, "%s;%s;%s;%s;%s;%s;%s;%s;%s;%s;%s;%s\n",
+			"test", "series", "count", "mean_us", "stddev_us", "min_us", "max_us",
+			"p50_us", "p90_us", "p99_us", "p999_us", "outliers");
 
 	for(std::size_t i = 0; i < this->Data.size(); ++i)
 	{
-		fprintf(File, "%s;%d;%d;%d\n",
-			Data[i].String.c_str(),
-			static_cast<int>(Data[i].Convergent),
-			static_cast<int>(Data[i].Max), static_cast<int>(Data[i].Min));
+		fprintf(File, "%s;%s;%lu;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g;%lu\n",
+			Data[i].String.c_str(), Data[i].Series.c_str(),
+			static_cast<unsigned long>(Data[i].Count),
+			Data[i].Mean, Data[i].Stddev, Data[i].Min, Data[i].Max,
+			Data[i].P50, Data[i].P90, Data[i].P99, Data[i].P999,
+			static_cast<unsigned long>(Data[i].Outliers));
 	}
 	fclose(File);
 }
@@ -43,10 +51,9 @@ void csv::print()
 	fprintf(stdout, "\n");
 	for(std::size_t i = 0; i < this->Data.size(); ++i)
 	{
-		fprintf(stdout, "%s, %2.5f, %2.5f, %2.5f\n",
-			Data[i].String.c_str(),
-			Data[i].Convergent / 1000.0,
-			Data[i].Min / 1000.0, Data[i].Max / 1000.0);
+		fprintf(stdout, "%s (%s), mean %2.5f, p50 %2.5f, p99 %2.5f, max %2.5f ms\n",
+			Data[i].String.c_str(), Data[i].Series.c_str(),
+			Data[i].Mean / 1000.0,
+			Data[i].P50 / 1000.0, Data[i].P99 / 1000.0, Data[i].Max / 1000.0);
 	}
 }
-
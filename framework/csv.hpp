@@ -1,5 +1,6 @@
 #pragma once
 
+#include "stats.hpp"
 #include <vector>
 #include <string>
 #include <cstdarg>
@@ -12,24 +13,36 @@ class csv
 	struct data
 	{
 		data(
-			std::string const & String,
-			double Convergent, double Min, double Max) :
-			String(String),
-			Convergent(Convergent), Min(Min), Max(Max)
+			std::string const & String, std::string const & Series, stats const & Stats) :
+			String(String), Series(Series),
+			Count(Stats.count()),
+			Mean(Stats.mean()), Stddev(Stats.stddev()),
+			Min(Stats.min()), Max(Stats.max()),
+			P50(Stats.percentile(50.0)), P90(Stats.percentile(90.0)),
+			P99(Stats.percentile(99.0)), P999(Stats.percentile(99.9)),
+			Outliers(Stats.outliers())
 		{}
 
 		std::string String;
-		double Convergent;
+		std::string Series;
+		std::size_t Count;
+		double Mean;
+		double Stddev;
 		double Min;
 		double Max;
+		double P50;
+		double P90;
+		double P99;
+		double P999;
+		std::size_t Outliers;
 	};
 
 public:
-	void log(char const* String, double Average, double Min, double Max);
+	// Times are in microseconds, Series names the timed quantity, eg "cpu" or "gpu"
+	void log(char const* String, char const* Series, stats const & Stats);
 	void save(char const* Filename);
 	void print();
 
 private:
 	std::vector<data> Data;
 };
-
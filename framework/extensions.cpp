@@ -0,0 +1,53 @@
+#include "extensions.hpp"
+#include <cstring>
+
+extension_registry::extension_registry() :
+	Count(0)
+{}
+
+void extension_registry::init()
+{
+	GLint ExtensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
+
+	// At most half of the slots are used so that probing sequences remain short
+	std::size_t SlotCount = 16;
+	while(SlotCount < static_cast<std::size_t>(ExtensionCount) * 2)
+		SlotCount <<= 1;
+
+	slot const Empty = {0, nullptr};
+	this->Slots.assign(SlotCount, Empty);
+	this->Count = 0;
+
+	std::size_t const Mask = SlotCount - 1;
+	for(GLint i = 0; i < ExtensionCount; ++i)
+	{
+		char const* Name = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+		if(!Name)
+			continue;
+
+		std::uint32_t const Hash = extension_hash(Name);
+		if(this->supported(Hash, Name))
+			continue;
+
+		std::size_t Index = Hash & Mask;
+		while(this->Slots[Index].Name)
+			Index = (Index + 1) & Mask;
+
+		slot const Slot = {Hash, Name};
+		this->Slots[Index] = Slot;
+		++this->Count;
+	}
+}
+
+bool extension_registry::supported(std::uint32_t Hash, char const* Name) const
+{
+	if(this->Slots.empty())
+		return false;
+
+	std::size_t const Mask = this->Slots.size() - 1;
+	for(std::size_t Index = Hash & Mask; this->Slots[Index].Name; Index = (Index + 1) & Mask)
+		if(this->Slots[Index].Hash == Hash && !strcmp(this->Slots[Index].Name, Name))
+			return true;
+	return false;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// FNV-1a hash of an extension name, evaluated at compile time for string literals
+constexpr std::uint32_t extension_hash(char const* Name, std::uint32_t Hash = 2166136261u)
+{
+	return *Name ? extension_hash(Name + 1, (Hash ^ static_cast<unsigned char>(*Name)) * 16777619u) : Hash;
+}
+
+// Extensions of the current context, enumerated once when the context is created.
+// The names returned by glGetStringi are kept in an open addressing table, a lookup hashes
+// the name and compares the probed slots without building strings or querying the context.
+class extension_registry
+{
+public:
+	extension_registry();
+
+	// Enumerate the extensions of the current context, the names remain owned by the context
+	void init();
+
+	bool supported(char const* Name) const {return this->supported(extension_hash(Name), Name);}
+	bool supported(std::uint32_t Hash, char const* Name) const;
+
+	std::size_t count() const {return this->Count;}
+
+private:
+	struct slot
+	{
+		std::uint32_t Hash;
+		char const* Name;
+	};
+
+	std::vector<slot> Slots;
+	std::size_t Count;
+};
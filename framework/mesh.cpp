@@ -1,67 +1,57 @@
 #include "mesh.hpp"
 #include "test.hpp"
+#include <gli/core/parallel.hpp>
+#include <glm/exponential.hpp>
 #include <glm/geometric.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 namespace
 {
-	void subdivise(std::vector<glm::vec3>& VertexData, std::size_t& VertexIndex, std::vector<GLushort>& ElementData, std::size_t I0, std::size_t J0, std::size_t K0, int Subdivise)
-	{
-		if(Subdivise == 0)
-		{
-			ElementData.push_back(I0);
-			ElementData.push_back(J0);
-			ElementData.push_back(K0);
-		}
-		else
-		{
-			if(VertexIndex + 3 >= VertexData.size())
-				VertexData.resize(VertexData.size() * 2);
+	std::size_t const ICOSAHEDRON_VERTEX_COUNT = 12;
+	std::size_t const ICOSAHEDRON_EDGE_COUNT = 30;
+	std::size_t const ICOSAHEDRON_FACE_COUNT = 20;
 
-			glm::vec3 const& A0 = VertexData[I0];
-			glm::vec3 const& B0 = VertexData[J0];
-			glm::vec3 const& C0 = VertexData[K0];
-
-			std::size_t const I1 = VertexIndex++;
-			std::size_t const J1 = VertexIndex++;
-			std::size_t const K1 = VertexIndex++;
+	// Faces of the icosahedron, in the order of generate_icosahedron
+	std::size_t const IcosahedronFaces[ICOSAHEDRON_FACE_COUNT][3] =
+	{
+		{0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+		{1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+		{3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+		{4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1}
+	};
 
-			glm::vec3 U = (B0 + C0) * 0.5f;
-			glm::vec3 V = (C0 + A0) * 0.5f;
-			glm::vec3 W = (A0 + B0) * 0.5f;
+	void compute_icosahedron_vertices(glm::vec3 Vertices[ICOSAHEDRON_VERTEX_COUNT])
+	{
+		//The golden ratio
+		float t = (1 +sqrt(5))/ 2;
+		float size = 1.0f;
 
-			if(glm::length(U) > 0.0f)
-				U = glm::normalize(U);
-			if(glm::length(V) > 0.0f)
-				V = glm::normalize(V);
-			if(glm::length(W) > 0.0f)
-				W = glm::normalize(W);
+		Vertices[0] = glm::normalize(glm::vec3(-size, t * size, 0.0f));
+		Vertices[1] = glm::normalize(glm::vec3(+size, t * size, 0.0f));
+		Vertices[2] = glm::normalize(glm::vec3(-size,-t * size, 0.0f));
+		Vertices[3] = glm::normalize(glm::vec3(+size,-t * size, 0.0f));
 
-			VertexData[I1] = U;
-			VertexData[J1] = V;
-			VertexData[K1] = W;
+		Vertices[4] = glm::normalize(glm::vec3(0.0f,-size, t * size));
+		Vertices[5] = glm::normalize(glm::vec3(0.0f, size, t * size));
+		Vertices[6] = glm::normalize(glm::vec3(0.0f,-size,-t * size));
+		Vertices[7] = glm::normalize(glm::vec3(0.0f, size,-t * size));
 
-			subdivise(VertexData, VertexIndex, ElementData, I0, J1, K1, Subdivise - 1);
-			subdivise(VertexData, VertexIndex, ElementData, J0, K1, I1, Subdivise - 1);
-			subdivise(VertexData, VertexIndex, ElementData, K0, I1, J1, Subdivise - 1);
-			subdivise(VertexData, VertexIndex, ElementData, J1, I1, K1, Subdivise - 1);
-		}
+		Vertices[8] = glm::normalize(glm::vec3( t * size, 0.0f,-size));
+		Vertices[9] = glm::normalize(glm::vec3( t * size, 0.0f, size));
+		Vertices[10] = glm::normalize(glm::vec3(-t * size, 0.0f,-size));
+		Vertices[11] = glm::normalize(glm::vec3(-t * size, 0.0f, size));
 	}
 
-	//http://www.3dgep.com/forward-plus/#Forward
-	//http://blog.coredumping.com/subdivision-of-icosahedrons/
-	//http://blog.andreaskahler.com/2009/06/creating-icosphere-mesh-in-code.html
-	void generate_sphere(std::vector<glm::vec3>& VertexData, std::vector<GLushort>& ElementData, int Subdivision)
+	// Same result as normalizing a midpoint of non zero length, computing its squared length once
+	glm::vec3 compute_midpoint(glm::vec3 const& A, glm::vec3 const& B)
 	{
-		VertexData[0] = glm::normalize(glm::vec3(+1.0f, 0.0f,-0.70710678118f));
-		VertexData[1] = glm::normalize(glm::vec3(-1.0f, 0.0f,-0.70710678118f));
-		VertexData[2] = glm::normalize(glm::vec3(+0.0f,+1.0f,+0.70710678118f));
-		VertexData[3] = glm::normalize(glm::vec3(+0.0f,-1.0f,+0.70710678118f));
-
-		std::size_t VertexIndex = 4;
-		subdivise(VertexData, VertexIndex, ElementData, 0, 2, 3, Subdivision);
-		subdivise(VertexData, VertexIndex, ElementData, 0, 3, 1, Subdivision);
-		subdivise(VertexData, VertexIndex, ElementData, 1, 3, 2, Subdivision);
-		subdivise(VertexData, VertexIndex, ElementData, 1, 2, 0, Subdivision);
+		glm::vec3 const Midpoint = (A + B) * 0.5f;
+		float const SquaredLength = glm::dot(Midpoint, Midpoint);
+		return SquaredLength > 0.0f ? Midpoint * glm::inversesqrt(SquaredLength) : Midpoint;
 	}
 
 	void subdivise_icosahedron(std::vector<glm::vec3>& VertexData, glm::vec3 const& A0, glm::vec3 const& B0, glm::vec3 const& C0, int Subdivise)
@@ -74,16 +64,9 @@ namespace
 		}
 		else
 		{
-			glm::vec3 A1 = (B0 + C0) * 0.5f;
-			glm::vec3 B1 = (C0 + A0) * 0.5f;
-			glm::vec3 C1 = (A0 + B0) * 0.5f;
-
-			if(glm::length(A1) > 0.0f)
-				A1 = glm::normalize(A1);
-			if(glm::length(B1) > 0.0f)
-				B1 = glm::normalize(B1);
-			if(glm::length(C1) > 0.0f)
-				C1 = glm::normalize(C1);
+			glm::vec3 const A1 = compute_midpoint(B0, C0);
+			glm::vec3 const B1 = compute_midpoint(C0, A0);
+			glm::vec3 const C1 = compute_midpoint(A0, B0);
 
 			subdivise_icosahedron(VertexData, A0, B1, C1, Subdivise - 1);
 			subdivise_icosahedron(VertexData, B0, C1, A1, Subdivise - 1);
@@ -91,65 +74,534 @@ namespace
 			subdivise_icosahedron(VertexData, B1, A1, C1, Subdivise - 1);
 		}
 	}
+
+	// Subdivision of a face of the icosahedron on a lattice of Segments^2 triangles: (0, 0), (Segments, 0) and (0, Segments) are its corners.
+	// The vertices on the edges of the icosahedron are numbered per edge, from its smallest corner index, after the 12 corners,
+	// then the vertices inside the faces are numbered per face, so that each lattice point has its index without a lookup.
+	struct icosphere_face
+	{
+		enum edge
+		{
+			EDGE_AB,
+			EDGE_AC,
+			EDGE_BC
+		};
+
+		std::size_t Corners[3];
+		std::size_t Edges[3];
+		// The first face of an edge writes its vertices, the other face only indexes them
+		bool Owned[3];
+		std::size_t Segments;
+		std::size_t InteriorBase;
+		glf::vertex_v3fn3f* Vertices;
+
+		std::size_t edge_index(edge Edge, std::size_t Step) const
+		{
+			std::size_t const From = Edge == EDGE_BC ? this->Corners[1] : this->Corners[0];
+			std::size_t const To = Edge == EDGE_AB ? this->Corners[1] : this->Corners[2];
+
+			if(Step == 0)
+				return From;
+			if(Step == this->Segments)
+				return To;
+			std::size_t const CanonicalStep = From < To ? Step : this->Segments - Step;
+			return ICOSAHEDRON_VERTEX_COUNT + this->Edges[Edge] * (this->Segments - 1) + CanonicalStep - 1;
+		}
+
+		std::size_t index(glm::uvec2 const& Coord) const
+		{
+			if(Coord.y == 0)
+				return this->edge_index(EDGE_AB, Coord.x);
+			if(Coord.x == 0)
+				return this->edge_index(EDGE_AC, Coord.y);
+			if(Coord.x + Coord.y == this->Segments)
+				return this->edge_index(EDGE_BC, Coord.y);
+
+			// Row y holds Segments - 1 - y interior vertices
+			std::size_t const Row = Coord.y - 1;
+			return this->InteriorBase + Row * (this->Segments - 1) - Row * (Row + 1) / 2 + Coord.x - 1;
+		}
+
+		bool owned(glm::uvec2 const& Coord) const
+		{
+			if(Coord.y == 0)
+				return this->Owned[EDGE_AB];
+			if(Coord.x == 0)
+				return this->Owned[EDGE_AC];
+			if(Coord.x + Coord.y == this->Segments)
+				return this->Owned[EDGE_BC];
+			return true;
+		}
+
+		void write(glm::uvec2 const& Coord, glm::vec3 const& Position) const
+		{
+			if(this->owned(Coord))
+				this->Vertices[this->index(Coord)] = glf::vertex_v3fn3f(Position, Position);
+		}
+	};
+
+	// Same recursion as subdivise_icosahedron, with the lattice coordinates of the triangle corners
+	template <typename index_type>
+	void subdivise_icosphere
+	(
+		icosphere_face const& Face, index_type*& Element,
+		glm::vec3 const& A0, glm::vec3 const& B0, glm::vec3 const& C0,
+		glm::uvec2 const& CoordA0, glm::uvec2 const& CoordB0, glm::uvec2 const& CoordC0,
+		int Subdivise
+	)
+	{
+		if(Subdivise == 0)
+		{
+			*Element++ = static_cast<index_type>(Face.index(CoordA0));
+			*Element++ = static_cast<index_type>(Face.index(CoordB0));
+			*Element++ = static_cast<index_type>(Face.index(CoordC0));
+		}
+		else
+		{
+			glm::vec3 const A1 = compute_midpoint(B0, C0);
+			glm::vec3 const B1 = compute_midpoint(C0, A0);
+			glm::vec3 const C1 = compute_midpoint(A0, B0);
+
+			glm::uvec2 const CoordA1 = (CoordB0 + CoordC0) / 2u;
+			glm::uvec2 const CoordB1 = (CoordC0 + CoordA0) / 2u;
+			glm::uvec2 const CoordC1 = (CoordA0 + CoordB0) / 2u;
+
+			Face.write(CoordA1, A1);
+			Face.write(CoordB1, B1);
+			Face.write(CoordC1, C1);
+
+			subdivise_icosphere(Face, Element, A0, B1, C1, CoordA0, CoordB1, CoordC1, Subdivise - 1);
+			subdivise_icosphere(Face, Element, B0, C1, A1, CoordB0, CoordC1, CoordA1, Subdivise - 1);
+			subdivise_icosphere(Face, Element, C0, A1, B1, CoordC0, CoordA1, CoordB1, Subdivise - 1);
+			subdivise_icosphere(Face, Element, B1, A1, C1, CoordB1, CoordA1, CoordC1, Subdivise - 1);
+		}
+	}
+
+	template <typename index_type>
+	void generate_icosphere(std::vector<glf::vertex_v3fn3f>& VertexData, std::vector<index_type>& ElementData, int Subdivision)
+	{
+		glf::icosphere_size const Size = glf::compute_icosphere_size(Subdivision);
+		assert(Size.VertexCount - 1 <= std::numeric_limits<index_type>::max());
+
+		std::size_t const Segments = std::size_t(1) << Subdivision;
+		std::size_t const FaceElementCount = Segments * Segments * 3;
+
+		VertexData.assign(Size.VertexCount, glf::vertex_v3fn3f(glm::vec3(0.0f), glm::vec3(0.0f)));
+		ElementData.resize(Size.ElementCount);
+
+		glm::vec3 Corners[ICOSAHEDRON_VERTEX_COUNT];
+		compute_icosahedron_vertices(Corners);
+		for(std::size_t i = 0; i < ICOSAHEDRON_VERTEX_COUNT; ++i)
+			VertexData[i] = glf::vertex_v3fn3f(Corners[i], Corners[i]);
+
+		// Number the edges keyed by their corners, in the order the faces reach them
+		std::size_t EdgeIndices[ICOSAHEDRON_VERTEX_COUNT][ICOSAHEDRON_VERTEX_COUNT];
+		for(std::size_t i = 0; i < ICOSAHEDRON_VERTEX_COUNT; ++i)
+		for(std::size_t j = 0; j < ICOSAHEDRON_VERTEX_COUNT; ++j)
+			EdgeIndices[i][j] = ICOSAHEDRON_EDGE_COUNT;
+
+		std::size_t const InteriorCount = Segments > 1 ? (Segments - 1) * (Segments - 2) / 2 : 0;
+		std::size_t const InteriorBase = ICOSAHEDRON_VERTEX_COUNT + ICOSAHEDRON_EDGE_COUNT * (Segments - 1);
+
+		icosphere_face Faces[ICOSAHEDRON_FACE_COUNT];
+		std::size_t EdgeCount = 0;
+		for(std::size_t FaceIndex = 0; FaceIndex < ICOSAHEDRON_FACE_COUNT; ++FaceIndex)
+		{
+			icosphere_face& Face = Faces[FaceIndex];
+			std::size_t const* Corner = IcosahedronFaces[FaceIndex];
+			std::size_t const EdgeCorners[3][2] = {{Corner[0], Corner[1]}, {Corner[0], Corner[2]}, {Corner[1], Corner[2]}};
+
+			for(std::size_t i = 0; i < 3; ++i)
+			{
+				std::size_t& Edge = EdgeIndices[glm::min(EdgeCorners[i][0], EdgeCorners[i][1])][glm::max(EdgeCorners[i][0], EdgeCorners[i][1])];
+				Face.Owned[i] = Edge == ICOSAHEDRON_EDGE_COUNT;
+				if(Face.Owned[i])
+					Edge = EdgeCount++;
+				Face.Corners[i] = Corner[i];
+				Face.Edges[i] = Edge;
+			}
+
+			Face.Segments = Segments;
+			Face.InteriorBase = InteriorBase + FaceIndex * InteriorCount;
+			Face.Vertices = &VertexData[0];
+		}
+		assert(EdgeCount == ICOSAHEDRON_EDGE_COUNT);
+
+		// Faces write disjoint vertices and elements, small spheres are generated on the calling thread
+		std::size_t const FacesPerTask = Segments >= 16 ? 1 : ICOSAHEDRON_FACE_COUNT;
+		gli::detail::parallel_for(ICOSAHEDRON_FACE_COUNT, FacesPerTask, [&](std::size_t Begin, std::size_t End)
+		{
+			for(std::size_t FaceIndex = Begin; FaceIndex < End; ++FaceIndex)
+			{
+				icosphere_face const& Face = Faces[FaceIndex];
+				index_type* Element = &ElementData[FaceIndex * FaceElementCount];
+				subdivise_icosphere(Face, Element,
+					Corners[Face.Corners[0]], Corners[Face.Corners[1]], Corners[Face.Corners[2]],
+					glm::uvec2(0, 0), glm::uvec2(Segments, 0), glm::uvec2(0, Segments),
+					Subdivision);
+			}
+		});
+	}
+
+	// FIFO cache simulated with timestamps: a vertex is cached while fewer than CacheSize vertices were transformed since its own transform
+	struct vertex_cache
+	{
+		vertex_cache(std::size_t VertexCount, std::size_t CacheSize) :
+			Timestamps(VertexCount, 0),
+			Time(static_cast<std::uint32_t>(CacheSize) + 1),
+			CacheSize(static_cast<std::uint32_t>(CacheSize))
+		{}
+
+		// Returns the number of transformed vertices of a triangle
+		std::size_t transform(std::size_t A, std::size_t B, std::size_t C)
+		{
+			return this->transform(A) + this->transform(B) + this->transform(C);
+		}
+
+		std::size_t transform(std::size_t Vertex)
+		{
+			if(this->Time - this->Timestamps[Vertex] <= this->CacheSize)
+				return 0;
+			this->Timestamps[Vertex] = this->Time++;
+			return 1;
+		}
+
+		// Evict every vertex
+		void flush()
+		{
+			this->Time += this->CacheSize + 1;
+		}
+
+		std::vector<std::uint32_t> Timestamps;
+		std::uint32_t Time;
+		std::uint32_t CacheSize;
+	};
+
+	template <typename element_type>
+	glf::vertex_cache_stats compute_vertex_cache_stats(std::vector<element_type> const& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		vertex_cache Cache(VertexCount, CacheSize);
+		std::vector<bool> Referenced(VertexCount, false);
+
+		std::size_t Transformed = 0;
+		std::size_t ReferencedCount = 0;
+		for(std::size_t i = 0; i + 2 < ElementData.size(); i += 3)
+		{
+			Transformed += Cache.transform(ElementData[i + 0], ElementData[i + 1], ElementData[i + 2]);
+			for(std::size_t j = 0; j < 3; ++j)
+			{
+				if(Referenced[ElementData[i + j]])
+					continue;
+				Referenced[ElementData[i + j]] = true;
+				++ReferencedCount;
+			}
+		}
+
+		glf::vertex_cache_stats Stats;
+		Stats.ACMR = ElementData.size() >= 3 ? static_cast<float>(Transformed) / static_cast<float>(ElementData.size() / 3) : 0.0f;
+		Stats.ATVR = ReferencedCount > 0 ? static_cast<float>(Transformed) / static_cast<float>(ReferencedCount) : 0.0f;
+		return Stats;
+	}
+
+	template <typename element_type>
+	void optimize_vertex_cache(std::vector<element_type>& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		std::size_t const TriangleCount = ElementData.size() / 3;
+		if(TriangleCount == 0 || VertexCount == 0)
+			return;
+
+		// Triangles of each vertex and the number of these triangles not emitted yet
+		std::vector<std::uint32_t> Live(VertexCount, 0);
+		for(std::size_t i = 0; i < TriangleCount * 3; ++i)
+			++Live[ElementData[i]];
+
+		std::vector<std::uint32_t> Offsets(VertexCount + 1, 0);
+		for(std::size_t Vertex = 0; Vertex < VertexCount; ++Vertex)
+			Offsets[Vertex + 1] = Offsets[Vertex] + Live[Vertex];
+
+		std::vector<std::uint32_t> Adjacency(TriangleCount * 3);
+		{
+			std::vector<std::uint32_t> Cursors(Offsets.begin(), Offsets.end() - 1);
+			for(std::size_t i = 0; i < TriangleCount * 3; ++i)
+				Adjacency[Cursors[ElementData[i]]++] = static_cast<std::uint32_t>(i / 3);
+		}
+
+		std::vector<element_type> Result;
+		Result.reserve(ElementData.size());
+		std::vector<bool> Emitted(TriangleCount, false);
+		std::vector<std::uint32_t> DeadEnds;
+		DeadEnds.reserve(TriangleCount * 3);
+		std::vector<std::uint32_t> Candidates;
+
+		std::vector<std::uint32_t> Timestamps(VertexCount, 0);
+		std::uint32_t Time = static_cast<std::uint32_t>(CacheSize) + 1;
+		std::size_t Cursor = 0;
+
+		std::ptrdiff_t Fanning = 0;
+		while(Fanning >= 0)
+		{
+			// Emit the remaining triangles around the fanning vertex
+			Candidates.clear();
+			for(std::uint32_t i = Offsets[Fanning]; i < Offsets[Fanning + 1]; ++i)
+			{
+				std::uint32_t const Triangle = Adjacency[i];
+				if(Emitted[Triangle])
+					continue;
+				Emitted[Triangle] = true;
+
+				for(std::size_t j = 0; j < 3; ++j)
+				{
+					element_type const Vertex = ElementData[Triangle * 3 + j];
+					Result.push_back(Vertex);
+					DeadEnds.push_back(Vertex);
+					Candidates.push_back(Vertex);
+					--Live[Vertex];
+					if(Time - Timestamps[Vertex] > CacheSize)
+						Timestamps[Vertex] = Time++;
+				}
+			}
+
+			// Next fanning vertex: the oldest candidate that remains in the cache once its triangles are emitted
+			Fanning = -1;
+			std::int64_t BestPriority = -1;
+			for(std::size_t i = 0; i < Candidates.size(); ++i)
+			{
+				std::uint32_t const Vertex = Candidates[i];
+				if(Live[Vertex] == 0)
+					continue;
+
+				std::int64_t Priority = 0;
+				if(Time - Timestamps[Vertex] + 2 * Live[Vertex] <= CacheSize)
+					Priority = Time - Timestamps[Vertex];
+				if(Priority > BestPriority)
+				{
+					BestPriority = Priority;
+					Fanning = Vertex;
+				}
+			}
+
+			// Otherwise the last vertex emitted that still has triangles, then the next vertex in input order
+			while(Fanning < 0 && !DeadEnds.empty())
+			{
+				std::uint32_t const Vertex = DeadEnds.back();
+				DeadEnds.pop_back();
+				if(Live[Vertex] > 0)
+					Fanning = Vertex;
+			}
+			for(; Fanning < 0 && Cursor < VertexCount; ++Cursor)
+				if(Live[Cursor] > 0)
+					Fanning = static_cast<std::ptrdiff_t>(Cursor);
+		}
+
+		assert(Result.size() == TriangleCount * 3);
+		std::copy(Result.begin(), Result.end(), ElementData.begin());
+	}
+
+	struct overdraw_cluster
+	{
+		std::size_t First;
+		std::size_t Last;
+		float Order;
+	};
+
+	template <typename element_type>
+	void optimize_overdraw(std::vector<element_type>& ElementData, float const* Positions, std::size_t VertexCount, std::size_t VertexStride, std::size_t CacheSize, float Threshold)
+	{
+		std::size_t const TriangleCount = ElementData.size() / 3;
+		if(TriangleCount == 0)
+			return;
+
+		// A triangle with three cache misses starts a new patch of the mesh
+		std::vector<std::size_t> Patches;
+		{
+			vertex_cache Cache(VertexCount, CacheSize);
+			for(std::size_t Triangle = 0; Triangle < TriangleCount; ++Triangle)
+				if(Cache.transform(ElementData[Triangle * 3 + 0], ElementData[Triangle * 3 + 1], ElementData[Triangle * 3 + 2]) == 3 || Triangle == 0)
+					Patches.push_back(Triangle);
+			Patches.push_back(TriangleCount);
+		}
+
+		// Split the patches where the ACMR since the cluster start, replayed from an empty cache, reaches Threshold times the ACMR of the patch
+		std::vector<overdraw_cluster> Clusters;
+		vertex_cache Cache(VertexCount, CacheSize);
+		for(std::size_t Patch = 0; Patch + 1 < Patches.size(); ++Patch)
+		{
+			std::size_t const First = Patches[Patch];
+			std::size_t const Last = Patches[Patch + 1];
+
+			Cache.flush();
+			std::size_t PatchTransformed = 0;
+			for(std::size_t Triangle = First; Triangle < Last; ++Triangle)
+				PatchTransformed += Cache.transform(ElementData[Triangle * 3 + 0], ElementData[Triangle * 3 + 1], ElementData[Triangle * 3 + 2]);
+			float const ClusterThreshold = Threshold * static_cast<float>(PatchTransformed) / static_cast<float>(Last - First);
+
+			Cache.flush();
+			overdraw_cluster Cluster = {First, First, 0.0f};
+			std::size_t Transformed = 0;
+			for(std::size_t Triangle = First; Triangle < Last; ++Triangle)
+			{
+				Transformed += Cache.transform(ElementData[Triangle * 3 + 0], ElementData[Triangle * 3 + 1], ElementData[Triangle * 3 + 2]);
+				if(static_cast<float>(Transformed) > ClusterThreshold * static_cast<float>(Triangle + 1 - Cluster.First) && Triangle + 1 < Last)
+					continue;
+
+				Cluster.Last = Triangle + 1;
+				Clusters.push_back(Cluster);
+				Cluster.First = Triangle + 1;
+				Transformed = 0;
+				Cache.flush();
+			}
+		}
+
+		// Clusters facing away from the center of the mesh and far from it are drawn first, they are likely to occlude the others
+		glm::vec3 MeshCentroid(0.0f);
+		float MeshArea = 0.0f;
+		std::vector<glm::vec3> ClusterCentroids(Clusters.size());
+		std::vector<glm::vec3> ClusterNormals(Clusters.size());
+		for(std::size_t ClusterIndex = 0; ClusterIndex < Clusters.size(); ++ClusterIndex)
+		{
+			glm::vec3 Centroid(0.0f);
+			glm::vec3 Normal(0.0f);
+			float Area = 0.0f;
+			for(std::size_t Triangle = Clusters[ClusterIndex].First; Triangle < Clusters[ClusterIndex].Last; ++Triangle)
+			{
+				glm::vec3 Corners[3];
+				for(std::size_t j = 0; j < 3; ++j)
+				{
+					float const* Position = reinterpret_cast<float const*>(reinterpret_cast<char const*>(Positions) + ElementData[Triangle * 3 + j] * VertexStride);
+					Corners[j] = glm::vec3(Position[0], Position[1], Position[2]);
+				}
+
+				glm::vec3 const Cross = glm::cross(Corners[1] - Corners[0], Corners[2] - Corners[0]);
+				float const TriangleArea = glm::length(Cross);
+				Centroid += (Corners[0] + Corners[1] + Corners[2]) * (TriangleArea / 3.0f);
+				Normal += Cross;
+				Area += TriangleArea;
+			}
+
+			MeshCentroid += Centroid;
+			MeshArea += Area;
+			ClusterCentroids[ClusterIndex] = Area > 0.0f ? Centroid / Area : Centroid;
+			ClusterNormals[ClusterIndex] = glm::dot(Normal, Normal) > 0.0f ? glm::normalize(Normal) : Normal;
+		}
+		if(MeshArea > 0.0f)
+			MeshCentroid /= MeshArea;
+
+		for(std::size_t ClusterIndex = 0; ClusterIndex < Clusters.size(); ++ClusterIndex)
+			Clusters[ClusterIndex].Order = glm::dot(ClusterCentroids[ClusterIndex] - MeshCentroid, ClusterNormals[ClusterIndex]);
+
+		std::stable_sort(Clusters.begin(), Clusters.end(), [](overdraw_cluster const& A, overdraw_cluster const& B)
+		{
+			return A.Order > B.Order;
+		});
+
+		std::vector<element_type> Result;
+		Result.reserve(TriangleCount * 3);
+		for(std::size_t ClusterIndex = 0; ClusterIndex < Clusters.size(); ++ClusterIndex)
+			Result.insert(Result.end(), ElementData.begin() + Clusters[ClusterIndex].First * 3, ElementData.begin() + Clusters[ClusterIndex].Last * 3);
+		std::copy(Result.begin(), Result.end(), ElementData.begin());
+	}
+
+	template <typename element_type>
+	std::size_t optimize_vertex_fetch(void* Vertices, std::size_t VertexCount, std::size_t VertexSize, std::vector<element_type>& ElementData)
+	{
+		std::size_t const Unreferenced = ~std::size_t(0);
+		std::vector<std::size_t> Remap(VertexCount, Unreferenced);
+
+		std::size_t ReferencedCount = 0;
+		for(std::size_t i = 0; i < ElementData.size(); ++i)
+		{
+			std::size_t& Index = Remap[ElementData[i]];
+			if(Index == Unreferenced)
+				Index = ReferencedCount++;
+			ElementData[i] = static_cast<element_type>(Index);
+		}
+
+		std::vector<char> Source(static_cast<char const*>(Vertices), static_cast<char const*>(Vertices) + VertexCount * VertexSize);
+		for(std::size_t Vertex = 0; Vertex < VertexCount; ++Vertex)
+			if(Remap[Vertex] != Unreferenced)
+				memcpy(static_cast<char*>(Vertices) + Remap[Vertex] * VertexSize, &Source[Vertex * VertexSize], VertexSize);
+
+		return ReferencedCount;
+	}
 }//namespace
 
 namespace glf
 {
 	void generate_icosahedron(std::vector<glm::vec3>& VertexData, int Subdivision)
 	{
-/*
-		glm::vec3 const& A = glm::normalize(glm::vec3(+1.0f, 0.0f,-0.70710678118f));
-		glm::vec3 const& B = glm::normalize(glm::vec3(-1.0f, 0.0f,-0.70710678118f));
-		glm::vec3 const& C = glm::normalize(glm::vec3(+0.0f,+1.0f,+0.70710678118f));
-		glm::vec3 const& D = glm::normalize(glm::vec3(+0.0f,-1.0f,+0.70710678118f));
+		glm::vec3 Corners[ICOSAHEDRON_VERTEX_COUNT];
+		compute_icosahedron_vertices(Corners);
 
-		subdivise_array(VertexData, A, C, D, Subdivision);
-		subdivise_array(VertexData, A, D, B, Subdivision);
-		subdivise_array(VertexData, B, D, C, Subdivision);
-		subdivise_array(VertexData, B, C, A, Subdivision);
-*/
+		VertexData.reserve(VertexData.size() + compute_icosphere_size(Subdivision).ElementCount);
+		for(std::size_t FaceIndex = 0; FaceIndex < ICOSAHEDRON_FACE_COUNT; ++FaceIndex)
+		{
+			std::size_t const* Corner = IcosahedronFaces[FaceIndex];
+			subdivise_icosahedron(VertexData, Corners[Corner[0]], Corners[Corner[1]], Corners[Corner[2]], Subdivision);
+		}
+	}
 
-		//The golden ratio
-		float t = (1 +sqrt(5))/ 2;
-		float size = 1.0f;
+	icosphere_size compute_icosphere_size(int Subdivision)
+	{
+		std::size_t const Segments = std::size_t(1) << Subdivision;
+
+		icosphere_size Size;
+		Size.VertexCount = ICOSAHEDRON_FACE_COUNT / 2 * Segments * Segments + 2;
+		Size.ElementCount = ICOSAHEDRON_FACE_COUNT * Segments * Segments * 3;
+		return Size;
+	}
+
+	GLenum compute_icosphere_element_type(int Subdivision)
+	{
+		return compute_icosphere_size(Subdivision).VertexCount - 1 <= std::numeric_limits<GLushort>::max() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	void generate_icosphere(std::vector<vertex_v3fn3f>& VertexData, std::vector<GLushort>& ElementData, int Subdivision)
+	{
+		::generate_icosphere(VertexData, ElementData, Subdivision);
+	}
+
+	void generate_icosphere(std::vector<vertex_v3fn3f>& VertexData, std::vector<GLuint>& ElementData, int Subdivision)
+	{
+		::generate_icosphere(VertexData, ElementData, Subdivision);
+	}
+
+	vertex_cache_stats compute_vertex_cache_stats(std::vector<GLushort> const& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		return ::compute_vertex_cache_stats(ElementData, VertexCount, CacheSize);
+	}
+
+	vertex_cache_stats compute_vertex_cache_stats(std::vector<GLuint> const& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		return ::compute_vertex_cache_stats(ElementData, VertexCount, CacheSize);
+	}
+
+	void optimize_vertex_cache(std::vector<GLushort>& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		::optimize_vertex_cache(ElementData, VertexCount, CacheSize);
+	}
+
+	void optimize_vertex_cache(std::vector<GLuint>& ElementData, std::size_t VertexCount, std::size_t CacheSize)
+	{
+		::optimize_vertex_cache(ElementData, VertexCount, CacheSize);
+	}
 
-		glm::vec3 const A = glm::normalize(glm::vec3(-size, t * size, 0.0f));	// 0
-		glm::vec3 const B = glm::normalize(glm::vec3(+size, t * size, 0.0f));	// 1
-		glm::vec3 const C = glm::normalize(glm::vec3(-size,-t * size, 0.0f));	// 2
-		glm::vec3 const D = glm::normalize(glm::vec3(+size,-t * size, 0.0f));	// 3
-
-		glm::vec3 const E = glm::normalize(glm::vec3(0.0f,-size, t * size));	// 4
-		glm::vec3 const F = glm::normalize(glm::vec3(0.0f, size, t * size));	// 5
-		glm::vec3 const G = glm::normalize(glm::vec3(0.0f,-size,-t * size));	// 6
-		glm::vec3 const H = glm::normalize(glm::vec3(0.0f, size,-t * size));	// 7
-
-		glm::vec3 const I = glm::normalize(glm::vec3( t * size, 0.0f,-size));	// 8
-		glm::vec3 const J = glm::normalize(glm::vec3( t * size, 0.0f, size));	// 9
-		glm::vec3 const K = glm::normalize(glm::vec3(-t * size, 0.0f,-size));	// 10
-		glm::vec3 const L = glm::normalize(glm::vec3(-t * size, 0.0f, size));	// 11
-
-		subdivise_icosahedron(VertexData, A, L, F, Subdivision);
-		subdivise_icosahedron(VertexData, A, F, B, Subdivision);
-		subdivise_icosahedron(VertexData, A, B, H, Subdivision);
-		subdivise_icosahedron(VertexData, A, H, K, Subdivision);
-		subdivise_icosahedron(VertexData, A, K, L, Subdivision);
-
-		subdivise_icosahedron(VertexData, B, F, J, Subdivision);
-		subdivise_icosahedron(VertexData, F, L, E, Subdivision);
-		subdivise_icosahedron(VertexData, L, K, C, Subdivision);
-		subdivise_icosahedron(VertexData, K, H, G, Subdivision);
-		subdivise_icosahedron(VertexData, H, B, I, Subdivision);
-
-		subdivise_icosahedron(VertexData, D, J, E, Subdivision);
-		subdivise_icosahedron(VertexData, D, E, C, Subdivision);
-		subdivise_icosahedron(VertexData, D, C, G, Subdivision);
-		subdivise_icosahedron(VertexData, D, G, I, Subdivision);
-		subdivise_icosahedron(VertexData, D, I, J, Subdivision);
-
-		subdivise_icosahedron(VertexData, E, J, F, Subdivision);
-		subdivise_icosahedron(VertexData, C, E, L, Subdivision);
-		subdivise_icosahedron(VertexData, G, C, K, Subdivision);
-		subdivise_icosahedron(VertexData, I, G, H, Subdivision);
-		subdivise_icosahedron(VertexData, J, I, B, Subdivision);
+	void optimize_overdraw(std::vector<GLushort>& ElementData, float const* Positions, std::size_t VertexCount, std::size_t VertexStride, std::size_t CacheSize, float Threshold)
+	{
+		::optimize_overdraw(ElementData, Positions, VertexCount, VertexStride, CacheSize, Threshold);
+	}
+
+	void optimize_overdraw(std::vector<GLuint>& ElementData, float const* Positions, std::size_t VertexCount, std::size_t VertexStride, std::size_t CacheSize, float Threshold)
+	{
+		::optimize_overdraw(ElementData, Positions, VertexCount, VertexStride, CacheSize, Threshold);
+	}
+
+	std::size_t optimize_vertex_fetch(void* Vertices, std::size_t VertexCount, std::size_t VertexSize, std::vector<GLushort>& ElementData)
+	{
+		return ::optimize_vertex_fetch(Vertices, VertexCount, VertexSize, ElementData);
+	}
+
+	std::size_t optimize_vertex_fetch(void* Vertices, std::size_t VertexCount, std::size_t VertexSize, std::vector<GLuint>& ElementData)
+	{
+		return ::optimize_vertex_fetch(Vertices, VertexCount, VertexSize, ElementData);
 	}
 }//namespace glf
@@ -1,9 +1,82 @@
 #pragma once
 
+#include "vertex.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <type_traits>
 #include <vector>
 #include <glm/vec3.hpp>
 
 namespace glf
 {
 	void generate_icosahedron(std::vector<glm::vec3>& VertexData, int Subdivision);
+
+	// Vertex and element counts of an icosphere, the buffers are allocated once from them
+	struct icosphere_size
+	{
+		std::size_t VertexCount;
+		std::size_t ElementCount;
+	};
+
+	icosphere_size compute_icosphere_size(int Subdivision);
+
+	// GL_UNSIGNED_SHORT when the vertices of the icosphere can be indexed with GLushort, GL_UNSIGNED_INT otherwise
+	GLenum compute_icosphere_element_type(int Subdivision);
+
+	// Indexed icosphere of radius 1: the triangles of generate_icosahedron, in the same order, with the vertices shared by adjacent triangles.
+	// Each vertex stores its position twice, as the normal in Texcoord. The 20 faces of the icosahedron are subdivided in parallel.
+	// GLushort elements require compute_icosphere_element_type(Subdivision) == GL_UNSIGNED_SHORT.
+	void generate_icosphere(std::vector<vertex_v3fn3f>& VertexData, std::vector<GLushort>& ElementData, int Subdivision);
+	void generate_icosphere(std::vector<vertex_v3fn3f>& VertexData, std::vector<GLuint>& ElementData, int Subdivision);
+
+	// Post transform vertex cache efficiency of triangles, simulated with a FIFO cache of CacheSize vertices
+	struct vertex_cache_stats
+	{
+		// Average cache miss ratio, transformed vertices per triangle: 3 at worst, close to 0.5 for large regular meshes
+		float ACMR;
+		// Average transformed vertex ratio, transformed vertices per referenced vertex: 1 at best
+		float ATVR;
+	};
+
+	vertex_cache_stats compute_vertex_cache_stats(std::vector<GLushort> const& ElementData, std::size_t VertexCount, std::size_t CacheSize = 16);
+	vertex_cache_stats compute_vertex_cache_stats(std::vector<GLuint> const& ElementData, std::size_t VertexCount, std::size_t CacheSize = 16);
+
+	// Reorder the triangles for post transform vertex cache reuse with Tipsify (Sander, Nehab and Barczak 2007), in linear time
+	void optimize_vertex_cache(std::vector<GLushort>& ElementData, std::size_t VertexCount, std::size_t CacheSize = 16);
+	void optimize_vertex_cache(std::vector<GLuint>& ElementData, std::size_t VertexCount, std::size_t CacheSize = 16);
+
+	// Reorder clusters of triangles optimized by optimize_vertex_cache so that the outermost clusters are drawn first, whatever the view.
+	// A cluster ends when its ACMR reaches Threshold times the ACMR of its patch, larger thresholds trade vertex cache reuse for less overdraw.
+	// Positions points to the 3 floats position of the first vertex, VertexStride is the size in bytes of a vertex.
+	void optimize_overdraw(std::vector<GLushort>& ElementData, float const* Positions, std::size_t VertexCount, std::size_t VertexStride, std::size_t CacheSize = 16, float Threshold = 1.05f);
+	void optimize_overdraw(std::vector<GLuint>& ElementData, float const* Positions, std::size_t VertexCount, std::size_t VertexStride, std::size_t CacheSize = 16, float Threshold = 1.05f);
+
+	// Reorder the vertices in the order the triangles first reference them and remap the elements, for vertex fetch locality.
+	// Unreferenced vertices are dropped, returns the number of vertices left at the beginning of Vertices.
+	std::size_t optimize_vertex_fetch(void* Vertices, std::size_t VertexCount, std::size_t VertexSize, std::vector<GLushort>& ElementData);
+	std::size_t optimize_vertex_fetch(void* Vertices, std::size_t VertexCount, std::size_t VertexSize, std::vector<GLuint>& ElementData);
+
+	struct mesh_optimization
+	{
+		vertex_cache_stats Before;
+		vertex_cache_stats After;
+	};
+
+	// Vertex cache, overdraw then vertex fetch optimization of an indexed triangle list, vertex_type::Position must be a glm::vec3
+	template <typename vertex_type, typename element_type>
+	mesh_optimization optimize_mesh(std::vector<vertex_type>& VertexData, std::vector<element_type>& ElementData, std::size_t CacheSize = 16)
+	{
+		static_assert(std::is_same<decltype(vertex_type::Position), glm::vec3>::value, "optimize_mesh requires glm::vec3 positions");
+
+		mesh_optimization Result;
+		Result.Before = compute_vertex_cache_stats(ElementData, VertexData.size(), CacheSize);
+		if(!VertexData.empty())
+		{
+			optimize_vertex_cache(ElementData, VertexData.size(), CacheSize);
+			optimize_overdraw(ElementData, &VertexData[0].Position.x, VertexData.size(), sizeof(vertex_type), CacheSize);
+			VertexData.erase(VertexData.begin() + optimize_vertex_fetch(&VertexData[0], VertexData.size(), sizeof(vertex_type), ElementData), VertexData.end());
+		}
+		Result.After = compute_vertex_cache_stats(ElementData, VertexData.size(), CacheSize);
+		return Result;
+	}
 }//namespace glf
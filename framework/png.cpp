@@ -1,105 +1,770 @@
 #include "png.hpp"
-#include <FreeImage.h>
-#include <cstdlib>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 namespace
 {
-	static void FreeImageFree()
+	std::uint8_t const Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+	enum color_type
+	{
+		COLOR_GRAY = 0,
+		COLOR_RGB = 2,
+		COLOR_GRAY_ALPHA = 4,
+		COLOR_RGBA = 6
+	};
+
+	enum filter
 	{
-		FreeImage_DeInitialise();
+		FILTER_NONE,
+		FILTER_SUB,
+		FILTER_UP,
+		FILTER_AVERAGE,
+		FILTER_PAETH
+	};
+
+	gli::format const Formats[] = {gli::FORMAT_R8_UNORM_PACK8, gli::FORMAT_RG8_UNORM_PACK8, gli::FORMAT_RGB8_UNORM_PACK8, gli::FORMAT_RGBA8_UNORM_PACK8};
+	std::uint8_t const ColorTypes[] = {COLOR_GRAY, COLOR_GRAY_ALPHA, COLOR_RGB, COLOR_RGBA};
+
+	std::uint16_t const LengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+	std::uint8_t const LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+	std::uint16_t const DistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+	std::uint8_t const DistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+	std::uint8_t const CodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+	std::uint32_t read_u32(std::uint8_t const* Data)
+	{
+		return (std::uint32_t(Data[0]) << 24) | (std::uint32_t(Data[1]) << 16) | (std::uint32_t(Data[2]) << 8) | std::uint32_t(Data[3]);
 	}
 
+	void write_u32(std::vector<std::uint8_t>& Data, std::uint32_t Value)
+	{
+		Data.push_back(static_cast<std::uint8_t>(Value >> 24));
+		Data.push_back(static_cast<std::uint8_t>(Value >> 16));
+		Data.push_back(static_cast<std::uint8_t>(Value >> 8));
+		Data.push_back(static_cast<std::uint8_t>(Value));
+	}
+
+	std::uint32_t adler32(std::uint8_t const* Data, std::size_t Size)
+	{
+		std::uint32_t A = 1, B = 0;
+		while(Size > 0)
+		{
+			// Largest run that can't overflow B before the modulo
+			std::size_t const Run = Size < 5552 ? Size : 5552;
+			for(std::size_t i = 0; i < Run; ++i)
+			{
+				A += Data[i];
+				B += A;
+			}
+			A %= 65521;
+			B %= 65521;
+			Data += Run;
+			Size -= Run;
+		}
+		return (B << 16) | A;
+	}
+
+	struct crc32_table
+	{
+		crc32_table()
+		{
+			for(std::uint32_t i = 0; i < 256; ++i)
+			{
+				std::uint32_t Value = i;
+				for(int Bit = 0; Bit < 8; ++Bit)
+					Value = Value & 1 ? 0xEDB88320u ^ (Value >> 1) : Value >> 1;
+				this->Table[i] = Value;
+			}
+		}
+
+		std::uint32_t operator()(std::uint8_t const* Data, std::size_t Size) const
+		{
+			std::uint32_t Value = 0xFFFFFFFFu;
+			for(std::size_t i = 0; i < Size; ++i)
+				Value = this->Table[(Value ^ Data[i]) & 0xFF] ^ (Value >> 8);
+			return Value ^ 0xFFFFFFFFu;
+		}
+
+		std::uint32_t Table[256];
+	};
+
+	// Chunk length, type and CRC around the data appended by Write
+	template <typename write_type>
+	void write_chunk(std::vector<std::uint8_t>& File, char const* Type, write_type Write)
+	{
+		static crc32_table const CRC32;
+
+		std::size_t const Begin = File.size();
+		write_u32(File, 0);
+		File.insert(File.end(), Type, Type + 4);
+		Write(File);
+
+		std::uint32_t const Length = static_cast<std::uint32_t>(File.size() - Begin - 8);
+		for(int i = 0; i < 4; ++i)
+			File[Begin + i] = static_cast<std::uint8_t>(Length >> (24 - i * 8));
+		write_u32(File, CRC32(&File[Begin + 4], Length + 4));
+	}
+
+	std::uint8_t paeth(std::uint8_t A, std::uint8_t B, std::uint8_t C)
+	{
+		int const P = int(A) + int(B) - int(C);
+		int const PA = P > A ? P - A : A - P;
+		int const PB = P > B ? P - B : B - P;
+		int const PC = P > C ? P - C : C - P;
+		return PA <= PB && PA <= PC ? A : PB <= PC ? B : C;
+	}
+
+	// Inflate, RFC 1951
+	struct bit_reader
+	{
+		bit_reader(std::uint8_t const* Data, std::size_t Size) :
+			Data(Data), Size(Size), Offset(0), Bits(0), Count(0)
+		{}
+
+		// Past the end of the data, zero bytes are appended and overrun() tells the stream is truncated
+		void refill()
+		{
+			for(; this->Count <= 56; this->Count += 8, ++this->Offset)
+				if(this->Offset < this->Size)
+					this->Bits |= std::uint64_t(this->Data[this->Offset]) << this->Count;
+		}
+
+		std::uint32_t peek(unsigned Length) const
+		{
+			return static_cast<std::uint32_t>(this->Bits & ((std::uint64_t(1) << Length) - 1));
+		}
+
+		void consume(unsigned Length)
+		{
+			this->Bits >>= Length;
+			this->Count -= Length;
+		}
+
+		std::uint32_t read(unsigned Length)
+		{
+			if(this->Count < Length)
+				this->refill();
+			std::uint32_t const Value = this->peek(Length);
+			this->consume(Length);
+			return Value;
+		}
+
+		bool overrun() const
+		{
+			return this->Offset * 8 - this->Count > this->Size * 8;
+		}
 
-	static void FreeImageInit()
+		std::uint8_t const* Data;
+		std::size_t Size;
+		std::size_t Offset;
+		std::uint64_t Bits;
+		unsigned Count;
+	};
+
+	class huffman
 	{
-		static bool Init = false;
+		enum
+		{
+			FAST_BITS = 9,
+			MAX_BITS = 15
+		};
 
-		if(!Init)
+	public:
+		// Canonical code from the code length of each symbol, incomplete codes are allowed
+		bool build(std::uint8_t const* Lengths, unsigned SymbolCount)
 		{
-			Init = true;
-			FreeImage_Initialise(false);
-			atexit(FreeImageFree);
+			memset(this->Counts, 0, sizeof(this->Counts));
+			memset(this->Fast, 0, sizeof(this->Fast));
+			for(unsigned Symbol = 0; Symbol < SymbolCount; ++Symbol)
+				++this->Counts[Lengths[Symbol]];
+			this->Counts[0] = 0;
+
+			int Left = 1;
+			std::uint16_t Offsets[MAX_BITS + 1] = {0};
+			std::uint32_t Codes[MAX_BITS + 1] = {0};
+			for(unsigned Length = 1; Length <= MAX_BITS; ++Length)
+			{
+				Left = (Left << 1) - this->Counts[Length];
+				if(Left < 0)
+					return false;
+				if(Length < MAX_BITS)
+				{
+					Offsets[Length + 1] = Offsets[Length] + this->Counts[Length];
+					Codes[Length + 1] = (Codes[Length] + this->Counts[Length]) << 1;
+				}
+			}
+
+			for(unsigned Symbol = 0; Symbol < SymbolCount; ++Symbol)
+			{
+				unsigned const Length = Lengths[Symbol];
+				if(Length == 0)
+					continue;
+				this->Symbols[Offsets[Length]++] = static_cast<std::uint16_t>(Symbol);
+
+				std::uint32_t const Code = Codes[Length]++;
+				if(Length > FAST_BITS)
+					continue;
+
+				// Codes are stored most significant bit first in the stream
+				std::uint32_t Reversed = 0;
+				for(unsigned Bit = 0; Bit < Length; ++Bit)
+					Reversed |= ((Code >> Bit) & 1) << (Length - 1 - Bit);
+				for(std::uint32_t Entry = Reversed; Entry < (1u << FAST_BITS); Entry += 1u << Length)
+					this->Fast[Entry] = static_cast<std::uint16_t>((Length << FAST_BITS) | Symbol);
+			}
+
+			return true;
+		}
+
+		// Returns -1 for a code not in the table
+		int decode(bit_reader& Reader) const
+		{
+			if(Reader.Count < MAX_BITS)
+				Reader.refill();
+
+			std::uint16_t const Entry = this->Fast[Reader.peek(FAST_BITS)];
+			if(Entry)
+			{
+				Reader.consume(Entry >> FAST_BITS);
+				return Entry & ((1 << FAST_BITS) - 1);
+			}
+
+			// Codes longer than FAST_BITS, walked one bit at a time
+			int Code = 0, First = 0, Index = 0;
+			for(unsigned Length = 1; Length <= MAX_BITS; ++Length)
+			{
+				Code |= static_cast<int>((Reader.Bits >> (Length - 1)) & 1);
+				int const Count = this->Counts[Length];
+				if(Code - First < Count)
+				{
+					Reader.consume(Length);
+					return this->Symbols[Index + Code - First];
+				}
+				Index += Count;
+				First = (First + Count) << 1;
+				Code <<= 1;
+			}
+			return -1;
 		}
+
+	private:
+		std::uint16_t Fast[1 << FAST_BITS];
+		std::uint16_t Counts[MAX_BITS + 1];
+		std::uint16_t Symbols[288];
+	};
+
+	bool inflate_codes(bit_reader& Reader, huffman const& Literals, huffman const& Distances, std::vector<std::uint8_t>& Output, std::size_t& Size)
+	{
+		for(;;)
+		{
+			int const Symbol = Literals.decode(Reader);
+			if(Symbol < 0 || Reader.overrun())
+				return false;
+
+			if(Symbol < 256)
+			{
+				if(Size == Output.size())
+					return false;
+				Output[Size++] = static_cast<std::uint8_t>(Symbol);
+				continue;
+			}
+			if(Symbol == 256)
+				return true;
+			if(Symbol > 285)
+				return false;
+
+			std::size_t const Length = LengthBase[Symbol - 257] + Reader.read(LengthExtra[Symbol - 257]);
+			int const DistanceSymbol = Distances.decode(Reader);
+			if(DistanceSymbol < 0 || DistanceSymbol >= 30)
+				return false;
+			std::size_t const Distance = DistanceBase[DistanceSymbol] + Reader.read(DistanceExtra[DistanceSymbol]);
+			if(Distance > Size || Length > Output.size() - Size)
+				return false;
+
+			// Byte per byte, the match may overlap the bytes it copies
+			std::uint8_t* Dst = &Output[Size];
+			std::uint8_t const* Src = Dst - Distance;
+			for(std::size_t i = 0; i < Length; ++i)
+				Dst[i] = Src[i];
+			Size += Length;
+		}
+	}
+
+	bool inflate_dynamic(bit_reader& Reader, huffman& Literals, huffman& Distances)
+	{
+		unsigned const LiteralCount = Reader.read(5) + 257;
+		unsigned const DistanceCount = Reader.read(5) + 1;
+		unsigned const CodeLengthCount = Reader.read(4) + 4;
+		if(LiteralCount > 286 || DistanceCount > 30)
+			return false;
+
+		std::uint8_t Lengths[286 + 30] = {0};
+		for(unsigned i = 0; i < CodeLengthCount; ++i)
+			Lengths[CodeLengthOrder[i]] = static_cast<std::uint8_t>(Reader.read(3));
+
+		huffman CodeLengths;
+		if(!CodeLengths.build(Lengths, 19))
+			return false;
+
+		memset(Lengths, 0, sizeof(Lengths));
+		for(unsigned Index = 0; Index < LiteralCount + DistanceCount;)
+		{
+			int const Symbol = CodeLengths.decode(Reader);
+			if(Symbol < 0 || Reader.overrun())
+				return false;
+
+			if(Symbol < 16)
+			{
+				Lengths[Index++] = static_cast<std::uint8_t>(Symbol);
+				continue;
+			}
+
+			std::uint8_t Repeated = 0;
+			unsigned Count = 0;
+			if(Symbol == 16)
+			{
+				if(Index == 0)
+					return false;
+				Repeated = Lengths[Index - 1];
+				Count = 3 + Reader.read(2);
+			}
+			else if(Symbol == 17)
+				Count = 3 + Reader.read(3);
+			else
+				Count = 11 + Reader.read(7);
+
+			if(Index + Count > LiteralCount + DistanceCount)
+				return false;
+			memset(Lengths + Index, Repeated, Count);
+			Index += Count;
+		}
+
+		if(Lengths[256] == 0)
+			return false;
+		return Literals.build(Lengths, LiteralCount) && Distances.build(Lengths + LiteralCount, DistanceCount);
+	}
+
+	// Decompress a zlib stream of exactly Output.size() bytes, RFC 1950
+	bool inflate(std::uint8_t const* Data, std::size_t Size, std::vector<std::uint8_t>& Output)
+	{
+		if(Size < 6 || (Data[0] & 0x0F) != 8 || ((Data[0] << 8) | Data[1]) % 31 != 0 || (Data[1] & 0x20))
+			return false;
+
+		bit_reader Reader(Data + 2, Size - 6);
+		huffman Literals, Distances;
+		std::size_t Written = 0;
+
+		for(bool Final = false; !Final;)
+		{
+			Final = Reader.read(1) != 0;
+			switch(Reader.read(2))
+			{
+			default:
+				return false;
+			case 0:
+			{
+				// Give the whole bytes of the bit buffer back to copy the stored block directly
+				Reader.consume(Reader.Count & 7);
+				Reader.Offset -= Reader.Count / 8;
+				Reader.Bits = 0;
+				Reader.Count = 0;
+				if(Reader.Offset + 4 > Reader.Size)
+					return false;
+
+				std::uint8_t const* Block = Reader.Data + Reader.Offset;
+				std::size_t const Length = Block[0] | (Block[1] << 8);
+				if((Length ^ (Block[2] | (Block[3] << 8))) != 0xFFFF || Reader.Offset + 4 + Length > Reader.Size || Length > Output.size() - Written)
+					return false;
+				if(Length > 0)
+					memcpy(&Output[Written], Block + 4, Length);
+				Written += Length;
+				Reader.Offset += 4 + Length;
+				break;
+			}
+			case 1:
+			{
+				std::uint8_t Lengths[288 + 30];
+				memset(Lengths + 0, 8, 144);
+				memset(Lengths + 144, 9, 112);
+				memset(Lengths + 256, 7, 24);
+				memset(Lengths + 280, 8, 8);
+				memset(Lengths + 288, 5, 30);
+				Literals.build(Lengths, 288);
+				Distances.build(Lengths + 288, 30);
+				if(!inflate_codes(Reader, Literals, Distances, Output, Written))
+					return false;
+				break;
+			}
+			case 2:
+				if(!inflate_dynamic(Reader, Literals, Distances) || !inflate_codes(Reader, Literals, Distances, Output, Written))
+					return false;
+				break;
+			}
+
+			if(Reader.overrun())
+				return false;
+		}
+
+		return Written == Output.size() && adler32(&Output[0], Output.size()) == read_u32(Data + Size - 4);
+	}
+
+	// Deflate, RFC 1951
+	struct bit_writer
+	{
+		explicit bit_writer(std::vector<std::uint8_t>& Output) :
+			Output(Output), Bits(0), Count(0)
+		{}
+
+		void write(std::uint32_t Value, unsigned Length)
+		{
+			this->Bits |= std::uint64_t(Value) << this->Count;
+			this->Count += Length;
+			for(; this->Count >= 8; this->Count -= 8, this->Bits >>= 8)
+				this->Output.push_back(static_cast<std::uint8_t>(this->Bits));
+		}
+
+		void flush()
+		{
+			if(this->Count > 0)
+				this->write(0, 8 - this->Count);
+		}
+
+		std::vector<std::uint8_t>& Output;
+		std::uint64_t Bits;
+		unsigned Count;
+	};
+
+	unsigned floor_log2(std::uint32_t Value)
+	{
+		unsigned Result = 0;
+		while(Value >>= 1)
+			++Result;
+		return Result;
+	}
+
+	// Fixed Huffman codes of the literal and length symbols, bit reversed to be written least significant bit first
+	struct fixed_codes
+	{
+		fixed_codes()
+		{
+			for(std::uint32_t Symbol = 0; Symbol < 288; ++Symbol)
+			{
+				std::uint32_t Code = 0;
+				unsigned Length = 0;
+				if(Symbol < 144)
+				{
+					Code = 0x30 + Symbol;
+					Length = 8;
+				}
+				else if(Symbol < 256)
+				{
+					Code = 0x190 + Symbol - 144;
+					Length = 9;
+				}
+				else if(Symbol < 280)
+				{
+					Code = Symbol - 256;
+					Length = 7;
+				}
+				else
+				{
+					Code = 0xC0 + Symbol - 280;
+					Length = 8;
+				}
+
+				std::uint32_t Reversed = 0;
+				for(unsigned Bit = 0; Bit < Length; ++Bit)
+					Reversed |= ((Code >> Bit) & 1) << (Length - 1 - Bit);
+				this->Codes[Symbol] = static_cast<std::uint16_t>(Reversed);
+				this->Lengths[Symbol] = static_cast<std::uint8_t>(Length);
+			}
+		}
+
+		void write_literal(bit_writer& Writer, std::uint32_t Symbol) const
+		{
+			Writer.write(this->Codes[Symbol], this->Lengths[Symbol]);
+		}
+
+		void write_match(bit_writer& Writer, std::uint32_t Length, std::uint32_t Distance) const
+		{
+			std::uint32_t const L = Length - 3;
+			if(L < 8)
+				this->write_literal(Writer, 257 + L);
+			else if(Length == 258)
+				this->write_literal(Writer, 285);
+			else
+			{
+				unsigned const Extra = floor_log2(L) - 2;
+				this->write_literal(Writer, 257 + 4 * (Extra + 1) + ((L >> Extra) & 3));
+				Writer.write(L & ((1u << Extra) - 1), Extra);
+			}
+
+			// 5 bits distance codes, bit reversed
+			std::uint32_t const D = Distance - 1;
+			std::uint32_t DistanceSymbol = D;
+			unsigned Extra = 0;
+			if(D >= 4)
+			{
+				Extra = floor_log2(D) - 1;
+				DistanceSymbol = 2 * (Extra + 1) + ((D >> Extra) & 1);
+			}
+			std::uint32_t Reversed = 0;
+			for(unsigned Bit = 0; Bit < 5; ++Bit)
+				Reversed |= ((DistanceSymbol >> Bit) & 1) << (4 - Bit);
+			Writer.write(Reversed, 5);
+			Writer.write(D & ((1u << Extra) - 1), Extra);
+		}
+
+		std::uint16_t Codes[288];
+		std::uint8_t Lengths[288];
+	};
+
+	std::size_t const HASH_BITS = 15;
+
+	std::size_t hash(std::uint8_t const* Data)
+	{
+		std::uint32_t const Value = Data[0] | (Data[1] << 8) | (Data[2] << 16);
+		return (Value * 2654435761u) >> (32 - HASH_BITS);
+	}
+
+	// Single final block of fixed Huffman codes, the matches are found with a single probe hash of the last position of each 3 bytes sequence
+	void deflate_fast(std::uint8_t const* Data, std::size_t Size, bit_writer& Writer)
+	{
+		static fixed_codes const Codes;
+		std::size_t const WINDOW_SIZE = 32768;
+		std::size_t const MAX_MATCH = 258;
+
+		Writer.write(1, 1);
+		Writer.write(1, 2);
+
+		std::vector<std::int32_t> Head(std::size_t(1) << HASH_BITS, -1);
+
+		for(std::size_t Offset = 0; Offset < Size;)
+		{
+			std::size_t Length = 0;
+			std::size_t Distance = 0;
+			if(Offset + 3 <= Size)
+			{
+				std::int32_t& Entry = Head[hash(Data + Offset)];
+				std::int32_t const Candidate = Entry;
+				Entry = static_cast<std::int32_t>(Offset);
+
+				if(Candidate >= 0 && Offset - Candidate <= WINDOW_SIZE)
+				{
+					std::size_t const Max = Size - Offset < MAX_MATCH ? Size - Offset : MAX_MATCH;
+					std::uint8_t const* Src = Data + Candidate;
+					std::uint8_t const* Dst = Data + Offset;
+					while(Length < Max && Src[Length] == Dst[Length])
+						++Length;
+					Distance = Offset - Candidate;
+				}
+			}
+
+			if(Length < 3)
+			{
+				Codes.write_literal(Writer, Data[Offset++]);
+				continue;
+			}
+
+			Codes.write_match(Writer, static_cast<std::uint32_t>(Length), static_cast<std::uint32_t>(Distance));
+			for(std::size_t End = Offset + Length, Last = Size - 2; ++Offset < End;)
+				if(Offset < Last)
+					Head[hash(Data + Offset)] = static_cast<std::int32_t>(Offset);
+		}
+
+		Codes.write_literal(Writer, 256);
+		Writer.flush();
+	}
+
+	void deflate_store(std::uint8_t const* Data, std::size_t Size, std::vector<std::uint8_t>& Output)
+	{
+		std::size_t Offset = 0;
+		do
+		{
+			std::size_t const Length = Size - Offset < 65535 ? Size - Offset : 65535;
+			Output.push_back(Offset + Length == Size ? 1 : 0);
+			Output.push_back(static_cast<std::uint8_t>(Length));
+			Output.push_back(static_cast<std::uint8_t>(Length >> 8));
+			Output.push_back(static_cast<std::uint8_t>(~Length));
+			Output.push_back(static_cast<std::uint8_t>(~Length >> 8));
+			Output.insert(Output.end(), Data + Offset, Data + Offset + Length);
+			Offset += Length;
+		}
+		while(Offset < Size);
 	}
 }//namespace
 
 /// Loading a PNG file
 gli::texture load_png(char const* Filename)
 {
-	FreeImageInit();
+	FILE* File = fopen(Filename, "rb");
+	if(!File)
+		return gli::texture();
+
+	std::vector<std::uint8_t> Data;
+	fseek(File, 0, SEEK_END);
+	long const FileSize = ftell(File);
+	fseek(File, 0, SEEK_SET);
+	if(FileSize > 0)
+	{
+		Data.resize(static_cast<std::size_t>(FileSize));
+		Data.resize(fread(&Data[0], 1, Data.size(), File));
+	}
+	fclose(File);
 
-	FIBITMAP * Bitmap = FreeImage_Load(FIF_PNG, Filename, 0);
-	if(!Bitmap)
+	if(Data.size() < sizeof(Signature) + 25 || memcmp(&Data[0], Signature, sizeof(Signature)) != 0)
 		return gli::texture();
 
-	glm::uint BPP = FreeImage_GetBPP(Bitmap);
-	glm::uint Width = FreeImage_GetWidth(Bitmap);
-	glm::uint Height = FreeImage_GetHeight(Bitmap);
+	std::uint8_t const* Header = &Data[sizeof(Signature)];
+	if(read_u32(Header) != 13 || memcmp(Header + 4, "IHDR", 4) != 0)
+		return gli::texture();
 
-	gli::texture Texture(gli::TARGET_2D, BPP == 24 ? gli::FORMAT_RGB8_UNORM_PACK8 : gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture::extent_type(Width, Height, 1), 1, 1, 1);
-	memcpy(Texture.data(), FreeImage_GetBits(Bitmap), Texture.size());
-	FreeImage_Unload(Bitmap);
+	std::uint32_t const Width = read_u32(Header + 8);
+	std::uint32_t const Height = read_u32(Header + 12);
+	std::uint8_t const BitDepth = Header[16];
+	std::uint8_t const ColorType = Header[17];
+	std::uint8_t const Interlace = Header[20];
 
-	switch(gli::component_count(Texture.format()))
+	std::size_t Components = 0;
+	for(std::size_t i = 0; i < 4; ++i)
+		if(ColorTypes[i] == ColorType)
+			Components = i + 1;
+	if(Components == 0 || BitDepth != 8 || Interlace != 0 || Width == 0 || Height == 0 || Width > (1 << 16) || Height > (1 << 16))
+		return gli::texture();
+
+	// Concatenated IDAT chunks
+	std::vector<std::uint8_t> Stream;
+	for(std::size_t Offset = sizeof(Signature); Offset + 12 <= Data.size();)
 	{
-	default:
-		assert(0);
-		break;
-	case 3:
-		for(std::size_t Offset = 0; Offset < Texture.size() / 3; ++Offset)
-		{
-			glm::u8vec3 Src = *(static_cast<glm::u8vec3 const *>(Texture.data()) + Offset);
-			*(static_cast<glm::u8vec3*>(Texture.data()) + Offset) = glm::u8vec3(Src.z, Src.y, Src.x);
-		}
-		break;
-	case 4:
-		for(std::size_t Offset = 0; Offset < Texture.size() / 4; ++Offset)
+		std::size_t const Length = read_u32(&Data[Offset]);
+		if(Length > Data.size() - Offset - 12)
+			return gli::texture();
+
+		std::uint8_t const* Chunk = &Data[Offset + 4];
+		if(memcmp(Chunk, "IDAT", 4) == 0)
+			Stream.insert(Stream.end(), Chunk + 4, Chunk + 4 + Length);
+		else if(memcmp(Chunk, "IEND", 4) == 0)
+			break;
+		Offset += Length + 12;
+	}
+
+	std::size_t const RowSize = Width * Components;
+	std::vector<std::uint8_t> Filtered(Height * (RowSize + 1));
+	if(Stream.empty() || !inflate(&Stream[0], Stream.size(), Filtered))
+		return gli::texture();
+
+	// Unfilter the rows directly into the texture, bottom row first
+	gli::texture Texture(gli::TARGET_2D, Formats[Components - 1], gli::texture::extent_type(Width, Height, 1), 1, 1, 1);
+	std::uint8_t* const Texels = static_cast<std::uint8_t*>(Texture.data());
+	for(std::size_t y = 0; y < Height; ++y)
+	{
+		std::uint8_t const* Src = &Filtered[y * (RowSize + 1) + 1];
+		std::uint8_t* Dst = Texels + (Height - 1 - y) * RowSize;
+		std::uint8_t const* Up = y > 0 ? Dst + RowSize : nullptr;
+
+		switch(Src[-1])
 		{
-			glm::u8vec4 Src = *(static_cast<glm::u8vec4 const *>(Texture.data()) + Offset);
-			*(static_cast<glm::u8vec4*>(Texture.data()) + Offset) = glm::u8vec4(Src.z, Src.y, Src.x, Src.w);
+		default:
+			return gli::texture();
+		case FILTER_NONE:
+			memcpy(Dst, Src, RowSize);
+			break;
+		case FILTER_SUB:
+			memcpy(Dst, Src, Components);
+			for(std::size_t i = Components; i < RowSize; ++i)
+				Dst[i] = static_cast<std::uint8_t>(Src[i] + Dst[i - Components]);
+			break;
+		case FILTER_UP:
+			if(!Up)
+				memcpy(Dst, Src, RowSize);
+			else for(std::size_t i = 0; i < RowSize; ++i)
+				Dst[i] = static_cast<std::uint8_t>(Src[i] + Up[i]);
+			break;
+		case FILTER_AVERAGE:
+			for(std::size_t i = 0; i < RowSize; ++i)
+			{
+				unsigned const A = i >= Components ? Dst[i - Components] : 0;
+				unsigned const B = Up ? Up[i] : 0;
+				Dst[i] = static_cast<std::uint8_t>(Src[i] + ((A + B) >> 1));
+			}
+			break;
+		case FILTER_PAETH:
+			for(std::size_t i = 0; i < RowSize; ++i)
+			{
+				std::uint8_t const A = i >= Components ? Dst[i - Components] : 0;
+				std::uint8_t const B = Up ? Up[i] : 0;
+				std::uint8_t const C = Up && i >= Components ? Up[i - Components] : 0;
+				Dst[i] = static_cast<std::uint8_t>(Src[i] + paeth(A, B, C));
+			}
+			break;
 		}
-		break;
 	}
 
 	return Texture;
 }
 
-void save_png(gli::texture const& Texture, char const* Filename)
+void save_png(gli::texture const& Texture, char const* Filename, png_compression Compression)
 {
-	gli::texture Copy(gli::duplicate(Texture));
+	std::size_t const Components = gli::component_count(Texture.format());
+	assert(Components >= 1 && Components <= 4 && gli::block_size(Texture.format()) == Components);
 
-	switch(gli::component_count(Copy.format()))
+	std::size_t const Width = Texture.extent().x;
+	std::size_t const Height = Texture.extent().y;
+	std::size_t const RowSize = Width * Components;
+	std::uint8_t const* const Texels = static_cast<std::uint8_t const*>(Texture.data());
+
+	// Filter the rows from the texture, top row first
+	std::vector<std::uint8_t> Filtered(Height * (RowSize + 1));
+	for(std::size_t y = 0; y < Height; ++y)
 	{
-	default:
-		assert(0);
-		break;
-	case 3:
-		for(std::size_t Offset = 0; Offset < Copy.size() / 3; ++Offset)
-		{
-			glm::u8vec3 Src = *(static_cast<glm::u8vec3 const *>(Copy.data()) + Offset);
-			*(static_cast<glm::u8vec3*>(Copy.data()) + Offset) = glm::u8vec3(Src.z, Src.y, Src.x);
-		}
-		break;
-	case 4:
-		for(std::size_t Offset = 0; Offset < Copy.size() / 4; ++Offset)
+		std::uint8_t* Dst = &Filtered[y * (RowSize + 1)];
+		std::uint8_t const* Src = Texels + (Height - 1 - y) * RowSize;
+
+		if(Compression == PNG_COMPRESSION_STORE || y == 0)
 		{
-			glm::u8vec4 Src = *(static_cast<glm::u8vec4 const *>(Copy.data()) + Offset);
-			*(static_cast<glm::u8vec4*>(Copy.data()) + Offset) = glm::u8vec4(Src.z, Src.y, Src.x, Src.w);
+			*Dst++ = FILTER_NONE;
+			memcpy(Dst, Src, RowSize);
+			continue;
 		}
-		break;
-	}
 
-	FreeImageInit();
-
-	FIBITMAP* Bitmap = FreeImage_ConvertFromRawBits(
-		Copy.data<BYTE>(),
-		Copy.extent().x, Copy.extent().y,
-		static_cast<int>(Copy.extent().x * gli::component_count(Copy.format())),
-		static_cast<unsigned int>(gli::component_count(Copy.format()) * 8), 0x0000FF, 0x00FF00, 0xFF0000, false);
+		std::uint8_t const* Up = Src + RowSize;
+		*Dst++ = FILTER_UP;
+		for(std::size_t i = 0; i < RowSize; ++i)
+			Dst[i] = static_cast<std::uint8_t>(Src[i] - Up[i]);
+	}
 
-	BOOL Result = FreeImage_Save(FIF_PNG, Bitmap, Filename, 0);
-	assert(Result);
+	std::vector<std::uint8_t> File(Signature, Signature + sizeof(Signature));
+	write_chunk(File, "IHDR", [&](std::vector<std::uint8_t>& Chunk)
+	{
+		write_u32(Chunk, static_cast<std::uint32_t>(Width));
+		write_u32(Chunk, static_cast<std::uint32_t>(Height));
+		std::uint8_t const Header[] = {8, ColorTypes[Components - 1], 0, 0, 0};
+		Chunk.insert(Chunk.end(), Header, Header + sizeof(Header));
+	});
+	write_chunk(File, "IDAT", [&](std::vector<std::uint8_t>& Chunk)
+	{
+		Chunk.push_back(0x78);
+		Chunk.push_back(0x01);
+		if(Compression == PNG_COMPRESSION_STORE)
+			deflate_store(&Filtered[0], Filtered.size(), Chunk);
+		else
+		{
+			bit_writer Writer(Chunk);
+			deflate_fast(&Filtered[0], Filtered.size(), Writer);
+		}
+		write_u32(Chunk, adler32(&Filtered[0], Filtered.size()));
+	});
+	write_chunk(File, "IEND", [](std::vector<std::uint8_t>&){});
 
-	FreeImage_Unload(Bitmap);
+	FILE* Output = fopen(Filename, "wb");
+	assert(Output);
+	if(!Output)
+		return;
+	std::size_t const Written = fwrite(&File[0], 1, File.size(), Output);
+	fclose(Output);
+	assert(Written == File.size());
 }
-
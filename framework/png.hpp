@@ -2,5 +2,17 @@
 
 #include <gli/gli.hpp>
 
+enum png_compression
+{
+	// Unfiltered stored deflate blocks, no compression
+	PNG_COMPRESSION_STORE,
+	// Up filter and single probe LZ77 with the fixed Huffman codes, suited to test artifacts
+	PNG_COMPRESSION_FAST
+};
+
+// Load an 8 bits per component, non-interlaced, gray, gray alpha, RGB or RGBA PNG file.
+// The first row of the texture is the bottom row of the image, the layout of glReadPixels.
 gli::texture load_png(char const* Filename);
-void save_png(gli::texture const& Texture, char const* Filename);
+
+// Save a 2D texture of 8 bits per component with 1 to 4 components, the first row of the texture is the bottom row of the image.
+void save_png(gli::texture const& Texture, char const* Filename, png_compression Compression = PNG_COMPRESSION_FAST);
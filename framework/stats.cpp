@@ -0,0 +1,115 @@
+#include "stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+stats::stats()
+{
+	this->clear();
+}
+
+void stats::clear()
+{
+	this->Buckets.fill(0);
+	this->Count = 0;
+	this->Mean = 0.0;
+	this->SquaredDistance = 0.0;
+	this->Min = std::numeric_limits<double>::max();
+	this->Max = -std::numeric_limits<double>::max();
+}
+
+void stats::add(double Value)
+{
+	// Welford's online algorithm, numerically stable for long runs
+	++this->Count;
+	double const Delta = Value - this->Mean;
+	this->Mean += Delta / static_cast<double>(this->Count);
+	this->SquaredDistance += Delta * (Value - this->Mean);
+
+	this->Min = std::min(this->Min, Value);
+	this->Max = std::max(this->Max, Value);
+
+	++this->Buckets[this->bucket(Value)];
+}
+
+double stats::stddev() const
+{
+	return this->Count > 1 ? std::sqrt(this->SquaredDistance / static_cast<double>(this->Count - 1)) : 0.0;
+}
+
+double stats::min() const
+{
+	return this->Count > 0 ? this->Min : 0.0;
+}
+
+double stats::max() const
+{
+	return this->Count > 0 ? this->Max : 0.0;
+}
+
+double stats::percentile(double Percent) const
+{
+	if(this->Count == 0)
+		return 0.0;
+
+	// Nearest-rank on the histogram then clamped by the exact extrema
+	std::size_t const Rank = std::max<std::size_t>(static_cast<std::size_t>(std::ceil(Percent / 100.0 * static_cast<double>(this->Count))), 1);
+
+	std::size_t Cumulated = 0;
+	for(std::size_t BucketIndex = 0; BucketIndex < this->Buckets.size(); ++BucketIndex)
+	{
+		Cumulated += this->Buckets[BucketIndex];
+		if(Cumulated >= Rank)
+			return std::min(std::max(this->bucketValue(BucketIndex), this->Min), this->Max);
+	}
+
+	return this->Max;
+}
+
+std::size_t stats::outliers() const
+{
+	if(this->Count == 0)
+		return 0;
+
+	double const Q1 = this->percentile(25.0);
+	double const Q3 = this->percentile(75.0);
+	double const Lower = Q1 - 3.0 * (Q3 - Q1);
+	double const Upper = Q3 + 3.0 * (Q3 - Q1);
+
+	std::size_t Result = 0;
+	for(std::size_t BucketIndex = 0; BucketIndex < this->Buckets.size(); ++BucketIndex)
+	{
+		double const Value = this->bucketValue(BucketIndex);
+		if(Value < Lower || Value > Upper)
+			Result += this->Buckets[BucketIndex];
+	}
+	return Result;
+}
+
+std::size_t stats::bucket(double Value) const
+{
+	if(!(Value > 0.0))
+		return 0;
+
+	// Value = Mantissa * 2^Exponent with Mantissa in [0.5, 1)
+	int Exponent = 0;
+	double const Mantissa = std::frexp(Value, &Exponent);
+
+	if(Exponent < STATS_EXPONENT_MIN)
+		return 0;
+	if(Exponent >= STATS_EXPONENT_MIN + STATS_EXPONENT_COUNT)
+		return STATS_BUCKET_COUNT - 1;
+
+	std::size_t const SubBucket = std::min<std::size_t>(static_cast<std::size_t>((Mantissa - 0.5) * 2.0 * STATS_SUB_BUCKET_COUNT), STATS_SUB_BUCKET_COUNT - 1);
+	return static_cast<std::size_t>(Exponent - STATS_EXPONENT_MIN) * STATS_SUB_BUCKET_COUNT + SubBucket;
+}
+
+double stats::bucketValue(std::size_t Bucket) const
+{
+	int const Exponent = static_cast<int>(Bucket / STATS_SUB_BUCKET_COUNT) + STATS_EXPONENT_MIN;
+	double const SubBucket = static_cast<double>(Bucket % STATS_SUB_BUCKET_COUNT);
+
+	// Center of the bucket
+	double const Mantissa = 0.5 + (SubBucket + 0.5) / (2.0 * STATS_SUB_BUCKET_COUNT);
+	return std::ldexp(Mantissa, Exponent);
+}
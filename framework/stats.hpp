@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Streaming statistics over frame times with a fixed memory footprint.
+// Percentiles come from a log-linear histogram: each power of two is split
+// into STATS_SUB_BUCKET_COUNT buckets, bounding the relative error below 1/64.
+class stats
+{
+	enum
+	{
+		STATS_SUB_BUCKET_COUNT = 64,
+		STATS_EXPONENT_MIN = -8,
+		STATS_EXPONENT_COUNT = 48,
+		STATS_BUCKET_COUNT = STATS_SUB_BUCKET_COUNT * STATS_EXPONENT_COUNT
+	};
+
+public:
+	stats();
+
+	void add(double Value);
+	void clear();
+
+	std::size_t count() const{return this->Count;}
+	double mean() const{return this->Mean;}
+	double stddev() const;
+	double min() const;
+	double max() const;
+
+	// Percentile in [0, 100], eg percentile(99.9)
+	double percentile(double Percent) const;
+
+	// Number of values beyond Tukey's outer fences: [Q1 - 3 IQR, Q3 + 3 IQR]
+	std::size_t outliers() const;
+
+private:
+	std::size_t bucket(double Value) const;
+	double bucketValue(std::size_t Bucket) const;
+
+	std::array<std::uint32_t, STATS_BUCKET_COUNT> Buckets;
+	std::size_t Count;
+	double Mean;
+	double SquaredDistance;
+	double Min;
+	double Max;
+};
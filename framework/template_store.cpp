@@ -0,0 +1,254 @@
+#include "template_store.hpp"
+#include "compare.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	std::uint64_t const PRIME1 = 11400714785074694791ull;
+	std::uint64_t const PRIME2 = 14029467366897019727ull;
+	std::uint64_t const PRIME3 = 1609587929392839161ull;
+	std::uint64_t const PRIME4 = 9650029242287828579ull;
+	std::uint64_t const PRIME5 = 2870177450012600261ull;
+
+	std::uint64_t rotate(std::uint64_t Value, int Bits)
+	{
+		return (Value << Bits) | (Value >> (64 - Bits));
+	}
+
+	std::uint64_t load64(std::uint8_t const* Data)
+	{
+		std::uint64_t Value;
+		memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	std::uint64_t mix(std::uint64_t Accumulator, std::uint64_t Input)
+	{
+		return rotate(Accumulator + Input * PRIME2, 31) * PRIME1;
+	}
+
+	// FNV-1a, titles are short
+	std::uint64_t title_hash(char const* Title, std::size_t Length)
+	{
+		std::uint64_t Result = 14695981039346656037ull;
+		for(std::size_t i = 0; i < Length; ++i)
+			Result = (Result ^ static_cast<unsigned char>(Title[i])) * 1099511628211ull;
+		return Result;
+	}
+
+	char const MAGIC[8] = {'O', 'G', 'L', 'T', 'P', 'L', '0', '2'};
+
+	// Tile hashes and texels of each template start on a multiple of DATA_ALIGNMENT for the comparison kernels
+	std::size_t const DATA_ALIGNMENT = 16;
+
+	// The store is a build artifact, read on the machine that wrote it, so the fields are in native byte order
+	struct header
+	{
+		char Magic[8];
+		std::uint32_t EntryCount;
+		std::uint32_t SlotCount;
+	};
+
+	// A slot with an empty title is free
+	struct slot
+	{
+		std::uint64_t TitleHash;
+		std::uint64_t Hash;
+		std::uint64_t TileHashOffset;
+		std::uint64_t DataOffset;
+		std::uint32_t TitleOffset;
+		std::uint32_t TitleLength;
+		std::uint32_t Width;
+		std::uint32_t Height;
+	};
+
+	std::size_t align(std::size_t Offset)
+	{
+		return (Offset + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+	}
+
+	bool write_padding(FILE* File, char const (&Padding)[DATA_ALIGNMENT])
+	{
+		long const Position = ftell(File);
+		std::size_t const PaddingSize = align(static_cast<std::size_t>(Position)) - static_cast<std::size_t>(Position);
+		return Position >= 0 && fwrite(Padding, 1, PaddingSize, File) == PaddingSize;
+	}
+}//namespace
+
+// xxHash64 mixing, the four lanes of a 32 bytes step are independent so their multiplications overlap
+std::uint64_t template_hash(std::uint8_t const* Data, std::size_t Size)
+{
+	std::uint8_t const* const End = Data + Size;
+	std::uint64_t Result = 0;
+
+	if(Size >= 32)
+	{
+		std::uint64_t Lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+		for(; End - Data >= 32; Data += 32)
+		{
+			Lanes[0] = mix(Lanes[0], load64(Data + 0));
+			Lanes[1] = mix(Lanes[1], load64(Data + 8));
+			Lanes[2] = mix(Lanes[2], load64(Data + 16));
+			Lanes[3] = mix(Lanes[3], load64(Data + 24));
+		}
+
+		Result = rotate(Lanes[0], 1) + rotate(Lanes[1], 7) + rotate(Lanes[2], 12) + rotate(Lanes[3], 18);
+		for(int LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+			Result = (Result ^ mix(0, Lanes[LaneIndex])) * PRIME1 + PRIME4;
+	}
+	else
+		Result = PRIME5;
+
+	Result += static_cast<std::uint64_t>(Size);
+
+	for(; End - Data >= 8; Data += 8)
+		Result = rotate(Result ^ mix(0, load64(Data)), 27) * PRIME1 + PRIME4;
+	for(; Data < End; ++Data)
+		Result = rotate(Result ^ (*Data * PRIME5), 11) * PRIME1;
+
+	Result ^= Result >> 33;
+	Result *= PRIME2;
+	Result ^= Result >> 29;
+	Result *= PRIME3;
+	Result ^= Result >> 32;
+	return Result;
+}
+
+template_store::template_store(char const* Filename) :
+	Mapping(Filename),
+	EntryCount(0),
+	SlotCount(0)
+{
+	if(this->Mapping.size() < sizeof(header))
+		return;
+
+	header Header;
+	memcpy(&Header, this->Mapping.data(), sizeof(Header));
+	if(memcmp(Header.Magic, MAGIC, sizeof(MAGIC)) != 0)
+		return;
+
+	// A power of two number of slots with at least one free slot ends every probe
+	bool const PowerOfTwo = Header.SlotCount != 0 && (Header.SlotCount & (Header.SlotCount - 1)) == 0;
+	if(!PowerOfTwo || Header.EntryCount >= Header.SlotCount || this->Mapping.size() < sizeof(header) + Header.SlotCount * sizeof(slot))
+		return;
+
+	this->EntryCount = Header.EntryCount;
+	this->SlotCount = Header.SlotCount;
+}
+
+bool template_store::find(char const* Title, view & View) const
+{
+	if(this->empty())
+		return false;
+
+	std::size_t const Length = strlen(Title);
+	std::uint64_t const TitleHash = title_hash(Title, Length);
+	char const* const Base = this->Mapping.data();
+	std::size_t const Size = this->Mapping.size();
+
+	for(std::size_t Index = static_cast<std::size_t>(TitleHash);; ++Index)
+	{
+		slot Slot;
+		memcpy(&Slot, Base + sizeof(header) + (Index & (this->SlotCount - 1)) * sizeof(slot), sizeof(Slot));
+		if(Slot.TitleLength == 0)
+			return false;
+		if(Slot.TitleHash != TitleHash || Slot.TitleLength != Length)
+			continue;
+		if(Slot.TitleOffset > Size || Length > Size - Slot.TitleOffset || memcmp(Base + Slot.TitleOffset, Title, Length) != 0)
+			continue;
+
+		std::size_t const TileHashSize = rgb8::tile_count(Slot.Width) * rgb8::tile_count(Slot.Height) * sizeof(std::uint64_t);
+		std::size_t const DataSize = std::size_t(Slot.Width) * Slot.Height * 3;
+		if(Slot.TileHashOffset > Size || TileHashSize > Size - Slot.TileHashOffset || Slot.DataOffset > Size || DataSize > Size - Slot.DataOffset)
+			return false;
+
+		View.Width = Slot.Width;
+		View.Height = Slot.Height;
+		View.Hash = Slot.Hash;
+		View.TileHashes = reinterpret_cast<std::uint64_t const*>(Base + Slot.TileHashOffset);
+		View.Data = reinterpret_cast<std::uint8_t const*>(Base + Slot.DataOffset);
+		return true;
+	}
+}
+
+void template_store_writer::add(std::string const & Title, std::size_t Width, std::size_t Height, std::uint8_t const* Data)
+{
+	entry Entry;
+	Entry.Title = Title;
+	Entry.Width = Width;
+	Entry.Height = Height;
+	Entry.Data.assign(Data, Data + Width * Height * 3);
+	Entry.TileHashes.resize(rgb8::tile_count(Width) * rgb8::tile_count(Height));
+	if(!Entry.TileHashes.empty())
+		rgb8::tile_hashes(Data, Width, Height, &Entry.TileHashes[0]);
+	this->Entries.push_back(Entry);
+}
+
+bool template_store_writer::write(char const* Filename) const
+{
+	std::size_t SlotCount = 2;
+	while(SlotCount < this->Entries.size() * 2)
+		SlotCount *= 2;
+
+	header Header;
+	memcpy(Header.Magic, MAGIC, sizeof(MAGIC));
+	Header.EntryCount = static_cast<std::uint32_t>(this->Entries.size());
+	Header.SlotCount = static_cast<std::uint32_t>(SlotCount);
+
+	std::vector<slot> Slots(SlotCount);
+	memset(&Slots[0], 0, SlotCount * sizeof(slot));
+
+	// Titles follow the index, then the tile hashes and the texels of each template
+	std::size_t Offset = sizeof(header) + SlotCount * sizeof(slot);
+	std::vector<std::size_t> TitleOffsets(this->Entries.size());
+	for(std::size_t EntryIndex = 0; EntryIndex < this->Entries.size(); ++EntryIndex)
+	{
+		TitleOffsets[EntryIndex] = Offset;
+		Offset += this->Entries[EntryIndex].Title.size();
+	}
+
+	for(std::size_t EntryIndex = 0; EntryIndex < this->Entries.size(); ++EntryIndex)
+	{
+		entry const & Entry = this->Entries[EntryIndex];
+		if(Entry.Title.empty())
+			return false;
+
+		slot Slot;
+		Slot.TitleHash = title_hash(Entry.Title.c_str(), Entry.Title.size());
+		Slot.Hash = template_hash(Entry.Data.empty() ? nullptr : &Entry.Data[0], Entry.Data.size());
+		Slot.TileHashOffset = align(Offset);
+		Slot.DataOffset = align(Slot.TileHashOffset + Entry.TileHashes.size() * sizeof(std::uint64_t));
+		Slot.TitleOffset = static_cast<std::uint32_t>(TitleOffsets[EntryIndex]);
+		Slot.TitleLength = static_cast<std::uint32_t>(Entry.Title.size());
+		Slot.Width = static_cast<std::uint32_t>(Entry.Width);
+		Slot.Height = static_cast<std::uint32_t>(Entry.Height);
+		Offset = Slot.DataOffset + Entry.Data.size();
+
+		std::size_t Index = static_cast<std::size_t>(Slot.TitleHash);
+		while(Slots[Index & (SlotCount - 1)].TitleLength != 0)
+			++Index;
+		Slots[Index & (SlotCount - 1)] = Slot;
+	}
+
+	FILE* File = fopen(Filename, "wb");
+	if(!File)
+		return false;
+
+	bool Success = fwrite(&Header, sizeof(Header), 1, File) == 1;
+	Success = Success && fwrite(&Slots[0], sizeof(slot), SlotCount, File) == SlotCount;
+	for(std::size_t EntryIndex = 0; Success && EntryIndex < this->Entries.size(); ++EntryIndex)
+		Success = fwrite(this->Entries[EntryIndex].Title.c_str(), 1, this->Entries[EntryIndex].Title.size(), File) == this->Entries[EntryIndex].Title.size();
+
+	char const Padding[DATA_ALIGNMENT] = {0};
+	for(std::size_t EntryIndex = 0; Success && EntryIndex < this->Entries.size(); ++EntryIndex)
+	{
+		entry const & Entry = this->Entries[EntryIndex];
+		Success = write_padding(File, Padding);
+		Success = Success && (Entry.TileHashes.empty() || fwrite(&Entry.TileHashes[0], sizeof(std::uint64_t), Entry.TileHashes.size(), File) == Entry.TileHashes.size());
+		Success = Success && write_padding(File, Padding);
+		Success = Success && (Entry.Data.empty() || fwrite(&Entry.Data[0], 1, Entry.Data.size(), File) == Entry.Data.size());
+	}
+
+	return fclose(File) == 0 && Success;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <gli/core/file_mapping.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 64 bits hash of the texels of a template or a captured frame, reading 32 bytes per step
+std::uint64_t template_hash(std::uint8_t const* Data, std::size_t Size);
+
+// Single file holding every template as raw RGB8 rows, bottom row first like the captured frames.
+// The file starts with an open addressing index keyed by the hash of the sample title, each slot
+// giving the dimensions, the content hash and the offsets of the tile hashes and texels of a template.
+// The file is mapped once, a lookup probes the index and returns a view of the mapped texels.
+class template_store
+{
+public:
+	struct view
+	{
+		std::size_t Width;
+		std::size_t Height;
+		std::uint64_t Hash;
+		// rgb8::tile_hashes of the template
+		std::uint64_t const* TileHashes;
+		std::uint8_t const* Data;
+	};
+
+	explicit template_store(char const* Filename);
+
+	bool empty() const{return this->SlotCount == 0;}
+	std::size_t count() const{return this->EntryCount;}
+
+	// Returns false when the store doesn't have a template for Title
+	bool find(char const* Title, view & View) const;
+
+private:
+	gli::detail::file_mapping Mapping;
+	std::size_t EntryCount;
+	std::size_t SlotCount;
+};
+
+// Builds a template store file, the build packs data/templates with it
+class template_store_writer
+{
+public:
+	// Data holds Width * Height tightly packed RGB8 texels, bottom row first
+	void add(std::string const & Title, std::size_t Width, std::size_t Height, std::uint8_t const* Data);
+
+	bool write(char const* Filename) const;
+
+private:
+	struct entry
+	{
+		std::string Title;
+		std::size_t Width;
+		std::size_t Height;
+		std::vector<std::uint8_t> Data;
+		std::vector<std::uint64_t> TileHashes;
+	};
+
+	std::vector<entry> Entries;
+};
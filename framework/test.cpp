@@ -1,20 +1,132 @@
 ﻿#include "test.hpp"
 #include "png.hpp"
+#include "compare.hpp"
+#include "template_store.hpp"
 #include <glm/vector_relational.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <gli/generate_mipmaps.hpp>
 #include <gli/copy.hpp>
 #include <gli/duplicate.hpp>
 #include <fstream>
+#include <chrono>
 
 std::string getDataDirectory()
 {
 	return std::string(OGL_SAMPLES_SOURCE_DIR) + "/data/";
 }
 
+namespace
+{
+	std::string BinaryDirectory;
+}//namespace
+
 std::string getBinaryDirectory()
 {
-	return std::string(OGL_SAMPLES_BINARY_DIR) + "/";
+	return BinaryDirectory.empty() ? std::string(OGL_SAMPLES_BINARY_DIR) + "/" : BinaryDirectory;
+}
+
+void setBinaryDirectory(std::string const & Directory)
+{
+	BinaryDirectory = Directory.empty() || Directory[Directory.size() - 1] == '/' ? Directory : Directory + "/";
+}
+
+namespace
+{
+	struct shared_context
+	{
+		framework::profile Profile;
+		int Major;
+		int Minor;
+		glm::uvec2 WindowSize;
+		GLFWwindow* Window;
+#		if defined(OGL_SAMPLES_HEADLESS)
+			EGLSurface Surface;
+			EGLContext Context;
+#		endif
+	};
+
+	bool ShareContexts = false;
+	std::vector<shared_context> SharedContexts;
+
+	shared_context const* find_shared_context(framework::profile Profile, int Major, int Minor, glm::uvec2 const & WindowSize)
+	{
+		for(std::size_t i = 0; i < SharedContexts.size(); ++i)
+		{
+			shared_context const & Context = SharedContexts[i];
+			if(Context.Profile == Profile && Context.Major == Major && Context.Minor == Minor && Context.WindowSize == WindowSize)
+				return &Context;
+		}
+		return nullptr;
+	}
+
+	// Initial draw and read buffer of the default framebuffer, single buffered pbuffers only have a front buffer
+	GLenum default_color_buffer()
+	{
+		GLboolean DoubleBuffer = GL_TRUE;
+		glGetBooleanv(GL_DOUBLEBUFFER, &DoubleBuffer);
+		return DoubleBuffer ? GL_BACK : GL_FRONT;
+	}
+
+#	if defined(OGL_SAMPLES_HEADLESS)
+		EGLDisplay HeadlessDisplay = EGL_NO_DISPLAY;
+
+		// Prefer the surfaceless platform which doesn't require any window system
+		EGLDisplay get_headless_display()
+		{
+			if(HeadlessDisplay != EGL_NO_DISPLAY)
+				return HeadlessDisplay;
+
+			char const* Extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+			PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+			if(GetPlatformDisplay && Extensions && strstr(Extensions, "EGL_MESA_platform_surfaceless"))
+				HeadlessDisplay = GetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+			if(HeadlessDisplay == EGL_NO_DISPLAY)
+				HeadlessDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+			EGLint Major(0), Minor(0);
+			if(HeadlessDisplay != EGL_NO_DISPLAY && eglInitialize(HeadlessDisplay, &Major, &Minor) == EGL_FALSE)
+				HeadlessDisplay = EGL_NO_DISPLAY;
+
+			return HeadlessDisplay;
+		}
+
+		void terminate_headless_display()
+		{
+			if(HeadlessDisplay == EGL_NO_DISPLAY)
+				return;
+
+			eglMakeCurrent(HeadlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglTerminate(HeadlessDisplay);
+			HeadlessDisplay = EGL_NO_DISPLAY;
+		}
+#	endif//OGL_SAMPLES_HEADLESS
+}//namespace
+
+void framework::shareContexts(bool Share)
+{
+	ShareContexts = Share;
+}
+
+void framework::destroySharedContexts()
+{
+#	if defined(OGL_SAMPLES_HEADLESS)
+		if(HeadlessDisplay != EGL_NO_DISPLAY)
+			eglMakeCurrent(HeadlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		for(std::size_t i = 0; i < SharedContexts.size(); ++i)
+		{
+			eglDestroyContext(HeadlessDisplay, SharedContexts[i].Context);
+			eglDestroySurface(HeadlessDisplay, SharedContexts[i].Surface);
+		}
+		SharedContexts.clear();
+
+		terminate_headless_display();
+#	else
+		for(std::size_t i = 0; i < SharedContexts.size(); ++i)
+			glfwDestroyWindow(SharedContexts[i].Window);
+		SharedContexts.clear();
+
+		glfwTerminate();
+#	endif
 }
 
 framework::framework
@@ -72,11 +184,7 @@ framework::framework
 	Profile(Profile),
 	Major(Major),
 	Minor(Minor),
-	TimerQueryName(0),
 	FrameCount(FrameCount),
-	TimeSum(0.0),
-	TimeMin(std::numeric_limits<double>::max()),
-	TimeMax(0.0),
 	MouseOrigin(WindowSize >> 1u),
 	MouseCurrent(WindowSize >> 1u),
 	TranlationOrigin(Position),
@@ -86,20 +194,220 @@ framework::framework
 	MouseButtonFlags(0),
 	Error(false),
 	Heuristic(Heuristic),
-	ViewSetupFlags(VIEW_SETUP_TRANSLATE | VIEW_SETUP_ROTATE_X | VIEW_SETUP_ROTATE_Y)
+	ViewSetupFlags(VIEW_SETUP_TRANSLATE | VIEW_SETUP_ROTATE_X | VIEW_SETUP_ROTATE_Y),
+	TimerQueryIssued(0),
+	TimerQueryResolved(0),
+	TimerLatency(3),
+	TimerLatencyResolved(0),
+	CaptureInterval(0),
+	TemplateFrame(0),
+	TemplatePending(false)
 {
 	assert(WindowSize.x > 0 && WindowSize.y > 0);
 
 	memset(&KeyPressed[0], 0, sizeof(KeyPressed));
+	this->TimerQueryNames.fill(0);
+#	if defined(OGL_SAMPLES_HEADLESS)
+		this->Surface = EGL_NO_SURFACE;
+		this->Context = EGL_NO_CONTEXT;
+		this->ShouldClose = false;
+#	endif
+
+	bool Reused = false;
+	if(this->createContext(argv[0], WindowSize, Reused))
+	{
+		glGetError();
+
+		this->Extensions.init();
+
+		if(Reused)
+			this->resetContextState(WindowSize);
+
+#		if defined(_DEBUG) && defined(GL_KHR_debug)
+			if(this->isExtensionSupported("GL_KHR_debug"))
+			{
+				glEnable(GL_DEBUG_OUTPUT);
+				glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+				glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+				glDebugMessageCallback(&framework::debugOutput, this);
+			}
+#		endif
+
+		// Shaders compile and programs link on the driver threads, compiler only blocks when checking them
+		if(GLEW_ARB_parallel_shader_compile)
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		else if(GLEW_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+
+		glGenQueries(static_cast<GLsizei>(this->TimerQueryNames.size()), &this->TimerQueryNames[0]);
+
+		this->initCapture();
+	}
+}
+
+framework::~framework()
+{
+	this->Capture.release();
+
+	if(this->TimerQueryNames[0])
+		glDeleteQueries(static_cast<GLsizei>(this->TimerQueryNames.size()), &this->TimerQueryNames[0]);
+
+#	if defined(_DEBUG) && defined(GL_KHR_debug)
+		if(ShareContexts && this->isExtensionSupported("GL_KHR_debug"))
+			glDebugMessageCallback(nullptr, nullptr);
+#	endif
+
+	this->releaseContext();
+}
+
+#if defined(OGL_SAMPLES_HEADLESS)
+
+bool framework::createContext(char const* Name, glm::uvec2 const & WindowSize, bool & Reused)
+{
+	shared_context const* Shared = ShareContexts ? find_shared_context(this->Profile, this->Major, this->Minor, WindowSize) : nullptr;
+	Reused = Shared != nullptr;
+
+	EGLDisplay const Display = get_headless_display();
+	if(Display == EGL_NO_DISPLAY)
+		return false;
+
+	if(Reused)
+	{
+		this->Surface = Shared->Surface;
+		this->Context = Shared->Context;
+	}
+	else
+	{
+		EGLint const RenderableType = this->Profile != ES ? EGL_OPENGL_BIT : (this->Major >= 3 ? EGL_OPENGL_ES3_BIT_KHR : EGL_OPENGL_ES2_BIT);
+
+		// Match the default framebuffer GLFW creates: RGBA8 with a depth stencil buffer and no multisampling
+		EGLint const ConfigAttribs[] =
+		{
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, RenderableType,
+			EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+			EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8,
+			EGL_NONE
+		};
+
+		EGLint ConfigCount = 0;
+		if(eglChooseConfig(Display, ConfigAttribs, nullptr, 0, &ConfigCount) == EGL_FALSE || ConfigCount == 0)
+			return false;
+		std::vector<EGLConfig> Configs(static_cast<std::size_t>(ConfigCount));
+		eglChooseConfig(Display, ConfigAttribs, &Configs[0], ConfigCount, &ConfigCount);
+
+		// eglChooseConfig sorts the deepest color buffers first, pick an exact RGBA8 one so that readbacks match the templates
+		EGLConfig Config = Configs[0];
+		for(EGLint ConfigIndex = 0; ConfigIndex < ConfigCount; ++ConfigIndex)
+		{
+			EGLint Red = 0, Alpha = 0;
+			eglGetConfigAttrib(Display, Configs[ConfigIndex], EGL_RED_SIZE, &Red);
+			eglGetConfigAttrib(Display, Configs[ConfigIndex], EGL_ALPHA_SIZE, &Alpha);
+			if(Red == 8 && Alpha == 8)
+			{
+				Config = Configs[ConfigIndex];
+				break;
+			}
+		}
+
+		EGLint const SurfaceAttribs[] = {EGL_WIDTH, static_cast<EGLint>(WindowSize.x), EGL_HEIGHT, static_cast<EGLint>(WindowSize.y), EGL_NONE};
+		this->Surface = eglCreatePbufferSurface(Display, Config, SurfaceAttribs);
+		if(this->Surface == EGL_NO_SURFACE)
+			return false;
+
+		std::vector<EGLint> ContextAttribs;
+		if(version(this->Major, this->Minor) >= version(3, 2) || this->Profile == ES)
+		{
+			ContextAttribs.push_back(EGL_CONTEXT_MAJOR_VERSION_KHR);
+			ContextAttribs.push_back(this->Major);
+			ContextAttribs.push_back(EGL_CONTEXT_MINOR_VERSION_KHR);
+			ContextAttribs.push_back(this->Minor);
+
+			EGLint Flags = 0;
+			if(this->Profile != ES)
+			{
+				ContextAttribs.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR);
+				ContextAttribs.push_back(this->Profile == CORE ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR);
+				if(this->Profile == CORE)
+					Flags |= EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR;
+			}
+#			if defined(_DEBUG)
+				Flags |= EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+#			endif
+			ContextAttribs.push_back(EGL_CONTEXT_FLAGS_KHR);
+			ContextAttribs.push_back(Flags);
+		}
+		ContextAttribs.push_back(EGL_NONE);
+
+		eglBindAPI(this->Profile == ES ? EGL_OPENGL_ES_API : EGL_OPENGL_API);
+		this->Context = eglCreateContext(Display, Config, EGL_NO_CONTEXT, &ContextAttribs[0]);
+		if(this->Context == EGL_NO_CONTEXT)
+		{
+			eglDestroySurface(Display, this->Surface);
+			this->Surface = EGL_NO_SURFACE;
+			return false;
+		}
+
+		if(ShareContexts)
+		{
+			shared_context const Context = {this->Profile, this->Major, this->Minor, WindowSize, nullptr, this->Surface, this->Context};
+			SharedContexts.push_back(Context);
+		}
+	}
+
+	this->ShouldClose = false;
+
+	// GLEW function pointers may be context dependent, reload them when switching context
+	bool const SwitchContext = eglGetCurrentContext() != this->Context;
+	eglBindAPI(this->Profile == ES ? EGL_OPENGL_ES_API : EGL_OPENGL_API);
+	eglMakeCurrent(Display, this->Surface, this->Surface, this->Context);
+
+	if(!Reused || SwitchContext)
+	{
+		glewExperimental = GL_TRUE;
+		glewInit();
+	}
+
+	// Mesa starts pbuffer contexts drawing to GL_BACK, glClearBuffer doesn't write to it
+	if(!Reused && this->Profile != ES)
+	{
+		glDrawBuffer(default_color_buffer());
+		glReadBuffer(default_color_buffer());
+	}
+
+	return true;
+}
 
+void framework::releaseContext()
+{
+	if(ShareContexts || this->Context == EGL_NO_CONTEXT)
+	{
+		this->Context = EGL_NO_CONTEXT;
+		this->Surface = EGL_NO_SURFACE;
+		return;
+	}
+
+	eglMakeCurrent(HeadlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroyContext(HeadlessDisplay, this->Context);
+	eglDestroySurface(HeadlessDisplay, this->Surface);
+	this->Context = EGL_NO_CONTEXT;
+	this->Surface = EGL_NO_SURFACE;
+
+	terminate_headless_display();
+}
+
+#else//OGL_SAMPLES_HEADLESS
+
+bool framework::createContext(char const* Name, glm::uvec2 const & WindowSize, bool & Reused)
+{
 	glfwInit();
 	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
 	glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
 	glfwWindowHint(GLFW_SRGB_CAPABLE, GL_FALSE);
 	glfwWindowHint(GLFW_DECORATED, GL_TRUE);
-	glfwWindowHint(GLFW_CLIENT_API, Profile == ES ? GLFW_OPENGL_ES_API : GLFW_OPENGL_API);
+	glfwWindowHint(GLFW_CLIENT_API, this->Profile == ES ? GLFW_OPENGL_ES_API : GLFW_OPENGL_API);
 
-	if(version(this->Major, this->Minor) >= version(3, 2) || (Profile == ES))
+	if(version(this->Major, this->Minor) >= version(3, 2) || (this->Profile == ES))
 	{
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, this->Major);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, this->Minor);
@@ -107,10 +415,10 @@ framework::framework
 			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 			glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #		else
-			if(Profile != ES)
+			if(this->Profile != ES)
 			{
-				glfwWindowHint(GLFW_OPENGL_PROFILE, Profile == CORE ? GLFW_OPENGL_CORE_PROFILE : GLFW_OPENGL_COMPAT_PROFILE);
-				glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, Profile == CORE ? GL_TRUE : GL_FALSE);
+				glfwWindowHint(GLFW_OPENGL_PROFILE, this->Profile == CORE ? GLFW_OPENGL_CORE_PROFILE : GLFW_OPENGL_COMPAT_PROFILE);
+				glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, this->Profile == CORE ? GL_TRUE : GL_FALSE);
 			}
 
 #			if defined(_DEBUG)
@@ -126,40 +434,59 @@ framework::framework
 #	else
 		int const DPI = 1;
 #	endif
-	
-	this->Window = glfwCreateWindow(WindowSize.x / DPI, WindowSize.y / DPI, argv[0], nullptr, nullptr);
 
-	if(this->Window)
+	shared_context const* Shared = ShareContexts ? find_shared_context(this->Profile, this->Major, this->Minor, WindowSize) : nullptr;
+	Reused = Shared != nullptr;
+
+	if(Reused)
+		this->Window = Shared->Window;
+	else
 	{
+		this->Window = glfwCreateWindow(WindowSize.x / DPI, WindowSize.y / DPI, Name, nullptr, nullptr);
+		if(this->Window && ShareContexts)
+		{
+			shared_context const Context = {this->Profile, this->Major, this->Minor, WindowSize, this->Window};
+			SharedContexts.push_back(Context);
+		}
+	}
+
+	if(!this->Window)
+		return false;
+
+	if(Reused)
+	{
+		glfwSetWindowTitle(this->Window, Name);
+		glfwSetWindowShouldClose(this->Window, GL_FALSE);
+	}
+	else
 		glfwSetWindowPos(this->Window, 64, 64);
-		glfwSetWindowUserPointer(this->Window, this);
-		glfwSetMouseButtonCallback(this->Window, framework::mouseButtonCallback);
-		glfwSetCursorPosCallback(this->Window, framework::cursorPositionCallback);
-		glfwSetKeyCallback(this->Window, framework::keyCallback);
-		glfwMakeContextCurrent(this->Window);
+	glfwSetWindowUserPointer(this->Window, this);
+	glfwSetMouseButtonCallback(this->Window, framework::mouseButtonCallback);
+	glfwSetCursorPosCallback(this->Window, framework::cursorPositionCallback);
+	glfwSetKeyCallback(this->Window, framework::keyCallback);
+
+	// GLEW function pointers may be context dependent, reload them when switching context
+	bool const SwitchContext = glfwGetCurrentContext() != this->Window;
+	glfwMakeContextCurrent(this->Window);
 
+	if(!Reused || SwitchContext)
+	{
 		glewExperimental = GL_TRUE;
 		glewInit();
-		glGetError();
-
-#		if defined(_DEBUG) && defined(GL_KHR_debug)
-			if(this->isExtensionSupported("GL_KHR_debug"))
-			{
-				glEnable(GL_DEBUG_OUTPUT);
-				glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-				glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
-				glDebugMessageCallback(&framework::debugOutput, this);
-			}
-#		endif
-
-		glGenQueries(1, &this->TimerQueryName);
 	}
+
+	return true;
 }
 
-framework::~framework()
+void framework::releaseContext()
 {
-	if(this->TimerQueryName)
-		glDeleteQueries(1, &this->TimerQueryName);
+	if(ShareContexts)
+	{
+		if(this->Window)
+			glfwSetWindowUserPointer(this->Window, nullptr);
+		this->Window = 0;
+		return;
+	}
 
 	if(this->Window)
 	{
@@ -170,10 +497,17 @@ framework::~framework()
 	glfwTerminate();
 }
 
+#endif//OGL_SAMPLES_HEADLESS
+
 int framework::operator()()
 {
-	if(this->Window == 0)
-		return EXIT_FAILURE;
+#	if defined(OGL_SAMPLES_HEADLESS)
+		if(this->Context == EGL_NO_CONTEXT)
+			return EXIT_FAILURE;
+#	else
+		if(this->Window == 0)
+			return EXIT_FAILURE;
+#	endif
 
 	int Result = EXIT_SUCCESS;
 	
@@ -191,24 +525,43 @@ int framework::operator()()
 		FrameNum = this->FrameCount;
 #	endif//AUTOMATED_TESTS
 
+	std::chrono::steady_clock::time_point FrameTime = std::chrono::steady_clock::now();
+	std::size_t FrameIndex = 0;
+
 	while(Result == EXIT_SUCCESS && !this->Error)
 	{
 		Result = this->render() ? EXIT_SUCCESS : EXIT_FAILURE;
 		Result = Result && this->checkError("render");
 
-		glfwPollEvents();
-		if(glfwWindowShouldClose(this->Window) || (Automated && FrameNum == 0))
+#		if defined(OGL_SAMPLES_HEADLESS)
+			bool const ShouldClose = this->ShouldClose;
+#		else
+			glfwPollEvents();
+			bool const ShouldClose = glfwWindowShouldClose(this->Window) != 0;
+#		endif
+
+		if(ShouldClose || (Automated && FrameNum == 0))
 		{
+			// Resolved after end() so that the readback overlaps with the sample teardown
 			if(this->Success == MATCH_TEMPLATE)
 			{
-				if(!checkTemplate(this->Window, this->Title.c_str()))
-					Result = EXIT_FAILURE;
-				this->checkError("checkTemplate");
+				this->readCapture(FrameIndex);
+				this->TemplateFrame = FrameIndex;
+				this->TemplatePending = true;
 			}
 			break;
 		}
 
+		if(this->CaptureInterval > 0 && FrameIndex % this->CaptureInterval == 0)
+			this->readCapture(FrameIndex);
+
 		this->swap();
+		this->resolveCaptures(false);
+		++FrameIndex;
+
+		std::chrono::steady_clock::time_point const FrameTimeCurrent = std::chrono::steady_clock::now();
+		this->TimeCPU.add(std::chrono::duration<double, std::micro>(FrameTimeCurrent - FrameTime).count());
+		FrameTime = FrameTimeCurrent;
 
 		if(Automated)
 			--FrameNum;
@@ -217,6 +570,15 @@ int framework::operator()()
 	if (Result == EXIT_SUCCESS)
 		Result = this->end() && (Result == EXIT_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
 
+	bool const TemplatePending = this->TemplatePending;
+	if(!this->resolveCaptures(true))
+		Result = EXIT_FAILURE;
+	// The readback of the template frame failed, the frame was never compared
+	if(this->TemplatePending)
+		Result = EXIT_FAILURE;
+	if(TemplatePending)
+		this->checkError("checkTemplate");
+
 	if(this->Success == GENERATE_ERROR)
 		return (Result != EXIT_SUCCESS || this->Error) ? EXIT_SUCCESS : EXIT_FAILURE;
 	else
@@ -225,35 +587,54 @@ int framework::operator()()
 
 void framework::swap()
 {
-	glfwSwapBuffers(this->Window);
+#	if defined(OGL_SAMPLES_HEADLESS)
+		eglSwapBuffers(HeadlessDisplay, this->Surface);
+#	else
+		glfwSwapBuffers(this->Window);
+#	endif
 }
 
 void framework::sync(sync_mode const & Sync)
 {
+	int Interval = 0;
 	switch(Sync)
 	{
 	case ASYNC:
-		glfwSwapInterval(0);
+		Interval = 0;
 		break;
 	case VSYNC:
-		glfwSwapInterval(1);
+		Interval = 1;
 		break;
 	case TEARING:
-		glfwSwapInterval(-1);
+		Interval = -1;
 		break;
 	default:
 		assert(0);
 	}
+
+#	if defined(OGL_SAMPLES_HEADLESS)
+		eglSwapInterval(HeadlessDisplay, Interval);
+#	else
+		glfwSwapInterval(Interval);
+#	endif
 }
 
 void framework::stop()
 {
-	glfwSetWindowShouldClose(this->Window, GL_TRUE);
+#	if defined(OGL_SAMPLES_HEADLESS)
+		this->ShouldClose = true;
+#	else
+		glfwSetWindowShouldClose(this->Window, GL_TRUE);
+#	endif
 }
 
 void framework::log(csv & CSV, char const* String)
 {
-	CSV.log(String, this->TimeSum / this->FrameCount, this->TimeMin, this->TimeMax);
+	this->resolveTimers(0);
+
+	CSV.log(String, "cpu", this->TimeCPU);
+	if(this->TimeGPU.count() > 0)
+		CSV.log(String, "gpu", this->TimeGPU);
 }
 
 void framework::setupView(bool Translate, bool RotateX, bool RotateY)
@@ -266,19 +647,18 @@ void framework::setupView(bool Translate, bool RotateX, bool RotateY)
 
 bool framework::isExtensionSupported(char const* String)
 {
-	GLint ExtensionCount(0);
-	glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
-	for(GLint i = 0; i < ExtensionCount; ++i)
-		if(std::string((char const*)glGetStringi(GL_EXTENSIONS, i)) == std::string(String))
-			return true;
-	//printf("Failed to find Extension: \"%s\"\n",String);
-	return false;
+	return this->Extensions.supported(String);
 }
 
 glm::uvec2 framework::getWindowSize() const
 {
 	glm::ivec2 WindowSize(0);
-	glfwGetFramebufferSize(this->Window, &WindowSize.x, &WindowSize.y);
+#	if defined(OGL_SAMPLES_HEADLESS)
+		eglQuerySurface(HeadlessDisplay, this->Surface, EGL_WIDTH, &WindowSize.x);
+		eglQuerySurface(HeadlessDisplay, this->Surface, EGL_HEIGHT, &WindowSize.y);
+#	else
+		glfwGetFramebufferSize(this->Window, &WindowSize.x, &WindowSize.y);
+#	endif
 	return glm::uvec2(WindowSize);
 }
 
@@ -315,355 +695,280 @@ namespace
 		assert(A.format() == gli::FORMAT_RGB8_UNORM_PACK8 && B.format() == gli::FORMAT_RGB8_UNORM_PACK8);
 
 		gli::texture Result(A.target(), A.format(), A.extent(), A.layers(), A.faces(), A.levels());
-		for(std::size_t TexelIndex = 0, TexelCount = A.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-		{
-			glm::u8vec3 const TexelA = *(A.data<glm::u8vec3>() + TexelIndex);
-			glm::u8vec3 const TexelB = *(B.data<glm::u8vec3>() + TexelIndex);
-			glm::u8vec3 const TexelResult = glm::mix(TexelA - TexelB, TexelB - TexelA, glm::greaterThan(TexelB, TexelA)) * glm::u8vec3(Scale);
-			*(Result.data<glm::u8vec3>() + TexelIndex) = TexelResult;
-		}
+		rgb8::absolute_difference(A.data<glm::u8>(), B.data<glm::u8>(), Result.data<glm::u8>(), A.size(), Scale);
 		return Result;
 	}
 
-	struct heuristic
+	// Downsample to the 8x smaller level the mipmaps heuristics compare to ignore rasterization differences
+	gli::texture2d reduce(std::uint8_t const* Data, gli::texture2d::extent_type const& Extent)
 	{
-		virtual bool test(gli::texture const& A, gli::texture const& B) const = 0;
-	};
+		gli::size_t const Levels = glm::min<gli::size_t>(gli::levels(Extent), 4);
+
+		gli::texture2d Mipmaps(gli::FORMAT_RGB8_UNORM_PACK8, Extent, Levels);
+		memcpy(Mipmaps.data(), Data, Mipmaps.size(0));
+		Mipmaps = gli::generate_mipmaps(Mipmaps, 0, Levels - 1, gli::FILTER_LINEAR);
+		return gli::texture2d(gli::view(Mipmaps, Levels - 1, Levels - 1));
+	}
 
-	struct heuristic_equal : public heuristic
+	struct comparison
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const override
-		{
-			return A == B;
-		}
+		std::size_t Evaluated;
+		std::size_t Passed;
+		std::size_t MismatchTiles;
+		std::size_t TileCount;
 	};
 
-	struct heuristic_absolute_difference_max_one_large_kernel
+	// Marks the tiles of B whose hash differs from the tile hashes of A, returns their number
+	std::size_t mismatch_tiles(std::uint64_t const* TileHashesA, std::uint8_t const* B, gli::texture2d::extent_type const& Extent, std::vector<std::uint8_t>& Mismatch)
 	{
-		bool kernel(gli::texture2d::extent_type const& TexelCoordA, glm::u8vec3 const& TexelA, gli::texture2d const& TextureB) const
-		{
-			int const KernelSize = 9;
-
-			gli::texture2d::extent_type const TexelCoordInvA(TexelCoordA.x, 480 - TexelCoordA.y);
-			glm::u8vec3 TexelB[KernelSize * KernelSize];
-
-			for(int KernelIndexY = 0; KernelIndexY < KernelSize; ++KernelIndexY)
-			for(int KernelIndexX = 0; KernelIndexX < KernelSize; ++KernelIndexX)
-			{
-				gli::texture2d::extent_type const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
-				gli::texture2d::extent_type const TexelCoordB = TexelCoordA + KernelCoordB;
-
-				gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), glm::ivec2(TextureB.extent()) - glm::ivec2(1));
-				TexelB[KernelIndexY * KernelSize + KernelIndexX] = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
-			}
-
-			for(int KernelIndex = 0; KernelIndex < KernelSize * KernelSize; ++KernelIndex)
-			{
-				glm::vec3 const TexelDiff = glm::abs(glm::vec3(TexelB[KernelIndex]) - glm::vec3(TexelA));
-				if(glm::all(glm::lessThanEqual(TexelDiff, glm::vec3(2))))
-					return true;
-				continue;
-			}
-
-			return false;
-		}
+		std::vector<std::uint64_t> TileHashesB(rgb8::tile_count(Extent.x) * rgb8::tile_count(Extent.y));
+		rgb8::tile_hashes(B, Extent.x, Extent.y, &TileHashesB[0]);
 
-		bool test(gli::texture const& A, gli::texture const& B) const
+		std::size_t Count = 0;
+		Mismatch.resize(TileHashesB.size());
+		for(std::size_t TileIndex = 0; TileIndex < TileHashesB.size(); ++TileIndex)
 		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-
-			for(std::size_t TexelIndexY = 0, TexelCountY = A.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = A.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
-			{
-				gli::texture2d::extent_type const TexelCoordA(TexelIndexX, TexelIndexY);
-				glm::u8vec3 const TexelA = TextureA.load<glm::u8vec3>(TexelCoordA, 0);
-				glm::u8vec3 const TexelB = TextureB.load<glm::u8vec3>(TexelCoordA, 0);
-				if (TexelA == TexelB)
-					continue;
-
-				bool const ValidTexel = this->kernel(TexelCoordA, TexelA, TextureB);
-				if(!ValidTexel)
-					return false;
-			}
-
-			return true;
+			Mismatch[TileIndex] = TileHashesA[TileIndex] != TileHashesB[TileIndex] ? 255 : 0;
+			Count += Mismatch[TileIndex] ? 1 : 0;
 		}
-	};
+		return Count;
+	}
 
-	struct heuristic_absolute_difference_max_one_kernel
+	// Full resolution criteria are decided together in a single pass over the mismatching tiles, the
+	// other tiles are equal and pass all of them. The reduced levels are built once, only when no
+	// enabled full resolution criterion passed.
+	comparison compare(std::uint8_t const* A, std::uint8_t const* B, gli::texture2d::extent_type const& Extent, std::uint64_t const* TileHashesA, std::vector<std::uint8_t>& Mismatch, std::size_t Heuristic)
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d Texture(absolute_difference(A, B, 1));
-			glm::u8vec3 AbsDiffMax(0);
-			for(std::size_t TexelIndexY = 0, TexelCountY = Texture.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = Texture.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
-			{
-				gli::texture2d::extent_type const TexelCoord(TexelIndexX, TexelIndexY);
-				glm::u8vec3 TexelDiff = Texture.load<glm::u8vec3>(TexelCoord, 0);
-
-				if(glm::all(glm::lessThanEqual(TexelDiff, glm::u8vec3(1))))
-					continue;
-
-				gli::texture2d TextureA(A);
-				gli::texture2d TextureB(B);
-				glm::u8vec3 const TexelA = TextureA.load<glm::u8vec3>(TexelCoord, 0);
-
-				bool KernelAbsDiffMax = false;
-				for(int KernelIndexY = -1; KernelIndexY <= 1; ++KernelIndexY)
-				for(int KernelIndexX = -1; KernelIndexX <= 1; ++KernelIndexX)
-				{
-					glm::ivec2 const KernelCoord(KernelIndexX, KernelIndexY);
-					gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(glm::ivec2(TexelCoord) + KernelCoord, glm::ivec2(0), glm::ivec2(Texture.extent()) - glm::ivec2(1));
-					glm::u8vec3 const TexelB = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
+		std::size_t const MismatchTiles = mismatch_tiles(TileHashesA, B, Extent, Mismatch);
 
-					if(glm::all(glm::lessThanEqual(glm::abs(glm::vec3(TexelB) - glm::vec3(TexelA)), glm::vec3(1))))
-						KernelAbsDiffMax = true;
-				}
-
-				if(KernelAbsDiffMax)
-					TexelDiff = glm::min(TexelDiff, glm::u8vec3(1));
-				AbsDiffMax = glm::max(TexelDiff, AbsDiffMax);
-			}
-
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
-		}
-	};
-
-	struct heuristic_absolute_difference_max_one
-	{
-		bool test(gli::texture const& A, gli::texture const& B) const
+		rgb8::kernel Kernels[2];
+		std::size_t KernelBits[2];
+		std::size_t KernelCount = 0;
+		if(Heuristic & framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_KERNEL_BIT)
 		{
-			gli::texture Texture = absolute_difference(A, B, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
+			rgb8::kernel const Kernel = {3, 1, false};
+			KernelBits[KernelCount] = framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_KERNEL_BIT;
+			Kernels[KernelCount++] = Kernel;
 		}
-	};
-
-	struct heuristic_mipmaps_absolute_difference_max_one
-	{
-		bool test(gli::texture const& A, gli::texture const& B) const
+		if(Heuristic & framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_LARGE_KERNEL_BIT)
 		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
-			gli::texture ViewB = gli::view(GeneratedB, 3, 3);
-			gli::texture Texture = absolute_difference(ViewA, ViewB, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
+			rgb8::kernel const Kernel = {9, 2, false};
+			KernelBits[KernelCount] = framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_LARGE_KERNEL_BIT;
+			Kernels[KernelCount++] = Kernel;
 		}
-	};
 
-	struct heuristic_mipmaps_absolute_difference_max_four
-	{
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
-			gli::texture ViewB = gli::view(GeneratedB, 3, 3);
-			gli::texture Texture = absolute_difference(ViewA, ViewB, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(4)));
-		}
-	};
+		glm::u8 const Max = rgb8::measure_tiles(A, B, Extent.x, Extent.y, &Mismatch[0], Kernels, KernelCount);
 
-	struct heuristic_mipmaps_absolute_difference_max_channel
-	{
-		bool kernel(gli::texture2d::extent_type const& TexelCoordA, glm::u8vec3 const& TexelA, gli::texture2d const& TextureB) const
+		comparison Result = {framework::HEURISTIC_EQUAL_BIT | framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT, 0, MismatchTiles, Mismatch.size()};
+		if(Max == 0)
+			Result.Passed |= framework::HEURISTIC_EQUAL_BIT;
+		if(Max <= 1)
+			Result.Passed |= framework::HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT;
+		for(std::size_t KernelIndex = 0; KernelIndex < KernelCount; ++KernelIndex)
 		{
-			int const KernelSize = 1;
-
-			glm::u8vec3 TexelB[KernelSize * KernelSize];
-
-			for(int KernelIndexY = 0; KernelIndexY < KernelSize; ++KernelIndexY)
-			for(int KernelIndexX = 0; KernelIndexX < KernelSize; ++KernelIndexX)
-			{
-				gli::texture2d::extent_type const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
-				gli::texture2d::extent_type const TexelCoordB = TexelCoordA + KernelCoordB;
+			Result.Evaluated |= KernelBits[KernelIndex];
+			if(Kernels[KernelIndex].Pass)
+				Result.Passed |= KernelBits[KernelIndex];
+		}
 
-				gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), glm::ivec2(TextureB.extent()) - glm::ivec2(1));
-				TexelB[KernelIndexY * KernelSize + KernelIndexX] = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
-			}
+		std::size_t const MipmapsBits = Heuristic & (
+			framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT |
+			framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_FOUR_BIT |
+			framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_CHANNEL_BIT);
+		if((Result.Passed & Heuristic) || !MipmapsBits)
+			return Result;
+
+		gli::texture2d const ReducedA = reduce(A, Extent);
+		gli::texture2d const ReducedB = reduce(B, Extent);
+		glm::u8 const ReducedMax = rgb8::max_absolute_difference(ReducedA.data<glm::u8>(), ReducedB.data<glm::u8>(), ReducedA.size());
+
+		Result.Evaluated |= MipmapsBits;
+		if(ReducedMax <= 1)
+			Result.Passed |= framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT;
+		if(ReducedMax <= 4)
+			Result.Passed |= framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_FOUR_BIT;
+		if(rgb8::channel_tolerance(ReducedA.data<glm::u8>(), ReducedB.data<glm::u8>(), ReducedA.size() / 3, 16, 5))
+			Result.Passed |= framework::HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_CHANNEL_BIT;
+		Result.Passed &= Result.Evaluated;
 
-			glm::vec3 TexelDiff[KernelSize * KernelSize];
-			for(int KernelIndex = 0; KernelIndex < KernelSize * KernelSize; ++KernelIndex)
-			{
-				TexelDiff[KernelIndex] = glm::abs(glm::vec3(TexelB[KernelIndex]) - glm::vec3(TexelA));
-
-				float MaxComponent = glm::max(glm::max(TexelDiff[KernelIndex].r, TexelDiff[KernelIndex].g), TexelDiff[KernelIndex].b);
-				float MinComponent = glm::min(glm::min(TexelDiff[KernelIndex].r, TexelDiff[KernelIndex].g), TexelDiff[KernelIndex].b);
-				if(MaxComponent < 17.f && MinComponent < 6.f)
-					return true;
-				continue;
-			}
+		return Result;
+	}
 
+	// The store is mapped by the first test comparing its template and shared by the following ones
+	bool find_template(char const* Title, template_store::view & View)
+	{
+#		if defined(OGL_SAMPLES_TEMPLATE_STORE)
+			static template_store const Store(OGL_SAMPLES_TEMPLATE_STORE);
+			return Store.find(Title, View);
+#		else
 			return false;
-		}
+#		endif
+	}
 
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture2d ViewA(gli::view(GeneratedA, 3, 3));
-			gli::texture2d ViewB(gli::view(GeneratedB, 3, 3));
-
-			for(std::size_t TexelIndexY = 0, TexelCountY = ViewA.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = ViewA.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
-			{
-				gli::texture2d::extent_type const TexelCoordA(TexelIndexX, TexelIndexY);
-				glm::u8vec3 const TexelA = ViewA.load<glm::u8vec3>(TexelCoordA, 0);
-				glm::u8vec3 const TexelB = ViewB.load<glm::u8vec3>(TexelCoordA, 0);
-				if (TexelA == TexelB)
-					continue;
-
-				bool const ValidTexel = this->kernel(TexelCoordA, TexelA, ViewB);
-				if(!ValidTexel)
-					return false;
-			}
+	void print(char const* Title, comparison const& Comparison)
+	{
+		static char const* const Names[] = {"equal", "max-one", "kernel", "large-kernel", "mipmaps-max-one", "mipmaps-max-four", "mipmaps-channel"};
 
-			return true;
+		std::string Breakdown;
+		for(std::size_t NameIndex = 0; NameIndex < sizeof(Names) / sizeof(Names[0]); ++NameIndex)
+		{
+			std::size_t const Bit = static_cast<std::size_t>(1) << NameIndex;
+			Breakdown += format(" %s:%s", Names[NameIndex], !(Comparison.Evaluated & Bit) ? "skipped" : (Comparison.Passed & Bit) ? "pass" : "fail");
 		}
-	};
-
-	template <typename heuristic>
-	bool compare(gli::texture const& A, gli::texture const& B, heuristic const& Euristic)
-	{
-		return Euristic.test(A, B);
+		fprintf(stdout, "%s: template criteria%s, %d of %d tiles differ\n", Title, Breakdown.c_str(),
+			static_cast<int>(Comparison.MismatchTiles), static_cast<int>(Comparison.TileCount));
 	}
 }//namespace
 
 bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
 {
-	GLint ColorType = GL_UNSIGNED_BYTE;
-	GLint ColorFormat = GL_RGBA;
-		
-	if (Profile == ES)
-	{
-		glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_TYPE, &ColorType);
-		glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_FORMAT, &ColorFormat);
-	}
+	// Synchronous, complete the captures in flight then read back the current frame
+	bool const Success = this->resolveCaptures(true);
 
-	GLint WindowSizeX(0);
-	GLint WindowSizeY(0);
-	glfwGetFramebufferSize(pWindow, &WindowSizeX, &WindowSizeY);
+	this->readCapture(0);
 
-	gli::texture2d TextureRead(ColorFormat == GL_RGBA ? gli::FORMAT_RGBA8_UNORM_PACK8 : gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(WindowSizeX, WindowSizeY), 1);
-	gli::texture2d TextureRGB(gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(WindowSizeX, WindowSizeY), 1);
+	capture::frame Frame;
+	return this->Capture.resolve(true, Frame) == capture::RESOLVE_READY && this->compareTemplate(Frame, Title) && Success;
+}
+
+void framework::readCapture(std::size_t Index)
+{
+	if(this->Capture.full())
+		this->resolveCaptures(false);
+	while(this->Capture.full())
+		this->resolveCaptures(true);
 
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glReadPixels(0, 0, WindowSizeX, WindowSizeY, ColorFormat, ColorType, TextureRead.format() == gli::FORMAT_RGBA8_UNORM_PACK8 ? TextureRead.data() : TextureRGB.data());
+	this->Capture.read(this->getWindowSize(), Index);
+}
+
+bool framework::resolveCaptures(bool Wait)
+{
+	bool Success = true;
 
-	if(TextureRead.format() == gli::FORMAT_RGBA8_UNORM_PACK8)
+	capture::frame Frame;
+	for(;;)
 	{
-		for(gli::size_t y = 0; y < TextureRGB.extent().y; ++y)
-		for(gli::size_t x = 0; x < TextureRGB.extent().x; ++x)
+		capture::status const Status = this->Capture.resolve(Wait, Frame);
+		if(Status == capture::RESOLVE_PENDING)
+			break;
+
+		// Skipped so that the readbacks that follow are still resolved, a failed template frame remains pending
+		if(Status == capture::RESOLVE_FAILED)
 		{
-			gli::texture2d::extent_type TexelCoord(x, y);
+			fprintf(stdout, "%s: failed to read back frame %d\n", this->Title.c_str(), static_cast<int>(Frame.Index));
+			continue;
+		}
 
-			glm::u8vec3 Color(TextureRead.load<glm::u8vec4>(TexelCoord, 0));
-			TextureRGB.store(TexelCoord, 0, Color);
+		if(this->TemplatePending && Frame.Index == this->TemplateFrame)
+		{
+			this->TemplatePending = false;
+			Success = this->compareTemplate(Frame, this->Title.c_str()) && Success;
+			continue;
 		}
+
+		gli::texture2d Texture(gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(Frame.Size), 1);
+		memcpy(Texture.data(), Frame.Data, Texture.size());
+		save_png(Texture, (getBinaryDirectory() + "/" + this->Title + format("-%d.png", static_cast<int>(Frame.Index))).c_str());
+
+		// One capture per frame while polling
+		if(!Wait)
+			break;
 	}
 
+	return Success;
+}
+
+bool framework::compareTemplate(capture::frame const & Frame, char const* Title)
+{
 	bool Success = true;
 
 	if(Success)
 	{
-		gli::texture Template(load_png((getDataDirectory() + "templates/" + Title + ".png").c_str()));
+		// Templates are looked up in the template store, then loaded from their PNG file when the store doesn't have them
+		gli::texture Template;
+		std::uint8_t const* TemplateData = nullptr;
+		gli::texture2d::extent_type TemplateExtent(0);
+
+		template_store::view View;
+		bool const Packed = find_template(Title, View);
+		if(Packed)
+		{
+			TemplateData = View.Data;
+			TemplateExtent = gli::texture2d::extent_type(View.Width, View.Height);
+		}
+		else
+		{
+			Template = load_png((getDataDirectory() + "templates/" + Title + ".png").c_str());
+			if(!Template.empty() && Template.format() == gli::FORMAT_RGB8_UNORM_PACK8)
+			{
+				TemplateData = Template.data<glm::u8>();
+				TemplateExtent = gli::texture2d::extent_type(Template.extent());
+			}
+		}
 
 		if(Success)
-			Success = Success && !Template.empty();
+			Success = Success && TemplateData != nullptr;
 
 		bool SameSize = false;
 		if(Success)
 		{
-			SameSize = gli::texture2d(Template).extent() == TextureRGB.extent();
+			SameSize = TemplateExtent == gli::texture2d::extent_type(Frame.Size);
 			Success = Success && SameSize;
 		}
 
-		if(Success)
+		// Identical hashes, the frame is the template
+		bool SameHash = false;
+		if(Success && Packed)
+			SameHash = template_hash(Frame.Data, Frame.Size.x * Frame.Size.y * 3) == View.Hash;
+
+		// Tile mismatch map, tiles equal to the template skip the criteria
+		std::vector<std::uint8_t> Mismatch;
+		if(Success && !SameHash)
 		{
-			bool Pass = false;
-			if(!Pass && this->Heuristic & HEURISTIC_EQUAL_BIT)
-				Pass = compare(Template, TextureRGB, heuristic_equal());
-			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one());
-			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_KERNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one_kernel());
-			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_LARGE_KERNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one_large_kernel());
-			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_one());
-			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_FOUR_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_four());
-			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_CHANNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_channel());
-			Success = Pass;
+			std::vector<std::uint64_t> TileHashes;
+			if(!Packed)
+			{
+				TileHashes.resize(rgb8::tile_count(TemplateExtent.x) * rgb8::tile_count(TemplateExtent.y));
+				rgb8::tile_hashes(TemplateData, TemplateExtent.x, TemplateExtent.y, &TileHashes[0]);
+			}
+
+			comparison const Comparison = compare(TemplateData, Frame.Data, TemplateExtent, Packed ? View.TileHashes : &TileHashes[0], Mismatch, this->Heuristic);
+			Success = (Comparison.Passed & this->Heuristic) != 0;
+
+			// Report which criteria an approximate match or a mismatch passed
+			if(!(Comparison.Passed & HEURISTIC_EQUAL_BIT))
+				print(Title, Comparison);
 		}
 
 		// Save abs diff
 		if(!Success)
 		{
-			if(SameSize && !Template.empty())
+			gli::texture2d TextureRGB(gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(Frame.Size), 1);
+			memcpy(TextureRGB.data(), Frame.Data, TextureRGB.size());
+
+			// Copy of the packed template, only to save it
+			if(Packed)
+			{
+				Template = gli::texture2d(gli::FORMAT_RGB8_UNORM_PACK8, TemplateExtent, 1);
+				memcpy(Template.data(), TemplateData, Template.size());
+			}
+
+			if(SameSize)
 			{
+				std::size_t Counts[3];
+				rgb8::count_differences(Template.data<glm::u8>(), TextureRGB.data<glm::u8>(), TextureRGB.size() / 3, Counts);
+				fprintf(stdout, "%s: template mismatch, max difference %d, differing texels per channel %d %d %d\n", Title,
+					static_cast<int>(rgb8::max_absolute_difference(Template.data<glm::u8>(), TextureRGB.data<glm::u8>(), TextureRGB.size())),
+					static_cast<int>(Counts[0]), static_cast<int>(Counts[1]), static_cast<int>(Counts[2]));
+
 				gli::texture Diff = ::absolute_difference(Template, TextureRGB, 2);
 				save_png(gli::texture2d(Diff), (getBinaryDirectory() + "/" + Title + "-diff.png").c_str());
+
+				// One texel per tile, white when the tile differs
+				gli::texture2d Tiles(gli::FORMAT_R8_UNORM_PACK8, gli::texture2d::extent_type(rgb8::tile_count(TemplateExtent.x), rgb8::tile_count(TemplateExtent.y)), 1);
+				memcpy(Tiles.data(), &Mismatch[0], Tiles.size());
+				save_png(Tiles, (getBinaryDirectory() + "/" + Title + "-tiles.png").c_str());
 			}
 
 			if(!Template.empty())
@@ -678,23 +983,89 @@ bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
 
 void framework::beginTimer()
 {
-	glBeginQuery(GL_TIME_ELAPSED, this->TimerQueryName);
+	// Only block when the ring is full, waiting for the oldest timer the requested latency allows
+	this->resolveTimers(this->TimerLatency);
+
+	std::size_t const Slot = this->TimerQueryIssued % TIMER_QUERY_COUNT;
+	glQueryCounter(this->TimerQueryNames[Slot * 2 + 0], GL_TIMESTAMP);
 }
 
 void framework::endTimer()
 {
-	glEndQuery(GL_TIME_ELAPSED);
+	std::size_t const Slot = this->TimerQueryIssued % TIMER_QUERY_COUNT;
+	glQueryCounter(this->TimerQueryNames[Slot * 2 + 1], GL_TIMESTAMP);
+	++this->TimerQueryIssued;
 
-	GLuint QueryTime(0);
-	glGetQueryObjectuiv(this->TimerQueryName, GL_QUERY_RESULT, &QueryTime);
+	this->resolveTimers(TIMER_QUERY_COUNT);
+}
 
-	double const InstantTime(static_cast<double>(QueryTime) / 1000.0);
+void framework::setTimerLatency(std::size_t Latency)
+{
+	this->TimerLatency = glm::min<std::size_t>(Latency, TIMER_QUERY_COUNT - 1);
+}
 
-	this->TimeSum += InstantTime;
-	this->TimeMax = glm::max(this->TimeMax, InstantTime);
-	this->TimeMin = glm::min(this->TimeMin, InstantTime);
+std::size_t framework::getTimerLatency() const
+{
+	return this->TimerLatencyResolved;
+}
 
-	fprintf(stdout, "\rTime: %2.4f ms    ", InstantTime / 1000.0);
+void framework::setCaptureInterval(std::size_t Interval)
+{
+	this->CaptureInterval = Interval;
+}
+
+void framework::initCapture()
+{
+	// GL_ARB_sync and pixel buffer objects are core since OpenGL 3.2 and OpenGL ES 3.0
+	capture::mode Mode = capture::CAPTURE_CLIENT;
+	if(this->Profile == ES ? this->Major >= 3 : version(this->Major, this->Minor) >= version(3, 2))
+		Mode = capture::CAPTURE_MAP;
+	if(Mode == capture::CAPTURE_MAP && this->Profile != ES && (version(this->Major, this->Minor) >= version(4, 4) || this->isExtensionSupported("GL_ARB_buffer_storage")))
+		Mode = capture::CAPTURE_PERSISTENT;
+
+	// OpenGL ES only guarantees GL_RGBA with GL_UNSIGNED_BYTE, other implementation formats (eg GL_BGRA_EXT on Mesa) aren't handled
+	bool ReadRGBA = false;
+	if(this->Profile == ES)
+	{
+		GLint ColorType = GL_UNSIGNED_BYTE;
+		GLint ColorFormat = GL_RGBA;
+		glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_TYPE, &ColorType);
+		glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_FORMAT, &ColorFormat);
+		ReadRGBA = ColorFormat != GL_RGB || ColorType != GL_UNSIGNED_BYTE;
+	}
+
+	this->Capture.init(Mode, ReadRGBA);
+}
+
+void framework::resolveTimers(std::size_t MaxPending)
+{
+	while(this->TimerQueryResolved < this->TimerQueryIssued)
+	{
+		std::size_t const Pending = this->TimerQueryIssued - this->TimerQueryResolved;
+		std::size_t const Slot = this->TimerQueryResolved % TIMER_QUERY_COUNT;
+
+		// The end timestamp is the last query of a slot, if it is available the begin one is too.
+		if(Pending <= MaxPending)
+		{
+			GLuint Available(GL_FALSE);
+			glGetQueryObjectuiv(this->TimerQueryNames[Slot * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &Available);
+			if(Available == GL_FALSE)
+				break;
+		}
+
+		GLuint64 TimeBegin(0);
+		GLuint64 TimeEnd(0);
+		glGetQueryObjectui64v(this->TimerQueryNames[Slot * 2 + 0], GL_QUERY_RESULT, &TimeBegin);
+		glGetQueryObjectui64v(this->TimerQueryNames[Slot * 2 + 1], GL_QUERY_RESULT, &TimeEnd);
+
+		double const InstantTime(static_cast<double>(TimeEnd - TimeBegin) / 1000.0);
+
+		this->TimeGPU.add(InstantTime);
+		this->TimerLatencyResolved = Pending - 1;
+		++this->TimerQueryResolved;
+
+		fprintf(stdout, "\rTime: %2.4f ms (%d frames latency)    ", InstantTime / 1000.0, static_cast<int>(this->TimerLatencyResolved));
+	}
 }
 
 std::string framework::loadFile(std::string const & Filename) const
@@ -827,11 +1198,8 @@ bool framework::checkFramebuffer(GLuint FramebufferName) const
 
 bool framework::checkExtension(char const* ExtensionName) const
 {
-	GLint ExtensionCount = 0;
-	glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
-	for(GLint i = 0; i < ExtensionCount; ++i)
-		if(std::string((char const*)glGetStringi(GL_EXTENSIONS, i)) == std::string(ExtensionName))
-			return true;
+	if(this->Extensions.supported(ExtensionName))
+		return true;
 	printf("Failed to find Extension: \"%s\"\n", ExtensionName);
 	return false;
 }
@@ -849,6 +1217,189 @@ bool framework::checkGLVersion(GLint MajorVersionRequire, GLint MinorVersionRequ
 		>= version(MajorVersionRequire, MinorVersionRequire);
 }
 
+void framework::resetContextState(glm::uvec2 const & WindowSize) const
+{
+	bool const Desktop = this->Profile != ES;
+	int const Version = version(this->Major, this->Minor);
+	bool const VertexArray = Desktop || Version >= version(3, 0);
+
+	// Objects bindings
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glUseProgram(0);
+	if(VertexArray)
+		glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	if(VertexArray)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+	}
+	if(Desktop && Version >= version(4, 0))
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+		glPatchParameteri(GL_PATCH_VERTICES, 3);
+		glm::vec4 const OuterLevel(1.0f);
+		glm::vec2 const InnerLevel(1.0f);
+		glPatchParameterfv(GL_PATCH_DEFAULT_OUTER_LEVEL, &OuterLevel[0]);
+		glPatchParameterfv(GL_PATCH_DEFAULT_INNER_LEVEL, &InnerLevel[0]);
+	}
+	if(Desktop && Version >= version(4, 1))
+		glBindProgramPipeline(0);
+	if(Desktop && Version >= version(4, 2))
+		glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+	if(Desktop && Version >= version(4, 3))
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+	}
+
+	GLint TextureUnits(0);
+	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &TextureUnits);
+	for(GLint TextureUnit = 0; TextureUnit < TextureUnits; ++TextureUnit)
+	{
+		glActiveTexture(GL_TEXTURE0 + TextureUnit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		if(VertexArray)
+		{
+			glBindTexture(GL_TEXTURE_3D, 0);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		}
+		if(Desktop)
+		{
+			glBindTexture(GL_TEXTURE_1D, 0);
+			glBindTexture(GL_TEXTURE_1D_ARRAY, 0);
+			glBindTexture(GL_TEXTURE_RECTANGLE, 0);
+			glBindTexture(GL_TEXTURE_BUFFER, 0);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE_ARRAY, 0);
+		}
+		if(Desktop && Version >= version(4, 0))
+			glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, 0);
+		if((Desktop && Version >= version(3, 3)) || (!Desktop && Version >= version(3, 0)))
+			glBindSampler(TextureUnit, 0);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	// Fixed function states
+	glViewport(0, 0, static_cast<GLsizei>(WindowSize.x), static_cast<GLsizei>(WindowSize.y));
+	glScissor(0, 0, static_cast<GLsizei>(WindowSize.x), static_cast<GLsizei>(WindowSize.y));
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_STENCIL_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+	glDisable(GL_SAMPLE_COVERAGE);
+	if(VertexArray)
+		glDisable(GL_RASTERIZER_DISCARD);
+	if(Desktop)
+	{
+		glEnable(GL_MULTISAMPLE);
+		glDisable(GL_SAMPLE_MASK);
+		glDisable(GL_PROGRAM_POINT_SIZE);
+		glDisable(GL_FRAMEBUFFER_SRGB);
+		glDisable(GL_DEPTH_CLAMP);
+		glDisable(GL_PRIMITIVE_RESTART);
+		glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+		glDisable(GL_POLYGON_OFFSET_LINE);
+		glDisable(GL_POLYGON_OFFSET_POINT);
+		glDisable(GL_COLOR_LOGIC_OP);
+		glDisable(GL_LINE_SMOOTH);
+		glDisable(GL_POLYGON_SMOOTH);
+		GLint ClipDistances(0);
+		glGetIntegerv(GL_MAX_CLIP_DISTANCES, &ClipDistances);
+		for(GLint ClipDistance = 0; ClipDistance < ClipDistances; ++ClipDistance)
+			glDisable(GL_CLIP_DISTANCE0 + ClipDistance);
+		glLogicOp(GL_COPY);
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glPointSize(1.0f);
+		glPointParameteri(GL_POINT_SPRITE_COORD_ORIGIN, GL_UPPER_LEFT);
+		glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
+		glHint(GL_POLYGON_SMOOTH_HINT, GL_DONT_CARE);
+		glHint(GL_TEXTURE_COMPRESSION_HINT, GL_DONT_CARE);
+		glProvokingVertex(GL_LAST_VERTEX_CONVENTION);
+		glDrawBuffer(default_color_buffer());
+		glReadBuffer(default_color_buffer());
+		glClearDepth(1.0);
+	}
+	else
+	{
+		glClearDepthf(1.0f);
+		glHint(GL_GENERATE_MIPMAP_HINT, GL_DONT_CARE);
+	}
+	if(VertexArray)
+		glHint(GL_FRAGMENT_SHADER_DERIVATIVE_HINT, GL_DONT_CARE);
+	if(Desktop && Version >= version(4, 0))
+	{
+		glDisable(GL_SAMPLE_SHADING);
+		glMinSampleShading(0.0f);
+	}
+	if(Desktop && Version >= version(4, 3))
+		glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+	if(Desktop && Version >= version(4, 5))
+		glClipControl(GL_LOWER_LEFT, GL_NEGATIVE_ONE_TO_ONE);
+
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glStencilMask(~0u);
+	glStencilFunc(GL_ALWAYS, 0, ~0u);
+	glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+	glBlendFunc(GL_ONE, GL_ZERO);
+	glBlendEquation(GL_FUNC_ADD);
+	glBlendColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glFrontFace(GL_CCW);
+	glCullFace(GL_BACK);
+	glLineWidth(1.0f);
+	glPolygonOffset(0.0f, 0.0f);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClearStencil(0);
+
+	// Debug output is only enabled by default on debug contexts, debug builds enable it again after the reset
+	if(this->Extensions.supported("GL_KHR_debug"))
+	{
+		GLint ContextFlags(0);
+		glGetIntegerv(GL_CONTEXT_FLAGS, &ContextFlags);
+		if(ContextFlags & GL_CONTEXT_FLAG_DEBUG_BIT)
+			glEnable(GL_DEBUG_OUTPUT);
+		else
+			glDisable(GL_DEBUG_OUTPUT);
+		glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageCallback(nullptr, nullptr);
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_LOW, 0, nullptr, GL_FALSE);
+	}
+
+	// Pixel store states
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	if(VertexArray)
+	{
+		glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+		glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+		glPixelStorei(GL_UNPACK_SKIP_IMAGES, 0);
+	}
+
+	// Drop any error left by the previous test or by states this context doesn't support
+	glGetError();
+}
+
+#if !defined(OGL_SAMPLES_HEADLESS)
+
 void framework::cursorPositionCallback(GLFWwindow* Window, double x, double y)
 {
 	framework * Test = static_cast<framework*>(glfwGetWindowUserPointer(Window));
@@ -932,6 +1483,8 @@ void framework::keyCallback(GLFWwindow* Window, int Key, int Scancode, int Actio
 		Test->stop();
 }
 
+#endif//!OGL_SAMPLES_HEADLESS
+
 void APIENTRY framework::debugOutput
 (
 	GLenum source,
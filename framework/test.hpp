@@ -4,15 +4,23 @@
 #pragma warning(disable:4459)
 
 #include "csv.hpp"
+#include "stats.hpp"
+#include "capture.hpp"
 #include "compiler.hpp"
 #include "sementics.hpp"
 #include "vertex.hpp"
 #include "buffer.hpp"
 #include "caps.hpp"
+#include "extensions.hpp"
 #include "util.hpp"
 #include "mesh.hpp"
+#include "texture_stream.hpp"
 
 #include <GL/glew.h>
+#if defined(OGL_SAMPLES_HEADLESS)
+#	include <EGL/egl.h>
+#	include <EGL/eglext.h>
+#endif
 #include <GLFW/glfw3.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
@@ -113,6 +121,8 @@ inline bool operator!= (vertexattrib const & A, vertexattrib const & B)
 
 std::string getDataDirectory();
 std::string getBinaryDirectory();
+// Redirect the test outputs, eg to isolate the artifacts of concurrent processes
+void setBinaryDirectory(std::string const & Directory);
 
 class framework
 {
@@ -156,6 +166,11 @@ public:
 	void log(csv & CSV, char const* String);
 	void setupView(bool Translate, bool RotateX, bool RotateY);
 
+	// Keep windows and contexts alive between framework instances so that
+	// a batch of tests reuses one context per profile, version and window size.
+	static void shareContexts(bool Share);
+	static void destroySharedContexts();
+
 protected:
 	struct DrawArraysIndirectCommand
 	{
@@ -278,6 +293,14 @@ protected:
 protected:
 	void beginTimer();
 	void endTimer();
+	void setTimerLatency(std::size_t Latency);
+	std::size_t getTimerLatency() const;
+
+	// Extensions of the context, enumerated when it was created
+	extension_registry const & getExtensions() const {return this->Extensions;}
+
+	// Save every Interval-th frame as <Title>-<Frame>.png, read back asynchronously. 0 disables it
+	void setCaptureInterval(std::size_t Interval);
 
 	std::string loadFile(std::string const & Filename) const;
 	void logImplementationDependentLimit(GLenum Value, std::string const & String) const;
@@ -288,12 +311,17 @@ protected:
 
 private:
 	GLFWwindow* Window;
+#	if defined(OGL_SAMPLES_HEADLESS)
+		EGLSurface Surface;
+		EGLContext Context;
+		bool ShouldClose;
+#	endif
 	success const Success;
 	std::string const Title;
 	profile const Profile;
 	int const Major;
 	int const Minor;
-	GLuint TimerQueryName;
+	extension_registry Extensions;
 	std::size_t const FrameCount;
 	glm::vec2 MouseOrigin;
 	glm::vec2 MouseCurrent;
@@ -308,11 +336,39 @@ private:
 	int ViewSetupFlags;
 
 private:
-	double TimeSum, TimeMin, TimeMax;
+	enum
+	{
+		TIMER_QUERY_COUNT = 8
+	};
+
+	// Each timer slot is a pair of GL_TIMESTAMP queries, resolved frames later
+	std::array<GLuint, TIMER_QUERY_COUNT * 2> TimerQueryNames;
+	std::size_t TimerQueryIssued;
+	std::size_t TimerQueryResolved;
+	std::size_t TimerLatency;
+	std::size_t TimerLatencyResolved;
+	stats TimeCPU;
+	stats TimeGPU;
+
+	void resolveTimers(std::size_t MaxPending);
+
+private:
+	capture Capture;
+	std::size_t CaptureInterval;
+	std::size_t TemplateFrame;
+	bool TemplatePending;
+
+	void initCapture();
+	void readCapture(std::size_t Index);
+	bool resolveCaptures(bool Wait);
+	bool compareTemplate(capture::frame const & Frame, char const* Title);
 
 private:
 	int version(int Major, int Minor) const{return Major * 100 + Minor * 10;}
 	bool checkGLVersion(GLint MajorVersionRequire, GLint MinorVersionRequire) const;
+	bool createContext(char const* Name, glm::uvec2 const & WindowSize, bool & Reused);
+	void releaseContext();
+	void resetContextState(glm::uvec2 const & WindowSize) const;
 
 	static void cursorPositionCallback(GLFWwindow* Window, double x, double y);
 	static void mouseButtonCallback(GLFWwindow* Window, int Button, int Action, int mods);
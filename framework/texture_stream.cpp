@@ -0,0 +1,417 @@
+#include "texture_stream.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	std::size_t image_size(gli::format Format, gli::extent3d const & Extent)
+	{
+		gli::extent3d const BlockExtent = gli::block_extent(Format);
+		gli::extent3d const BlockCount = (Extent + BlockExtent - 1) / BlockExtent;
+		return static_cast<std::size_t>(BlockCount.x) * BlockCount.y * BlockCount.z * gli::block_size(Format);
+	}
+
+	gli::extent3d level_extent(gli::extent3d const & Extent, GLint Level)
+	{
+		return glm::max(Extent >> Level, gli::extent3d(1));
+	}
+}//namespace
+
+texture_stream::texture_stream() :
+	Format(gli::FORMAT_UNDEFINED),
+	Extent(0),
+	TextureName(0),
+	TargetGli(gli::TARGET_2D),
+	Target(GL_NONE),
+	Layers(0),
+	Levels(0),
+	BaseLevel(0),
+	Persistent(false),
+	Next(0),
+	Issued(0)
+{
+	for(std::size_t SlotIndex = 0; SlotIndex < this->Slots.size(); ++SlotIndex)
+	{
+		slot& Slot = this->Slots[SlotIndex];
+		Slot.Buffer = 0;
+		Slot.Fence = 0;
+		Slot.Persistent = nullptr;
+		Slot.Capacity = 0;
+	}
+}
+
+bool texture_stream::open(char const* Filename, GLuint TextureName, gli::gl::profile Profile, gli::target Target)
+{
+	this->release();
+
+	gli::gl GL(Profile);
+	if(!this->open_dds(Filename, GL) && !this->open_ktx(Filename, GL))
+	{
+		fprintf(stderr, "Failed to open texture %s\n", Filename);
+		this->release();
+		return false;
+	}
+
+	// Coarser levels first so that every uploaded level can be sampled right away
+	std::stable_sort(this->Images.begin(), this->Images.end(), [](image const & A, image const & B)
+	{
+		return A.Level > B.Level;
+	});
+
+	if(Target != static_cast<gli::target>(gli::TARGET_INVALID))
+	{
+		this->TargetGli = Target;
+		this->Target = static_cast<GLenum>(GL.translate(Target));
+	}
+
+	this->Persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+	this->BaseLevel = this->Levels;
+
+	this->TextureName = TextureName;
+	glBindTexture(this->Target, TextureName);
+	this->allocate();
+
+	// Sized for the largest image once, uploads never reallocate nor remap a slot
+	std::size_t Capacity = 0;
+	for(std::size_t ImageIndex = 0; ImageIndex < this->Images.size(); ++ImageIndex)
+		Capacity = std::max(Capacity, this->Images[ImageIndex].Size);
+	this->allocate_slots(Capacity);
+
+	return true;
+}
+
+bool texture_stream::open_dds(char const* Filename, gli::gl & GL)
+{
+	// Mapped by gli when the images are aligned, they are only paged in when uploaded
+	this->Texture = gli::load_dds(Filename);
+	if(this->Texture.empty())
+		return false;
+
+	this->Format = this->Texture.format();
+	this->FormatGL = GL.translate(this->Format, this->Texture.swizzles());
+	this->Extent = this->Texture.extent();
+	this->TargetGli = this->Texture.target();
+	this->Target = static_cast<GLenum>(GL.translate(this->TargetGli));
+	this->Layers = static_cast<GLsizei>(this->Texture.layers());
+	this->Levels = static_cast<GLsizei>(this->Texture.levels());
+
+	for(std::size_t Level = 0; Level < this->Texture.levels(); ++Level)
+	for(std::size_t Layer = 0; Layer < this->Texture.layers(); ++Layer)
+	for(std::size_t Face = 0; Face < this->Texture.faces(); ++Face)
+	{
+		image Image;
+		Image.Data = static_cast<char const*>(this->Texture.data(Layer, Face, Level));
+		Image.Size = this->Texture.size(Level);
+		Image.Level = static_cast<GLint>(Level);
+		Image.Layer = static_cast<GLint>(Layer);
+		Image.Face = static_cast<GLint>(Face);
+		Image.Extent = this->Texture.extent(Level);
+		this->Images.push_back(Image);
+	}
+
+	return true;
+}
+
+bool texture_stream::open_ktx(char const* Filename, gli::gl & GL)
+{
+	std::size_t const IdentifierSize = sizeof(gli::detail::FOURCC_KTX10);
+
+	this->Mapping = std::make_shared<gli::detail::file_mapping>(Filename);
+	if(this->Mapping->empty() || this->Mapping->size() < IdentifierSize + sizeof(gli::detail::ktx_header10))
+		return false;
+	if(memcmp(this->Mapping->data(), gli::detail::FOURCC_KTX10, IdentifierSize) != 0)
+		return false;
+
+	gli::detail::ktx_header10 const & Header(*reinterpret_cast<gli::detail::ktx_header10 const*>(this->Mapping->data() + IdentifierSize));
+
+	this->Format = GL.find(
+		static_cast<gli::gl::internal_format>(Header.GLInternalFormat),
+		static_cast<gli::gl::external_format>(Header.GLFormat),
+		static_cast<gli::gl::type_format>(Header.GLType));
+	if(this->Format == gli::FORMAT_UNDEFINED)
+		return false;
+
+	this->TargetGli = gli::detail::get_target(Header);
+	this->FormatGL = GL.translate(this->Format, gli::swizzles(gli::SWIZZLE_RED, gli::SWIZZLE_GREEN, gli::SWIZZLE_BLUE, gli::SWIZZLE_ALPHA));
+	this->Extent = gli::extent3d(Header.PixelWidth, std::max<std::uint32_t>(Header.PixelHeight, 1), std::max<std::uint32_t>(Header.PixelDepth, 1));
+	this->Target = static_cast<GLenum>(GL.translate(this->TargetGli));
+	this->Layers = static_cast<GLsizei>(std::max<std::uint32_t>(Header.NumberOfArrayElements, 1));
+	this->Levels = static_cast<GLsizei>(std::max<std::uint32_t>(Header.NumberOfMipmapLevels, 1));
+
+	GLint const Faces = static_cast<GLint>(std::max<std::uint32_t>(Header.NumberOfFaces, 1));
+	std::size_t const BlockSize = gli::block_size(this->Format);
+
+	// Each level is prefixed by its image size and faces are padded to 4 bytes
+	std::size_t Offset = IdentifierSize + sizeof(gli::detail::ktx_header10) + Header.BytesOfKeyValueData;
+	for(GLint Level = 0; Level < this->Levels; ++Level)
+	{
+		Offset += sizeof(std::uint32_t);
+
+		for(GLint Layer = 0; Layer < this->Layers; ++Layer)
+		for(GLint Face = 0; Face < Faces; ++Face)
+		{
+			image Image;
+			Image.Extent = level_extent(this->Extent, Level);
+			Image.Size = image_size(this->Format, Image.Extent);
+			Image.Data = this->Mapping->data() + Offset;
+			Image.Level = Level;
+			Image.Layer = Layer;
+			Image.Face = Face;
+
+			if(Offset + Image.Size > this->Mapping->size())
+				return false;
+
+			this->Images.push_back(Image);
+			Offset += std::max(BlockSize, glm::ceilMultiple(Image.Size, static_cast<std::size_t>(4)));
+		}
+	}
+
+	return true;
+}
+
+void texture_stream::allocate()
+{
+	gli::target const Target = this->TargetGli;
+	GLsizei const Layers = this->Layers;
+	GLsizei const Width = static_cast<GLsizei>(this->Extent.x);
+	GLsizei const Height = static_cast<GLsizei>(gli::is_target_1d(Target) ? Layers : this->Extent.y);
+	GLsizei const Depth = static_cast<GLsizei>(Target == gli::TARGET_3D ? this->Extent.z : (Target == gli::TARGET_CUBE_ARRAY ? Layers * 6 : Layers));
+	GLenum const Internal = static_cast<GLenum>(this->FormatGL.Internal);
+
+	if(GLEW_VERSION_4_2 || GLEW_ARB_texture_storage)
+	{
+		switch(Target)
+		{
+		case gli::TARGET_1D:
+			glTexStorage1D(this->Target, this->Levels, Internal, Width);
+			break;
+		case gli::TARGET_1D_ARRAY:
+		case gli::TARGET_2D:
+		case gli::TARGET_CUBE:
+			glTexStorage2D(this->Target, this->Levels, Internal, Width, Height);
+			break;
+		default:
+			glTexStorage3D(this->Target, this->Levels, Internal, Width, Height, Depth);
+			break;
+		}
+		return;
+	}
+
+	glTexParameteri(this->Target, GL_TEXTURE_MAX_LEVEL, this->Levels - 1);
+
+	bool const Compressed = gli::is_compressed(this->Format);
+	GLenum const External = static_cast<GLenum>(this->FormatGL.External);
+	GLenum const Type = static_cast<GLenum>(this->FormatGL.Type);
+
+	for(GLint Level = 0; Level < this->Levels; ++Level)
+	{
+		gli::extent3d const Extent = level_extent(this->Extent, Level);
+		GLsizei const LevelWidth = static_cast<GLsizei>(Extent.x);
+		GLsizei const LevelHeight = static_cast<GLsizei>(gli::is_target_1d(Target) ? Layers : Extent.y);
+		GLsizei const LevelDepth = static_cast<GLsizei>(Target == gli::TARGET_3D ? Extent.z : Depth);
+		GLsizei const ImageSize = static_cast<GLsizei>(image_size(this->Format, Extent));
+
+		switch(Target)
+		{
+		case gli::TARGET_1D:
+			if(Compressed)
+				glCompressedTexImage1D(this->Target, Level, Internal, LevelWidth, 0, ImageSize, nullptr);
+			else
+				glTexImage1D(this->Target, Level, static_cast<GLint>(Internal), LevelWidth, 0, External, Type, nullptr);
+			break;
+		case gli::TARGET_1D_ARRAY:
+		case gli::TARGET_2D:
+			if(Compressed)
+				glCompressedTexImage2D(this->Target, Level, Internal, LevelWidth, LevelHeight, 0, ImageSize * (Target == gli::TARGET_2D ? 1 : Layers), nullptr);
+			else
+				glTexImage2D(this->Target, Level, static_cast<GLint>(Internal), LevelWidth, LevelHeight, 0, External, Type, nullptr);
+			break;
+		case gli::TARGET_CUBE:
+			for(GLenum Face = 0; Face < 6; ++Face)
+			{
+				if(Compressed)
+					glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + Face, Level, Internal, LevelWidth, LevelHeight, 0, ImageSize, nullptr);
+				else
+					glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + Face, Level, static_cast<GLint>(Internal), LevelWidth, LevelHeight, 0, External, Type, nullptr);
+			}
+			break;
+		default:
+			if(Compressed)
+				glCompressedTexImage3D(this->Target, Level, Internal, LevelWidth, LevelHeight, LevelDepth, 0, ImageSize * (Target == gli::TARGET_3D ? 1 : LevelDepth), nullptr);
+			else
+				glTexImage3D(this->Target, Level, static_cast<GLint>(Internal), LevelWidth, LevelHeight, LevelDepth, 0, External, Type, nullptr);
+			break;
+		}
+	}
+}
+
+void texture_stream::allocate_slots(std::size_t Capacity)
+{
+	GLint UnpackBuffer = 0;
+	glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &UnpackBuffer);
+
+	for(std::size_t SlotIndex = 0; SlotIndex < this->Slots.size(); ++SlotIndex)
+	{
+		slot& Slot = this->Slots[SlotIndex];
+
+		glGenBuffers(1, &Slot.Buffer);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Slot.Buffer);
+		if(this->Persistent)
+		{
+			GLbitfield const Access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(Capacity), nullptr, Access);
+			Slot.Persistent = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(Capacity), Access);
+		}
+		else
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(Capacity), nullptr, GL_STREAM_DRAW);
+		Slot.Capacity = Capacity;
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, static_cast<GLuint>(UnpackBuffer));
+}
+
+void texture_stream::release()
+{
+	for(std::size_t SlotIndex = 0; SlotIndex < this->Slots.size(); ++SlotIndex)
+	{
+		slot& Slot = this->Slots[SlotIndex];
+		if(Slot.Fence)
+			glDeleteSync(Slot.Fence);
+		if(Slot.Buffer)
+		{
+			if(Slot.Persistent)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Slot.Buffer);
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			}
+			glDeleteBuffers(1, &Slot.Buffer);
+		}
+		Slot.Buffer = 0;
+		Slot.Fence = 0;
+		Slot.Persistent = nullptr;
+		Slot.Capacity = 0;
+	}
+
+	this->Images.clear();
+	this->Texture = gli::texture();
+	this->Mapping.reset();
+	this->TextureName = 0;
+	this->Layers = 0;
+	this->Levels = 0;
+	this->BaseLevel = 0;
+	this->Next = 0;
+	this->Issued = 0;
+}
+
+bool texture_stream::stream(std::size_t Budget)
+{
+	if(this->Next == this->Images.size())
+		return true;
+
+	GLint UnpackBuffer = 0;
+	glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &UnpackBuffer);
+	GLint UnpackAlignment = 4;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &UnpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	glBindTexture(this->Target, this->TextureName);
+
+	std::size_t Uploaded = 0;
+	while(this->Next < this->Images.size() && Uploaded < Budget)
+	{
+		image const & Image = this->Images[this->Next++];
+		this->upload(Image);
+		Uploaded += Image.Size;
+
+		if(this->Next == this->Images.size() || this->Images[this->Next].Level != Image.Level)
+			this->BaseLevel = Image.Level;
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, UnpackAlignment);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, static_cast<GLuint>(UnpackBuffer));
+
+	return this->Next == this->Images.size();
+}
+
+void texture_stream::upload(image const & Image)
+{
+	slot& Slot = this->Slots[this->Issued++ % STREAM_SLOT_COUNT];
+
+	// The ring is only reused once the upload issued STREAM_SLOT_COUNT images ago has consumed the buffer
+	if(Slot.Fence)
+	{
+		GLenum Status = glClientWaitSync(Slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		while(Status == GL_TIMEOUT_EXPIRED)
+			Status = glClientWaitSync(Slot.Fence, 0, 1000000);
+		glDeleteSync(Slot.Fence);
+		Slot.Fence = 0;
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Slot.Buffer);
+	assert(Image.Size <= Slot.Capacity);
+
+	if(Slot.Persistent)
+		memcpy(Slot.Persistent, Image.Data, Image.Size);
+	else
+	{
+		void* Pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(Image.Size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if(Pointer)
+			memcpy(Pointer, Image.Data, Image.Size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+
+	bool const Compressed = gli::is_compressed(this->Format);
+	GLenum const Internal = static_cast<GLenum>(this->FormatGL.Internal);
+	GLenum const External = static_cast<GLenum>(this->FormatGL.External);
+	GLenum const Type = static_cast<GLenum>(this->FormatGL.Type);
+	GLsizei const Size = static_cast<GLsizei>(Image.Size);
+	GLsizei const Width = static_cast<GLsizei>(Image.Extent.x);
+	GLsizei const Height = static_cast<GLsizei>(Image.Extent.y);
+	GLsizei const Depth = static_cast<GLsizei>(Image.Extent.z);
+
+	switch(this->Target)
+	{
+	case GL_TEXTURE_1D:
+		if(Compressed)
+			glCompressedTexSubImage1D(this->Target, Image.Level, 0, Width, Internal, Size, nullptr);
+		else
+			glTexSubImage1D(this->Target, Image.Level, 0, Width, External, Type, nullptr);
+		break;
+	case GL_TEXTURE_1D_ARRAY:
+		if(Compressed)
+			glCompressedTexSubImage2D(this->Target, Image.Level, 0, Image.Layer, Width, 1, Internal, Size, nullptr);
+		else
+			glTexSubImage2D(this->Target, Image.Level, 0, Image.Layer, Width, 1, External, Type, nullptr);
+		break;
+	case GL_TEXTURE_2D:
+	case GL_TEXTURE_CUBE_MAP:
+	{
+		GLenum const Face = this->Target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(Image.Face) : this->Target;
+		if(Compressed)
+			glCompressedTexSubImage2D(Face, Image.Level, 0, 0, Width, Height, Internal, Size, nullptr);
+		else
+			glTexSubImage2D(Face, Image.Level, 0, 0, Width, Height, External, Type, nullptr);
+		break;
+	}
+	case GL_TEXTURE_3D:
+		if(Compressed)
+			glCompressedTexSubImage3D(this->Target, Image.Level, 0, 0, 0, Width, Height, Depth, Internal, Size, nullptr);
+		else
+			glTexSubImage3D(this->Target, Image.Level, 0, 0, 0, Width, Height, Depth, External, Type, nullptr);
+		break;
+	default:
+	{
+		GLint const Layer = this->Target == GL_TEXTURE_CUBE_MAP_ARRAY ? Image.Layer * 6 + Image.Face : Image.Layer;
+		if(Compressed)
+			glCompressedTexSubImage3D(this->Target, Image.Level, 0, 0, Layer, Width, Height, 1, Internal, Size, nullptr);
+		else
+			glTexSubImage3D(this->Target, Image.Level, 0, 0, Layer, Width, Height, 1, External, Type, nullptr);
+		break;
+	}
+	}
+
+	Slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <gli/gli.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Level by level upload of a DDS or KTX file into a texture through a ring of pixel unpack buffers.
+// Only the header is parsed when opening, the storage of every level is allocated up front and
+// the images are read from the file mapping and uploaded smallest level first, so that the
+// texture can be sampled, clamped to base_level(), before the whole chain is resident.
+class texture_stream
+{
+public:
+	enum
+	{
+		STREAM_SLOT_COUNT = 3
+	};
+
+	texture_stream();
+
+	// Requires a current context. Allocates the storage of TextureName, bound to target() on the active texture unit.
+	// Target overrides the target of the file with a compatible one, eg TARGET_2D_ARRAY for a single layer 2D array
+	bool open(char const* Filename, GLuint TextureName, gli::gl::profile Profile, gli::target Target = static_cast<gli::target>(gli::TARGET_INVALID));
+	void release();
+
+	// Upload the next images until at least Budget bytes are issued, binding the texture to target() on the active texture unit.
+	// Returns true once every level is uploaded
+	bool stream(std::size_t Budget);
+
+	GLenum target() const{return this->Target;}
+	GLsizei levels() const{return this->Levels;}
+
+	// Finest level whose images, and the ones of every coarser level, are all uploaded
+	GLint base_level() const{return this->BaseLevel;}
+
+private:
+	struct image
+	{
+		char const* Data;
+		std::size_t Size;
+		GLint Level;
+		GLint Layer;
+		GLint Face;
+		gli::extent3d Extent;
+	};
+
+	struct slot
+	{
+		GLuint Buffer;
+		GLsync Fence;
+		void* Persistent;
+		std::size_t Capacity;
+	};
+
+	bool open_dds(char const* Filename, gli::gl & GL);
+	bool open_ktx(char const* Filename, gli::gl & GL);
+	void allocate();
+	void allocate_slots(std::size_t Capacity);
+	void upload(image const & Image);
+
+	gli::format Format;
+	gli::gl::format FormatGL;
+	gli::extent3d Extent;
+	GLuint TextureName;
+	gli::target TargetGli;
+	GLenum Target;
+	GLsizei Layers;
+	GLsizei Levels;
+	GLint BaseLevel;
+	bool Persistent;
+
+	// Either holds the images of a DDS file, referencing its mapping when aligned, or maps a KTX file
+	gli::texture Texture;
+	std::shared_ptr<gli::detail::file_mapping> Mapping;
+
+	// Sorted from the smallest level, Next is the first image not uploaded yet
+	std::vector<image> Images;
+	std::size_t Next;
+
+	std::array<slot, STREAM_SLOT_COUNT> Slots;
+	std::size_t Issued;
+};
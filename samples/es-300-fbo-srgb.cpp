@@ -75,7 +75,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		std::array<GLuint, shader::MAX> ShaderName;
 
@@ -87,7 +87,7 @@ private:
 			ProgramName[program::RENDER] = glCreateProgram();
 			glAttachShader(ProgramName[program::RENDER], ShaderName[shader::VERT_RENDER]);
 			glAttachShader(ProgramName[program::RENDER], ShaderName[shader::FRAG_RENDER]);
-			glLinkProgram(ProgramName[program::RENDER]);
+			Compiler.link_program(ProgramName[program::RENDER]);
 		}
 
 		if(Validated)
@@ -98,7 +98,7 @@ private:
 			ProgramName[program::SPLASH] = glCreateProgram();
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::VERT_SPLASH]);
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::FRAG_SPLASH]);
-			glLinkProgram(ProgramName[program::SPLASH]);
+			Compiler.link_program(ProgramName[program::SPLASH]);
 		}
 	
 		if(Validated)
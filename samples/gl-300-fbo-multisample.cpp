@@ -231,7 +231,7 @@ private:
 	{
 		bool Validated = true;
 
-		caps Caps(caps::COMPATIBILITY);
+		caps Caps(caps::COMPATIBILITY, this->getExtensions());
 
 		if(Validated)
 			Validated = initProgram();
@@ -219,7 +219,7 @@ private:
 
 	bool begin()
 	{
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		bool Validated = true;
 
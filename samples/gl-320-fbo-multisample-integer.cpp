@@ -240,7 +240,7 @@ private:
 
 	bool begin()
 	{
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		// Multisample integer texture is optional
 		bool Validated = Caps.Limits.MAX_INTEGER_SAMPLES > 1;
@@ -5,6 +5,7 @@ namespace
 	char const* VERT_SHADER_SOURCE("gl-320/texture-2d.vert");
 	char const* FRAG_SHADER_SOURCE("gl-320/texture-2d.frag");
 	char const* TEXTURE_DIFFUSE("kueken7_rgba8_srgb.dds");
+	std::size_t const STREAM_BUDGET(64 * 1024);
 
 	struct vertex
 	{
@@ -122,41 +123,20 @@ private:
 
 	bool initTexture()
 	{
-		gli::texture2d Texture(gli::load_dds((getDataDirectory() + TEXTURE_DIFFUSE).c_str()));
-		gli::gl GL(gli::gl::PROFILE_GL32);
-		gli::gl::format const Format = GL.translate(Texture.format(), Texture.swizzles());
-
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
 		glGenTextures(1, &TextureName);
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, TextureName);
+
+		texture_stream Stream;
+		if(!Stream.open((getDataDirectory() + TEXTURE_DIFFUSE).c_str(), TextureName, gli::gl::PROFILE_GL32))
+			return false;
+
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		glTexImage2D(GL_TEXTURE_2D, GLint(0),
-			Format.Internal,
-			GLsizei(Texture.extent().x), GLsizei(Texture.extent().y),
-			0,
-			Format.External, Format.Type,
-			nullptr);
-
-		GLsizei TextureSize = static_cast<GLsizei>(Texture[0].size());
-
-		GLuint PixelBuffer(0);
-		glGenBuffers(1, &PixelBuffer);
-		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PixelBuffer);
-		glBufferData(GL_PIXEL_UNPACK_BUFFER, TextureSize, nullptr, GL_STREAM_DRAW);
-		void* Pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, TextureSize, GL_MAP_WRITE_BIT);
-		memcpy(Pointer, Texture[0].data(), TextureSize);
-		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-
-		glTexSubImage2D(GL_TEXTURE_2D, 0,
-			0, 0, GLsizei(Texture.extent().x), GLsizei(Texture.extent().y),
-			Format.External, Format.Type, nullptr);
-		glDeleteBuffers(1, &PixelBuffer);
-
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		// Levels go through the pixel unpack buffer ring, smallest first
+		while(!Stream.stream(STREAM_BUDGET)){}
+
+		Stream.release();
 
 		return true;
 	}
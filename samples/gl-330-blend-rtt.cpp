@@ -80,7 +80,7 @@ private:
 
 		std::array<GLuint, shader::MAX> ShaderName;
 		
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		ShaderName[shader::VERT2] = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE2, "--version 330 --profile core");
 		ShaderName[shader::FRAG2] = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE2, "--version 330 --profile core");
 		Validated = Validated && Compiler.check();
@@ -90,7 +90,7 @@ private:
 			ProgramNameSingle = glCreateProgram();
 			glAttachShader(ProgramNameSingle, ShaderName[shader::VERT2]);
 			glAttachShader(ProgramNameSingle, ShaderName[shader::FRAG2]);
-			glLinkProgram(ProgramNameSingle);
+			Compiler.link_program(ProgramNameSingle);
 			Validated = Validated && Compiler.check_program(ProgramNameSingle);
 		}
 
@@ -10,7 +10,7 @@ public:
 private:
 	bool checkCaps()
 	{
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		return true;
 	}
@@ -61,7 +61,7 @@ private:
 	
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 330 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 330 --profile core");
 			Validated = Validated && Compiler.check();
@@ -69,7 +69,7 @@ private:
 			ProgramName = glCreateProgram();
 			glAttachShader(ProgramName, VertShaderName);
 			glAttachShader(ProgramName, FragShaderName);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 			Validated = Validated && Compiler.check_program(ProgramName);
 		}
 
@@ -84,7 +84,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -95,7 +95,7 @@ private:
 			this->ProgramName[program::COLORBUFFERS] = glCreateProgram();
 			glAttachShader(this->ProgramName[program::COLORBUFFERS], VertShaderName);
 			glAttachShader(this->ProgramName[program::COLORBUFFERS], FragShaderName);
-			glLinkProgram(this->ProgramName[program::COLORBUFFERS]);
+			Compiler.link_program(this->ProgramName[program::COLORBUFFERS]);
 		}
 
 		if(Validated)
@@ -112,7 +112,7 @@ private:
 			this->ProgramName[program::BLIT] = glCreateProgram();
 			glAttachShader(this->ProgramName[program::BLIT], VertShaderName);
 			glAttachShader(this->ProgramName[program::BLIT], FragShaderName);
-			glLinkProgram(this->ProgramName[program::BLIT]);
+			Compiler.link_program(this->ProgramName[program::BLIT]);
 		}
 
 		if(Validated)
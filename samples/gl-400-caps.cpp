@@ -11,7 +11,7 @@ private:
 
 	bool begin()
 	{
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		bool Validated = true;
 
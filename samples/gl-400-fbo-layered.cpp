@@ -65,7 +65,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -77,7 +77,7 @@ private:
 			glAttachShader(ProgramName[LAYERING], VertShaderName);
 			glAttachShader(ProgramName[LAYERING], GeomShaderName);
 			glAttachShader(ProgramName[LAYERING], FragShaderName);
-			glLinkProgram(ProgramName[LAYERING]);
+			Compiler.link_program(ProgramName[LAYERING]);
 		}
 
 		if(Validated)
@@ -88,7 +88,7 @@ private:
 			ProgramName[IMAGE_2D] = glCreateProgram();
 			glAttachShader(ProgramName[IMAGE_2D], VertShaderName);
 			glAttachShader(ProgramName[IMAGE_2D], FragShaderName);
-			glLinkProgram(ProgramName[IMAGE_2D]);
+			Compiler.link_program(ProgramName[IMAGE_2D]);
 		}
 
 		if(Validated)
@@ -84,7 +84,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_RENDER, "--version 400 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_RENDER, "--version 400 --profile core");
 			Validated = Validated && Compiler.check();
@@ -92,7 +92,7 @@ private:
 			ProgramName[program::RENDER] = glCreateProgram();
 			glAttachShader(ProgramName[program::RENDER], VertShaderName);
 			glAttachShader(ProgramName[program::RENDER], FragShaderName);
-			glLinkProgram(ProgramName[program::RENDER]);
+			Compiler.link_program(ProgramName[program::RENDER]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::RENDER]);
 		}
 
@@ -104,7 +104,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_BLIT, "--version 400 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_BLIT, "--version 400 --profile core");
 			Validated = Validated && Compiler.check();
@@ -112,7 +112,7 @@ private:
 			ProgramName[program::BLIT] = glCreateProgram();
 			glAttachShader(ProgramName[program::BLIT], VertShaderName);
 			glAttachShader(ProgramName[program::BLIT], FragShaderName);
-			glLinkProgram(ProgramName[program::BLIT]);
+			Compiler.link_program(ProgramName[program::BLIT]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::BLIT]);
 		}
 
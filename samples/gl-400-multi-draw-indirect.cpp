@@ -102,7 +102,7 @@ private:
 	{
 		bool Validated(true);
 	
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 400 --profile core");
 		GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 400 --profile core");
 		Validated = Validated && Compiler.check();
@@ -110,7 +110,7 @@ private:
 		ProgramName = glCreateProgram();
 		glAttachShader(ProgramName, VertShaderName);
 		glAttachShader(ProgramName, FragShaderName);
-		glLinkProgram(ProgramName);
+		Compiler.link_program(ProgramName);
 		Validated = Validated && Compiler.check_program(ProgramName);
 
 		GLint ActiveUniform(0);
@@ -335,7 +335,7 @@ private:
 		if(Validated)
 			Validated = initTexture();
 
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		glm::vec2 WindowSize(this->getWindowSize());
 		this->Viewport[0] = glm::vec4(WindowSize.x / 3.0f * 0.0f, 0, WindowSize.x / 3, WindowSize.y);
@@ -49,51 +49,52 @@ class sample : public framework
 {
 public:
 	sample(int argc, char* argv[]) :
-		framework(argc, argv, "gl-400-primitive-smooth-shading", framework::CORE, 4, 0)
+		framework(argc, argv, "gl-400-primitive-smooth-shading", framework::CORE, 4, 0),
+		Compiler(compiler::DEFERRED)
 	{}
 
 private:
+	compiler Compiler;
+
 	bool initProgram()
 	{
-		compiler Compiler;
-
-		bool Validated = true;
-		if(Validated)
-		{
-			GLuint VertShader = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER1);
-			GLuint ContShader = Compiler.create(GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONT_SHADER1);
-			GLuint EvalShader = Compiler.create(GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVAL_SHADER1);
-			GLuint GeomShader = Compiler.create(GL_GEOMETRY_SHADER, getDataDirectory() + SAMPLE_GEOM_SHADER1);
-			GLuint FragShader = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + SAMPLE_FRAG_SHADER1);
-
-			ProgramName[0] = glCreateProgram();
-			glAttachShader(ProgramName[0], VertShader);
-			glAttachShader(ProgramName[0], GeomShader);
-			glAttachShader(ProgramName[0], ContShader);
-			glAttachShader(ProgramName[0], EvalShader);
-			glAttachShader(ProgramName[0], FragShader);
-			glLinkProgram(ProgramName[0]);
-		}
-
-		if(Validated)
+		// Preprocessed on worker threads and compiled by the driver while the buffers are created
+		std::vector<compiler::source> const Sources =
 		{
-			GLuint VertShader = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER2);
-			GLuint GeomShader = Compiler.create(GL_GEOMETRY_SHADER, getDataDirectory() + SAMPLE_GEOM_SHADER2);
-			GLuint FragShader = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + SAMPLE_FRAG_SHADER2);
-
-			ProgramName[1] = glCreateProgram();
-			glAttachShader(ProgramName[1], VertShader);
-			glAttachShader(ProgramName[1], GeomShader);
-			glAttachShader(ProgramName[1], FragShader);
-			glLinkProgram(ProgramName[1]);
-		}
+			{GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER1, std::string()},
+			{GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONT_SHADER1, std::string()},
+			{GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVAL_SHADER1, std::string()},
+			{GL_GEOMETRY_SHADER, getDataDirectory() + SAMPLE_GEOM_SHADER1, std::string()},
+			{GL_FRAGMENT_SHADER, getDataDirectory() + SAMPLE_FRAG_SHADER1, std::string()},
+			{GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER2, std::string()},
+			{GL_GEOMETRY_SHADER, getDataDirectory() + SAMPLE_GEOM_SHADER2, std::string()},
+			{GL_FRAGMENT_SHADER, getDataDirectory() + SAMPLE_FRAG_SHADER2, std::string()}
+		};
+		std::vector<GLuint> const ShaderName = this->Compiler.create(Sources);
+
+		ProgramName[0] = glCreateProgram();
+		glAttachShader(ProgramName[0], ShaderName[0]);
+		glAttachShader(ProgramName[0], ShaderName[3]);
+		glAttachShader(ProgramName[0], ShaderName[1]);
+		glAttachShader(ProgramName[0], ShaderName[2]);
+		glAttachShader(ProgramName[0], ShaderName[4]);
+		this->Compiler.link_program(ProgramName[0]);
+
+		ProgramName[1] = glCreateProgram();
+		glAttachShader(ProgramName[1], ShaderName[5]);
+		glAttachShader(ProgramName[1], ShaderName[6]);
+		glAttachShader(ProgramName[1], ShaderName[7]);
+		this->Compiler.link_program(ProgramName[1]);
+
+		return this->checkError("initProgram");
+	}
 
-		if(Validated)
-		{
-			Validated = Validated && Compiler.check();
-			Validated = Validated && Compiler.check_program(ProgramName[0]);
-			Validated = Validated && Compiler.check_program(ProgramName[1]);
-		}
+	bool checkProgram()
+	{
+		bool Validated = true;
+		Validated = Validated && this->Compiler.check();
+		Validated = Validated && this->Compiler.check_program(ProgramName[0]);
+		Validated = Validated && this->Compiler.check_program(ProgramName[1]);
 
 		if(Validated)
 		{
@@ -101,7 +102,7 @@ private:
 			UniformMVP[1] = glGetUniformLocation(ProgramName[1], "MVP");
 		}
 
-		return Validated && this->checkError("initProgram");
+		return Validated && this->checkError("checkProgram");
 	}
 
 	bool initVertexArray()
@@ -144,6 +145,8 @@ private:
 			Validated = initBuffer();
 		if(Validated)
 			Validated = initVertexArray();
+		if(Validated)
+			Validated = checkProgram();
 
 		return Validated && this->checkError("begin");
 	}
@@ -38,7 +38,7 @@ private:
 	
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertexShader = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERTEX_SHADER);
 			GLuint ControlShader = Compiler.create(GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONTROL_SHADER);
 			GLuint EvaluationShader = Compiler.create(GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVALUATION_SHADER);
@@ -51,7 +51,7 @@ private:
 			glAttachShader(ProgramName, EvaluationShader);
 			glAttachShader(ProgramName, GeometryShader);
 			glAttachShader(ProgramName, FragmentShader);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 
 			Validated = Validated && Compiler.check();
 			Validated = Validated && Compiler.check_program(ProgramName);
@@ -77,7 +77,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -87,7 +87,7 @@ private:
 			ProgramName = glCreateProgram();
 			glAttachShader(ProgramName, VertShaderName);
 			glAttachShader(ProgramName, FragShaderName);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 		}
 
 		if(Validated)
@@ -39,7 +39,7 @@ private:
 		// Create program
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertexShader = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERTEX_SHADER);
 			GLuint ControlShader = Compiler.create(GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONTROL_SHADER);
 			GLuint EvaluationShader = Compiler.create(GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVALUATION_SHADER);
@@ -52,7 +52,7 @@ private:
 			glAttachShader(ProgramName, EvaluationShader);
 			glAttachShader(ProgramName, GeometryShader);
 			glAttachShader(ProgramName, FragmentShader);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 
 			Validated = Validated && Compiler.check();
 			Validated = Validated && Compiler.check_program(ProgramName);
@@ -64,7 +64,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		if(Validated)
 		{
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE1);
@@ -75,7 +75,7 @@ private:
 			glAttachShader(ProgramName[LAYERING], VertShaderName);
 			glAttachShader(ProgramName[LAYERING], GeomShaderName);
 			glAttachShader(ProgramName[LAYERING], FragShaderName);
-			glLinkProgram(ProgramName[LAYERING]);
+			Compiler.link_program(ProgramName[LAYERING]);
 		}
 
 		if(Validated)
@@ -88,7 +88,7 @@ private:
 			glAttachShader(ProgramName[VIEWPORT], VertShaderName);
 			glAttachShader(ProgramName[VIEWPORT], GeomShaderName);
 			glAttachShader(ProgramName[VIEWPORT], FragShaderName);
-			glLinkProgram(ProgramName[VIEWPORT]);
+			Compiler.link_program(ProgramName[VIEWPORT]);
 		}
 
 		if(Validated)
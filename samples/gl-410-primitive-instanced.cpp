@@ -69,7 +69,7 @@ private:
 		// Create program
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 410 --profile core");
 			GLuint GeomShaderName = Compiler.create(GL_GEOMETRY_SHADER, getDataDirectory() + GEOM_SHADER_SOURCE, "--version 410 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 410 --profile core");
@@ -83,8 +83,8 @@ private:
 			glAttachShader(ProgramName[program::FRAG], FragShaderName);
 			glProgramParameteri(ProgramName[program::VERT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glProgramParameteri(ProgramName[program::FRAG], GL_PROGRAM_SEPARABLE, GL_TRUE);
-			glLinkProgram(ProgramName[program::VERT]);
-			glLinkProgram(ProgramName[program::FRAG]);
+			Compiler.link_program(ProgramName[program::VERT]);
+			Compiler.link_program(ProgramName[program::FRAG]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[program::VERT]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::FRAG]);
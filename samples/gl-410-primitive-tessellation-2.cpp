@@ -49,7 +49,7 @@ private:
 	
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER, "--version 410 --profile core");
 			GLuint ContShaderName = Compiler.create(GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONT_SHADER, "--version 410 --profile core");
 			GLuint EvalShaderName = Compiler.create(GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVAL_SHADER, "--version 410 --profile core");
@@ -66,10 +66,10 @@ private:
 			glAttachShader(ProgramName[program::VERT], ContShaderName);
 			glAttachShader(ProgramName[program::VERT], EvalShaderName);
 			glAttachShader(ProgramName[program::VERT], GeomShaderName);
-			glLinkProgram(ProgramName[program::VERT]);
+			Compiler.link_program(ProgramName[program::VERT]);
 
 			glAttachShader(ProgramName[program::FRAG], FragShaderName);
-			glLinkProgram(ProgramName[program::FRAG]);
+			Compiler.link_program(ProgramName[program::FRAG]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[program::VERT]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::FRAG]);
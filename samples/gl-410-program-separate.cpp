@@ -73,14 +73,14 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERTEX_SHADER_SOURCE);
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAGMENT_SHADER_SOURCE);
 
 			UnifiedProgramName = glCreateProgram();
 			glAttachShader(UnifiedProgramName, VertShaderName);
 			glAttachShader(UnifiedProgramName, FragShaderName);
-			glLinkProgram(UnifiedProgramName);
+			Compiler.link_program(UnifiedProgramName);
 
 			Validated = Validated && Compiler.check();
 			Validated = Validated && Compiler.check_program(UnifiedProgramName);
@@ -99,7 +99,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -53,7 +53,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -64,7 +64,7 @@ private:
 			glProgramParameteri(ProgramName, GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName, VertShaderName);
 			glAttachShader(ProgramName, FragShaderName);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 		}
 
 		if(Validated)
@@ -82,7 +82,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_TEXTURE, 
 				"--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_TEXTURE,
@@ -93,7 +93,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::TEXTURE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::TEXTURE], VertShaderName);
 			glAttachShader(ProgramName[pipeline::TEXTURE], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::TEXTURE]);
+			Compiler.link_program(ProgramName[pipeline::TEXTURE]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::TEXTURE]);
 		}
@@ -103,7 +103,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_SPLASH, 
 				"--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_SPLASH,
@@ -114,7 +114,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SPLASH], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SPLASH], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SPLASH]);
+			Compiler.link_program(ProgramName[pipeline::SPLASH]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::SPLASH]);
 		}
@@ -271,7 +271,7 @@ private:
 	{
 		bool Validated(true);
 
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		if(Validated)
 			Validated = initProgram();
@@ -65,7 +65,7 @@ private:
 	{
 		bool Validated(true);
 	
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -76,7 +76,7 @@ private:
 			glProgramParameteri(ProgramName[program::UPDATE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::UPDATE], VertShaderName);
 			glAttachShader(ProgramName[program::UPDATE], FragShaderName);
-			glLinkProgram(ProgramName[program::UPDATE]);
+			Compiler.link_program(ProgramName[program::UPDATE]);
 		}
 
 		if(Validated)
@@ -88,7 +88,7 @@ private:
 			glProgramParameteri(ProgramName[program::BLIT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::BLIT], VertShaderName);
 			glAttachShader(ProgramName[program::BLIT], FragShaderName);
-			glLinkProgram(ProgramName[program::BLIT]);
+			Compiler.link_program(ProgramName[program::BLIT]);
 		}
 
 		if(Validated)
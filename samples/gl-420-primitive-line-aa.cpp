@@ -70,7 +70,7 @@ private:
 	{
 		bool Validated(true);
 	
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -81,7 +81,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::MULTISAMPLE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::MULTISAMPLE], VertShaderName);
 			glAttachShader(ProgramName[pipeline::MULTISAMPLE], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::MULTISAMPLE]);
+			Compiler.link_program(ProgramName[pipeline::MULTISAMPLE]);
 
 			Validated = Validated && Compiler.check();
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::MULTISAMPLE]);
@@ -96,7 +96,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SPLASH], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SPLASH], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SPLASH]);
+			Compiler.link_program(ProgramName[pipeline::SPLASH]);
 
 			Validated = Validated && Compiler.check();
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::SPLASH]);
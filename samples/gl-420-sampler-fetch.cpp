@@ -81,7 +81,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 420 --profile core");
 			GLuint FragShaderFuncName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_FUNC, "--version 420 --profile core");
 			GLuint FragShaderProgName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_PROG, "--version 420 --profile core");
@@ -93,13 +93,13 @@ private:
 			glAttachShader(ProgramName[program::PROG], VertShaderName);
 			glAttachShader(ProgramName[program::PROG], LibShaderName);
 			glAttachShader(ProgramName[program::PROG], FragShaderProgName);
-			glLinkProgram(ProgramName[program::PROG]);
+			Compiler.link_program(ProgramName[program::PROG]);
 
 			ProgramName[program::FUNC] = glCreateProgram();
 			glProgramParameteri(ProgramName[program::FUNC] , GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::FUNC], VertShaderName);
 			glAttachShader(ProgramName[program::FUNC], FragShaderFuncName);
-			glLinkProgram(ProgramName[program::FUNC]);
+			Compiler.link_program(ProgramName[program::FUNC]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[program::PROG]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::FUNC]);
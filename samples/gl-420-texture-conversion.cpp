@@ -107,7 +107,7 @@ private:
 	
 		glGenProgramPipelines(program::MAX, &PipelineName[0]);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 420 --profile core");
 		GLuint FragShaderNameNorm = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE[program::NORM], "--version 420 --profile core");
 		GLuint FragShaderNameUint = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE[program::UINT], "--version 420 --profile core");
@@ -119,7 +119,7 @@ private:
 			glProgramParameteri(ProgramName[program::NORM], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::NORM], VertShaderName);
 			glAttachShader(ProgramName[program::NORM], FragShaderNameNorm);
-			glLinkProgram(ProgramName[program::NORM]);
+			Compiler.link_program(ProgramName[program::NORM]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::NORM]);
 		}
 
@@ -129,7 +129,7 @@ private:
 			glProgramParameteri(ProgramName[program::UINT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::UINT], VertShaderName);
 			glAttachShader(ProgramName[program::UINT], FragShaderNameUint);
-			glLinkProgram(ProgramName[program::UINT]);
+			Compiler.link_program(ProgramName[program::UINT]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::UINT]);
 		}
 
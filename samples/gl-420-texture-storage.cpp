@@ -71,7 +71,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -79,13 +79,13 @@ private:
 			ProgramName[program::VERTEX] = glCreateProgram();
 			glProgramParameteri(ProgramName[program::VERTEX], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::VERTEX], VertShaderName);
-			glLinkProgram(ProgramName[program::VERTEX]);
+			Compiler.link_program(ProgramName[program::VERTEX]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::VERTEX]);
 
 			ProgramName[program::FRAGMENT] = glCreateProgram();
 			glProgramParameteri(ProgramName[program::FRAGMENT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::FRAGMENT], FragShaderName);
-			glLinkProgram(ProgramName[program::FRAGMENT]);
+			Compiler.link_program(ProgramName[program::FRAGMENT]);
 			Validated = Validated && Compiler.check_program(ProgramName[program::FRAGMENT]);
 		}
 
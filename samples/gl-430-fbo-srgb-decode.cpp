@@ -96,7 +96,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		std::array<GLuint, shader::MAX> ShaderName;
 
@@ -108,7 +108,7 @@ private:
 			ProgramName[program::TEXTURE] = glCreateProgram();
 			glAttachShader(ProgramName[program::TEXTURE], ShaderName[shader::VERT_TEXTURE]);
 			glAttachShader(ProgramName[program::TEXTURE], ShaderName[shader::FRAG_TEXTURE]);
-			glLinkProgram(ProgramName[program::TEXTURE]);
+			Compiler.link_program(ProgramName[program::TEXTURE]);
 		}
 		
 		if(Validated)
@@ -119,7 +119,7 @@ private:
 			ProgramName[program::SPLASH] = glCreateProgram();
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::VERT_SPLASH]);
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::FRAG_SPLASH]);
-			glLinkProgram(ProgramName[program::SPLASH]);
+			Compiler.link_program(ProgramName[program::SPLASH]);
 		}
 	
 		if(Validated)
@@ -55,7 +55,7 @@ private:
 	
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_RENDER, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_RENDER, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -64,14 +64,14 @@ private:
 			glProgramParameteri(ProgramName[pipeline::RENDER], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::RENDER], VertShaderName);
 			glAttachShader(ProgramName[pipeline::RENDER], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::RENDER]);
+			Compiler.link_program(ProgramName[pipeline::RENDER]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::RENDER]);
 		}
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_SPLASH, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_SPLASH, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -80,7 +80,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SPLASH], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SPLASH], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SPLASH]);
+			Compiler.link_program(ProgramName[pipeline::SPLASH]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::SPLASH]);
 		}
@@ -33,7 +33,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -42,7 +42,7 @@ private:
 			ProgramName = glCreateProgram();
 			glAttachShader(ProgramName, ComputeShaderName);
 			glProgramParameteri(ProgramName, GL_PROGRAM_SEPARABLE, GL_TRUE);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 		}
 
 		if(Validated)
@@ -39,7 +39,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -51,7 +51,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::READ], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::READ], VertShaderName);
 			glAttachShader(ProgramName[pipeline::READ], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::READ]);
+			Compiler.link_program(ProgramName[pipeline::READ]);
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::READ]);
 		}
 
@@ -65,7 +65,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SAVE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SAVE], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SAVE], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SAVE]);
+			Compiler.link_program(ProgramName[pipeline::SAVE]);
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::SAVE]);
 		}
 
@@ -155,7 +155,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VS_SOURCE, "--version 430 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FS_SOURCE, "--version 430 --profile core");
 			GLuint CompShaderName = Compiler.create(GL_COMPUTE_SHADER, getDataDirectory() + CS_SOURCE, "--version 430 --profile core");
@@ -167,7 +167,7 @@ private:
 				glProgramParameteri(ProgramName[program::GRAPHICS], GL_PROGRAM_SEPARABLE, GL_TRUE);
 				glAttachShader(ProgramName[program::GRAPHICS], VertShaderName);
 				glAttachShader(ProgramName[program::GRAPHICS], FragShaderName);
-				glLinkProgram(ProgramName[program::GRAPHICS]);
+				Compiler.link_program(ProgramName[program::GRAPHICS]);
 			}
 
 			if(Validated)
@@ -175,7 +175,7 @@ private:
 				ProgramName[program::COMPUTE] = glCreateProgram();
 				glProgramParameteri(ProgramName[program::COMPUTE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 				glAttachShader(ProgramName[program::COMPUTE], CompShaderName);
-				glLinkProgram(ProgramName[program::COMPUTE]);
+				Compiler.link_program(ProgramName[program::COMPUTE]);
 			}
 
 			Validated = Validated && Compiler.check_program(ProgramName[program::GRAPHICS]);
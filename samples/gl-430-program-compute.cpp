@@ -82,7 +82,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -94,12 +94,12 @@ private:
 			glProgramParameteri(ProgramName[program::GRAPHICS], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::GRAPHICS], VertShaderName);
 			glAttachShader(ProgramName[program::GRAPHICS], FragShaderName);
-			glLinkProgram(ProgramName[program::GRAPHICS]);
+			Compiler.link_program(ProgramName[program::GRAPHICS]);
 
 			ProgramName[program::COMPUTE] = glCreateProgram();
 			glProgramParameteri(ProgramName[program::COMPUTE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::COMPUTE], ComputeShaderName);
-			glLinkProgram(ProgramName[program::COMPUTE]);
+			Compiler.link_program(ProgramName[program::COMPUTE]);
 		}
 
 		if(Validated)
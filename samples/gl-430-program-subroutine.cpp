@@ -103,7 +103,7 @@ private:
 		// Create shaders
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE);
 			GLuint GeomShaderName = Compiler.create(GL_GEOMETRY_SHADER, getDataDirectory() + GEOM_SHADER_SOURCE);
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE);
@@ -116,7 +116,7 @@ private:
 				glAttachShader(ProgramName, VertShaderName);
 				glAttachShader(ProgramName, GeomShaderName);
 				glAttachShader(ProgramName, FragShaderName);
-				glLinkProgram(ProgramName);
+				Compiler.link_program(ProgramName);
 				Validated = Validated && Compiler.check_program(ProgramName);
 			}
 		}
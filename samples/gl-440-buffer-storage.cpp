@@ -5,6 +5,7 @@ namespace
 	char const* VERT_SHADER_SOURCE("gl-440/buffer-storage.vert");
 	char const* FRAG_SHADER_SOURCE("gl-440/buffer-storage.frag");
 	char const* TEXTURE_DIFFUSE("kueken7_rgba8_srgb.dds");
+	std::size_t const STREAM_BUDGET(64 * 1024);
 
 	GLsizei const VertexCount(4);
 	GLsizeiptr const VertexSize = VertexCount * sizeof(glf::vertex_v2fv2f);
@@ -63,7 +64,7 @@ private:
 	
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -72,7 +73,7 @@ private:
 			glProgramParameteri(ProgramName, GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName, VertShaderName);
 			glAttachShader(ProgramName, FragShaderName);
-			glLinkProgram(ProgramName);
+			Compiler.link_program(ProgramName);
 			Validated = Validated && Compiler.check_program(ProgramName);
 		}
 
@@ -124,38 +125,26 @@ private:
 
 	bool initTexture()
 	{
-		gli::texture2d Texture(gli::load_dds((getDataDirectory() + TEXTURE_DIFFUSE).c_str()));
-		gli::gl GL(gli::gl::PROFILE_GL33);
-		gli::gl::format const Format = GL.translate(Texture.format(), Texture.swizzles());
-
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
 		glGenTextures(1, &TextureName);
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D_ARRAY, TextureName);
+
+		texture_stream Stream;
+		if(!Stream.open((getDataDirectory() + TEXTURE_DIFFUSE).c_str(), TextureName, gli::gl::PROFILE_GL33, gli::TARGET_2D_ARRAY))
+			return false;
+
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_R, GL_RED);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, GL_GREEN);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, GL_BLUE);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_A, GL_ALPHA);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(Texture.levels() - 1));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, Stream.levels() - 1);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(Texture.levels()),
-			Format.Internal,
-			static_cast<GLsizei>(Texture[0].extent().x), static_cast<GLsizei>(Texture[0].extent().y), static_cast<GLsizei>(1));
+		// Storage allocated up front, levels go through persistently mapped pixel unpack buffers, smallest first
+		while(!Stream.stream(STREAM_BUDGET)){}
 
-		for(gli::texture2d::size_type Level = 0; Level < Texture.levels(); ++Level)
-		{
-			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(Level),
-				0, 0, 0,
-				static_cast<GLsizei>(Texture[Level].extent().x), static_cast<GLsizei>(Texture[Level].extent().y), static_cast<GLsizei>(1),
-				Format.External, Format.Type,
-				Texture[Level].data());
-		}
-	
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		Stream.release();
 
 		return true;
 	}
@@ -10,7 +10,7 @@ public:
 private:
 	bool checkCaps()
 	{
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		GLint NumCompressedTextureFormats = 0;
 		glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &NumCompressedTextureFormats);
@@ -61,7 +61,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		GLuint VertTransformShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_TRANSFORM, "--version 440 --profile core");
 		GLuint VertFeedbackShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_FEEDBACK, "--version 440 --profile core");
 		GLuint FragFeedbackShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_FEEDBACK, "--version 440 --profile core");
@@ -71,7 +71,7 @@ private:
 			ProgramName[program::TRANSFORM] = glCreateProgram();
 			glProgramParameteri(ProgramName[program::TRANSFORM], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::TRANSFORM], VertTransformShaderName);
-			glLinkProgram(ProgramName[program::TRANSFORM]);
+			Compiler.link_program(ProgramName[program::TRANSFORM]);
 		}
 
 		if(Validated)
@@ -80,7 +80,7 @@ private:
 			glProgramParameteri(ProgramName[program::FEEDBACK], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::FEEDBACK], VertFeedbackShaderName);
 			glAttachShader(ProgramName[program::FEEDBACK], FragFeedbackShaderName);
-			glLinkProgram(ProgramName[program::FEEDBACK]);
+			Compiler.link_program(ProgramName[program::FEEDBACK]);
 		}
 
 		if(Validated)
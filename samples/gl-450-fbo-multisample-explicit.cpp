@@ -108,7 +108,7 @@ private:
 
 		std::array<GLuint, shader::MAX> ShaderName;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 		ShaderName[shader::VERT] = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 440 --profile core");
 
 		for(int i = 0; i < program::MAX; ++i)
@@ -119,7 +119,7 @@ private:
 			glProgramParameteri(ProgramName[i], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[i], ShaderName[shader::VERT]);
 			glAttachShader(ProgramName[i], ShaderName[shader::FRAG_TEXTURE + i]);
-			glLinkProgram(ProgramName[i]);
+			Compiler.link_program(ProgramName[i]);
 		}
 		
 		if(Validated)
@@ -55,7 +55,7 @@ private:
 		// Create program
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint ShaderName[] = {
 				Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER, "--version 450 --profile core"),
 				Compiler.create(GL_TESS_EVALUATION_SHADER, getDataDirectory() + SAMPLE_EVAL_SHADER, "--version 450 --profile core"),
@@ -68,7 +68,7 @@ private:
 			for(std::size_t i = 0; i < program::MAX; ++i)
 				glAttachShader(this->ProgramName, ShaderName[i]);
 
-			glLinkProgram(this->ProgramName);
+			Compiler.link_program(this->ProgramName);
 
 			Validated = Validated && Compiler.check_program(this->ProgramName);
 		}
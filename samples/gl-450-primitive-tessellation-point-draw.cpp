@@ -52,7 +52,7 @@ private:
 		// Create program
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint ShaderName[] = {
 				Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + SAMPLE_VERT_SHADER, "--version 450 --profile core"),
 				Compiler.create(GL_TESS_CONTROL_SHADER, getDataDirectory() + SAMPLE_CONT_SHADER, "--version 450 --profile core"),
@@ -65,7 +65,7 @@ private:
 				ProgramName[i] = glCreateProgram();
 				glProgramParameteri(ProgramName[i], GL_PROGRAM_SEPARABLE, GL_TRUE);
 				glAttachShader(ProgramName[i], ShaderName[i]);
-				glLinkProgram(ProgramName[i]);
+				Compiler.link_program(ProgramName[i]);
 			}
 
 			for(std::size_t i = 0; i < program::MAX; ++i)
@@ -82,7 +82,7 @@ private:
 
 		if (Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_TEXTURE, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_TEXTURE, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -91,14 +91,14 @@ private:
 			glProgramParameteri(ProgramName[pipeline::TEXTURE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::TEXTURE], VertShaderName);
 			glAttachShader(ProgramName[pipeline::TEXTURE], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::TEXTURE]);
+			Compiler.link_program(ProgramName[pipeline::TEXTURE]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::TEXTURE]);
 		}
 
 		if (Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE_SPLASH, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE_SPLASH, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -107,7 +107,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SPLASH], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SPLASH], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SPLASH]);
+			Compiler.link_program(ProgramName[pipeline::SPLASH]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::SPLASH]);
 		}
@@ -254,7 +254,7 @@ private:
 				WindowSize * glm::linearRand(0.0f, 1.0f));
 		}
 */
-		caps Caps(caps::CORE);
+		caps Caps(caps::CORE, this->getExtensions());
 
 		if (Validated)
 			Validated = initProgram();
@@ -89,7 +89,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE1, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE1, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -98,7 +98,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::BLEND_OP], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::BLEND_OP], VertShaderName);
 			glAttachShader(ProgramName[pipeline::BLEND_OP], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::BLEND_OP]);
+			Compiler.link_program(ProgramName[pipeline::BLEND_OP]);
 			Validated = Compiler.check_program(ProgramName[pipeline::BLEND_OP]);
 		}
 
@@ -107,7 +107,7 @@ private:
 
 		if(Validated)
 		{
-			compiler Compiler;
+			compiler Compiler(compiler::DEFERRED);
 			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE2, "--version 420 --profile core");
 			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE2, "--version 420 --profile core");
 			Validated = Validated && Compiler.check();
@@ -116,7 +116,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::SPLASH], VertShaderName);
 			glAttachShader(ProgramName[pipeline::SPLASH], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::SPLASH]);
+			Compiler.link_program(ProgramName[pipeline::SPLASH]);
 			Validated = Compiler.check_program(ProgramName[pipeline::SPLASH]);
 		}
 
@@ -53,7 +53,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		glGenProgramPipelines(GLsizei(PIPELINE_MAX), PipelineName);
 
@@ -67,7 +67,7 @@ private:
 			glProgramParameteri(ProgramName[LAYERING], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[LAYERING], VertShaderName);
 			glAttachShader(ProgramName[LAYERING], FragShaderName);
-			glLinkProgram(ProgramName[LAYERING]);
+			Compiler.link_program(ProgramName[LAYERING]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[LAYERING]);
 		}
@@ -85,7 +85,7 @@ private:
 			glProgramParameteri(ProgramName[VIEWPORT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[VIEWPORT], VertShaderName);
 			glAttachShader(ProgramName[VIEWPORT], FragShaderName);
-			glLinkProgram(ProgramName[VIEWPORT]);
+			Compiler.link_program(ProgramName[VIEWPORT]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[VIEWPORT]);
 		}
@@ -69,7 +69,7 @@ private:
 	{
 		bool Validated = true;
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		if(Validated)
 		{
@@ -81,7 +81,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::LAYERING], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::LAYERING], VertShaderName);
 			glAttachShader(ProgramName[pipeline::LAYERING], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::LAYERING]);
+			Compiler.link_program(ProgramName[pipeline::LAYERING]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::LAYERING]);
 		}
@@ -96,7 +96,7 @@ private:
 			glProgramParameteri(ProgramName[pipeline::VIEWPORT], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[pipeline::VIEWPORT], VertShaderName);
 			glAttachShader(ProgramName[pipeline::VIEWPORT], FragShaderName);
-			glLinkProgram(ProgramName[pipeline::VIEWPORT]);
+			Compiler.link_program(ProgramName[pipeline::VIEWPORT]);
 
 			Validated = Validated && Compiler.check_program(ProgramName[pipeline::VIEWPORT]);
 		}
@@ -130,7 +130,7 @@ private:
 	{
 		bool Validated(true);
 
-		compiler Compiler;
+		compiler Compiler(compiler::DEFERRED);
 
 		std::array<GLuint, shader::MAX> ShaderName;
 
@@ -143,7 +143,7 @@ private:
 			glProgramParameteri(ProgramName[program::TEXTURE], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::TEXTURE], ShaderName[shader::VERT_TEXTURE]);
 			glAttachShader(ProgramName[program::TEXTURE], ShaderName[shader::FRAG_TEXTURE]);
-			glLinkProgram(ProgramName[program::TEXTURE]);
+			Compiler.link_program(ProgramName[program::TEXTURE]);
 		}
 		
 		if(Validated)
@@ -155,7 +155,7 @@ private:
 			glProgramParameteri(ProgramName[program::SPLASH], GL_PROGRAM_SEPARABLE, GL_TRUE);
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::VERT_SPLASH]);
 			glAttachShader(ProgramName[program::SPLASH], ShaderName[shader::FRAG_SPLASH]);
-			glLinkProgram(ProgramName[program::SPLASH]);
+			Compiler.link_program(ProgramName[program::SPLASH]);
 		}
 	
 		if(Validated)
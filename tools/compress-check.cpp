@@ -0,0 +1,90 @@
+#include <gli/gli.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+namespace
+{
+	// One 4x4 block per value, the last blocks are gradients
+	int const BlockValues[] = {77, 0, -50, 127, -127, -1, 1, -128};
+	std::size_t const UniformBlockCount = sizeof(BlockValues) / sizeof(BlockValues[0]);
+	std::size_t const BlockCount = UniformBlockCount + 2;
+
+	// -128 is clamped to -127 by the encoder, -1 in both cases
+	int expected_uniform(int Value)
+	{
+		return Value < -127 ? -127 : Value;
+	}
+
+	// Every texel of the block has its own value, the green gradient goes the other way of the red one
+	int source_value(std::size_t BlockIndex, std::size_t Texel, std::size_t Component)
+	{
+		if(BlockIndex < UniformBlockCount)
+			return Component == 0 ? BlockValues[BlockIndex] : -BlockValues[BlockIndex] / 2;
+
+		int const Gradient = static_cast<int>(Texel) * 16 - 120;
+		bool const Descending = (Component == 1) != (BlockIndex == UniformBlockCount + 1);
+		return Descending ? -Gradient : Gradient;
+	}
+
+	bool check_round_trip(gli::format UncompressedFormat, gli::format CompressedFormat, gli::compress_quality Quality)
+	{
+		std::size_t const ComponentCount = gli::component_count(UncompressedFormat);
+
+		gli::texture2d Texture(UncompressedFormat, gli::extent2d(BlockCount * 4, 4), 1);
+		std::int8_t* Data = Texture.data<std::int8_t>();
+		for(std::size_t BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex)
+		for(std::size_t Texel = 0; Texel < 16; ++Texel)
+		for(std::size_t Component = 0; Component < ComponentCount; ++Component)
+		{
+			std::size_t const Offset = ((Texel / 4) * BlockCount * 4 + BlockIndex * 4 + Texel % 4) * ComponentCount + Component;
+			Data[Offset] = static_cast<std::int8_t>(source_value(BlockIndex, Texel, Component));
+		}
+
+		gli::texture const Compressed(gli::compress(Texture, 0, CompressedFormat, Quality));
+		gli::texture const Decompressed(gli::decompress(Compressed, 0));
+		if(Compressed.empty() || Decompressed.empty() || Decompressed.format() != UncompressedFormat)
+		{
+			fprintf(stdout, "Format %d: compress or decompress failed\n", static_cast<int>(CompressedFormat));
+			return false;
+		}
+
+		// A gradient over 16 texels is approximated by the 8 values interpolated between the endpoints
+		int const GradientTolerance = 18;
+
+		bool Success = true;
+		std::int8_t const* Result = Decompressed.data<std::int8_t>();
+		for(std::size_t BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex)
+		for(std::size_t Texel = 0; Texel < 16; ++Texel)
+		for(std::size_t Component = 0; Component < ComponentCount; ++Component)
+		{
+			std::size_t const Offset = ((Texel / 4) * BlockCount * 4 + BlockIndex * 4 + Texel % 4) * ComponentCount + Component;
+			int const Source = source_value(BlockIndex, Texel, Component);
+			int const Value = Result[Offset];
+
+			bool const Uniform = BlockIndex < UniformBlockCount;
+			int const Error = Uniform ? Value - expected_uniform(Source) : Value - Source;
+			if(Error == 0 || (!Uniform && Error >= -GradientTolerance && Error <= GradientTolerance))
+				continue;
+
+			fprintf(stdout, "Format %d, quality %d: block %d texel %d component %d is %d instead of %d\n",
+				static_cast<int>(CompressedFormat), static_cast<int>(Quality), static_cast<int>(BlockIndex),
+				static_cast<int>(Texel), static_cast<int>(Component), Value, Uniform ? expected_uniform(Source) : Source);
+			Success = false;
+		}
+
+		return Success;
+	}
+}//namespace
+
+// Compress signed textures to ATI1N and ATI2N then decompress them: the encoder and the decoder must agree on the endpoints
+int main()
+{
+	bool Success = true;
+	Success = check_round_trip(gli::FORMAT_R8_SNORM_PACK8, gli::FORMAT_R_ATI1N_SNORM_BLOCK8, gli::COMPRESS_FAST) && Success;
+	Success = check_round_trip(gli::FORMAT_R8_SNORM_PACK8, gli::FORMAT_R_ATI1N_SNORM_BLOCK8, gli::COMPRESS_HIGH) && Success;
+	Success = check_round_trip(gli::FORMAT_RG8_SNORM_PACK8, gli::FORMAT_RG_ATI2N_SNORM_BLOCK16, gli::COMPRESS_FAST) && Success;
+	Success = check_round_trip(gli::FORMAT_RG8_SNORM_PACK8, gli::FORMAT_RG_ATI2N_SNORM_BLOCK16, gli::COMPRESS_HIGH) && Success;
+
+	return Success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
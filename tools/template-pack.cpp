@@ -0,0 +1,44 @@
+#include "png.hpp"
+#include "template_store.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Usage: template-pack <store> <template png>...
+// Each template is stored under the name of its file without the extension, the title of its sample.
+int main(int argc, char* argv[])
+{
+	if(argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <store> <template png>...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	template_store_writer Writer;
+	for(int ArgumentIndex = 2; ArgumentIndex < argc; ++ArgumentIndex)
+	{
+		std::string const Path(argv[ArgumentIndex]);
+		std::string::size_type const Begin = Path.find_last_of("/\\") + 1;
+		std::string::size_type const End = Path.rfind('.');
+		std::string const Title = Path.substr(Begin, End == std::string::npos || End < Begin ? std::string::npos : End - Begin);
+
+		gli::texture const Texture(load_png(Path.c_str()));
+		if(Texture.empty() || Texture.format() != gli::FORMAT_RGB8_UNORM_PACK8)
+		{
+			// Samples without a packed template fall back to loading their PNG file
+			fprintf(stderr, "%s: skipped, not an RGB8 PNG file\n", Path.c_str());
+			continue;
+		}
+
+		Writer.add(Title, Texture.extent().x, Texture.extent().y, Texture.data<std::uint8_t>());
+	}
+
+	if(!Writer.write(argv[1]))
+	{
+		fprintf(stderr, "%s: failed to write the template store\n", argv[1]);
+		remove(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}